@@ -0,0 +1,58 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Timing helpers for the benchmark executables. Numbers are wall time on whatever
+// machine runs them; compare runs on the same machine, built in Release.
+
+namespace Lithos::Bench {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Median wall time of `runs` calls to fn, in milliseconds; one extra call warms up first
+     */
+    template <typename F>
+    double MedianMs(F&& fn, const int runs = 5) {
+        fn();
+        std::vector<double> times;
+        times.reserve(runs);
+        for (int i = 0; i < runs; ++i) {
+            const Clock::time_point start = Clock::now();
+            fn();
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        std::ranges::sort(times);
+        return times[times.size() / 2];
+    }
+
+    /**
+     * @brief Keeps a result alive so the optimizer can't drop the work producing it
+     */
+    template <typename T>
+    void Keep(const T& value) {
+        static const void* volatile sink;
+        sink = &value;
+    }
+
+    inline void Header(const char* title) {
+        std::printf("\n== %s ==\n", title);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/ElementPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace Lithos;
+
+// Counts every allocation in the process, the library's included
+namespace {
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> allocatedBytes{0};
+}
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    struct Box : ElementBase<Box> {};
+
+    /// 100,000 elements: 1,000 rows of 100 children
+    void BuildTree(Element& root) {
+        for (int i = 0; i < 1000; ++i) {
+            auto& row = root.AddChild<Box>();
+            for (int j = 0; j < 99; ++j) row.AddChild<Box>();
+        }
+    }
+
+    double Elapsed(const Bench::Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Bench::Clock::now() - start).count();
+    }
+
+    /// Median build and teardown times over five trees (after one warm-up tree)
+    void Run(const char* name, ElementPool* pool) {
+        std::vector<double> builds, teardowns;
+        size_t count = 0, bytes = 0;
+        for (int run = 0; run < 6; ++run) {
+            const size_t a = allocations.load(), b = allocatedBytes.load();
+            Bench::Clock::time_point start = Bench::Clock::now();
+            auto root = Element::Make<Box>(pool);
+            BuildTree(*root);
+            const double build = Elapsed(start);
+            count = allocations.load() - a;
+            bytes = allocatedBytes.load() - b;
+
+            start = Bench::Clock::now();
+            root.reset();
+            const double teardown = Elapsed(start);
+            if (run == 0) continue;
+            builds.push_back(build);
+            teardowns.push_back(teardown);
+        }
+        std::ranges::sort(builds);
+        std::ranges::sort(teardowns);
+        std::printf("%-22s %10.2f %12.2f %10zu %12.1f\n", name, builds[builds.size() / 2],
+                    teardowns[teardowns.size() / 2], count, static_cast<double>(bytes) / 1e6);
+    }
+}
+
+// Building and destroying 100,000 elements through AddChild, with make_shared (no
+// pool) and with a window-style ElementPool
+int main() {
+    Bench::Header("100,000 elements: build and teardown");
+    std::printf("%-22s %10s %12s %10s %12s\n", "allocation", "build ms", "teardown ms", "mallocs", "malloc MB");
+
+    Run("make_shared", nullptr);
+
+    ElementPool* pool = ElementPool::Create();
+    Run("ElementPool", pool);
+    const ElementPoolStats& stats = pool->GetStats();
+    std::printf("pool: %zu chunks, %.1f MB reserved, element size %zu\n", stats.chunks,
+                static_cast<double>(stats.bytesReserved) / 1e6, sizeof(Box));
+
+    // Parent links are raw pointers: a walk is one load per level
+    auto root = Element::Make<Box>(pool);
+    Element* leaf = root.get();
+    for (int i = 0; i < 50; ++i) leaf = &leaf->AddChild<Box>();
+    size_t steps = 0;
+    const double walk = Bench::MedianMs([&] {
+        for (int k = 0; k < 100000; ++k) {
+            for (const Element* e = leaf; e; e = e->GetParent()) steps++;
+        }
+    });
+    std::printf("parent walk %.2f ns/step\n", walk * 1e6 / (100000.0 * 51.0));
+    Bench::Keep(steps);
+
+    root.reset();
+    pool->Release();
+    return 0;
+}
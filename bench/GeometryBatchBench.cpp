@@ -0,0 +1,106 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/GeometryBatch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Lithos;
+
+// 10,000 mixed rects, circles and rounded rects on a 1000x1000 plot: one point or
+// rect against all of them through GeometryBatch, versus a loop over Geometry
+int main() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    constexpr int Shapes = 10000;
+    GeometryBatch batch;
+    batch.Reserve(Shapes);
+    std::vector<Geometry> shapes;
+    shapes.reserve(Shapes);
+    for (int i = 0; i < Shapes; ++i) {
+        const float x = unit(rng) * 1000.0f, y = unit(rng) * 1000.0f;
+        const float w = 5.0f + unit(rng) * 40.0f, h = 5.0f + unit(rng) * 40.0f;
+        switch (i % 3) {
+            case 0: shapes.push_back(Geometry::MakeRect(x, y, w, h)); break;
+            case 1: shapes.push_back(Geometry::MakeCircle(x, y, w / 2.0f)); break;
+            default: {
+                const float rx = 1.0f + unit(rng) * (w / 2.0f - 1.0f);
+                const float ry = 1.0f + unit(rng) * (h / 2.0f - 1.0f);
+                shapes.push_back(Geometry::MakeRoundedRect(x, y, w, h, rx, ry));
+            }
+        }
+        batch.Add(shapes.back());
+    }
+
+    std::vector<std::pair<float, float>> points(2000);
+    for (auto& [x, y] : points) {
+        x = unit(rng) * 1000.0f;
+        y = unit(rng) * 1000.0f;
+    }
+
+    Bench::Header("Point against 10,000 shapes");
+    std::vector<uint8_t> mask, reference(Shapes);
+    size_t batchHits = 0, loopHits = 0, mismatches = 0;
+
+    const double batched = Bench::MedianMs([&] {
+        batchHits = 0;
+        for (const auto& [x, y] : points) {
+            batch.ContainsPoint(x, y, mask);
+            batchHits += static_cast<size_t>(std::ranges::count(mask, uint8_t{1}));
+        }
+    });
+    const double looped = Bench::MedianMs([&] {
+        loopHits = 0;
+        for (const auto& [x, y] : points) {
+            for (int i = 0; i < Shapes; ++i) reference[i] = shapes[i].ContainsPointFast(x, y) && shapes[i].ContainsPoint(x, y);
+            loopHits += static_cast<size_t>(std::ranges::count(reference, uint8_t{1}));
+        }
+    });
+    for (const auto& [x, y] : points) {
+        batch.ContainsPoint(x, y, mask);
+        for (int i = 0; i < Shapes; ++i) mismatches += mask[i] != (shapes[i].ContainsPoint(x, y) ? 1 : 0);
+    }
+
+    const auto perQuery = [&](const double ms) { return ms * 1000.0 / static_cast<double>(points.size()); };
+    std::printf("GeometryBatch::ContainsPoint %8.2f us/query (%zu hits)\n", perQuery(batched), batchHits);
+    std::printf("Geometry::ContainsPoint loop %8.2f us/query (%zu hits)\n", perQuery(looped), loopHits);
+    std::printf("speedup %.1fx, %zu mismatched answers\n", looped / batched, mismatches);
+
+    Bench::Header("Rubber-band selection, 60x60 rect");
+    std::vector<uint32_t> indices;
+    std::vector<Rect> bands(2000);
+    for (Rect& band : bands) band = Rect::FromXYWH(unit(rng) * 1000.0f, unit(rng) * 1000.0f, 60.0f, 60.0f);
+    const double enclosed = Bench::MedianMs([&] {
+        for (const Rect& band : bands) batch.ContainedIn(band, indices);
+    });
+    const double boundsLoop = Bench::MedianMs([&] {
+        for (const Rect& band : bands) {
+            indices.clear();
+            for (int i = 0; i < Shapes; ++i) {
+                if (band.Contains(shapes[i].GetBounds())) indices.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    });
+    std::printf("GeometryBatch::ContainedIn   %8.2f us/query\n", perQuery(enclosed));
+    std::printf("bounds loop                  %8.2f us/query\n", perQuery(boundsLoop));
+    return 0;
+}
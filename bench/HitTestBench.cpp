@@ -0,0 +1,112 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Element.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    struct Item : ElementBase<Item> {
+        /// Relative offset; block flow stacks the items, this pulls them back onto the canvas
+        Item& at(const float x, const float y) {
+            style.left = x;
+            style.top = y;
+            InvalidateLayout();
+            return *this;
+        }
+
+        float Top() const { return style.top; }
+        bool Shown() const { return isVisible; }
+    };
+}
+
+// Hit testing 100,000 overlapping elements on a 4000x4000 canvas: FindElementAt
+// against probing every element's HitTest in reverse paint order
+int main() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    auto root = std::make_shared<Item>();
+    auto& canvas = root->AddChild<Item>();
+    canvas.width(4000).height(4000);
+    std::vector<Item*> items;
+    items.reserve(100000);
+    float flow = 0.0f;
+    for (int i = 0; i < 100000; ++i) {
+        const float w = 10.0f + unit(rng) * 40.0f;
+        const float h = 10.0f + unit(rng) * 40.0f;
+        auto& item = canvas.AddChild<Item>();
+        item.width(w).height(h).at(unit(rng) * 3950.0f, unit(rng) * 3950.0f - flow);
+        if (i % 7 == 0) item.visible(false);
+        flow += h;
+        items.push_back(&item);
+    }
+    root->UpdateLayout();
+
+    std::vector<std::pair<float, float>> points(100000);
+    for (auto& [x, y] : points) {
+        x = unit(rng) * 4000.0f;
+        y = unit(rng) * 4000.0f;
+    }
+
+    const auto linear = [&](const float x, const float y) -> Element* {
+        for (size_t i = items.size(); i-- > 0;) {
+            if (items[i]->Shown() && items[i]->HitTest(x, y)) return items[i];
+        }
+        return canvas.HitTest(x, y) ? &canvas : nullptr;
+    };
+
+    Bench::Header("Hit testing, 100,000 elements");
+
+    size_t hits = 0;
+    const double indexed = Bench::MedianMs([&] {
+        hits = 0;
+        for (const auto& [x, y] : points) hits += root->FindElementAt(x, y) != &canvas;
+    });
+
+    // The linear probe is too slow to run for every point; sample it and cross-check
+    constexpr size_t Sampled = 1000;
+    size_t mismatches = 0;
+    const double probed = Bench::MedianMs([&] {
+        mismatches = 0;
+        for (size_t i = 0; i < Sampled; ++i) {
+            mismatches += linear(points[i].first, points[i].second) != root->FindElementAt(points[i].first, points[i].second);
+        }
+    }, 3);
+
+    std::printf("FindElementAt   %10.3f us/query (%zu of %zu points over an item)\n",
+                indexed * 1000.0 / static_cast<double>(points.size()), hits, points.size());
+    std::printf("linear HitTest  %10.3f us/query (%zu mismatches in %zu samples)\n",
+                probed * 1000.0 / static_cast<double>(Sampled), mismatches, Sampled);
+
+    // One element moves: re-layout, index refresh and a query
+    size_t moved = 0;
+    const double move = Bench::MedianMs([&] {
+        Item& item = *items[++moved * 7919 % items.size()];
+        item.at(unit(rng) * 3950.0f, item.Top());
+        root->UpdateLayout();
+        Bench::Keep(root->FindElementAt(points[moved].first, points[moved].second));
+    });
+    std::printf("move one + layout + query %8.3f ms\n", move);
+    return 0;
+}
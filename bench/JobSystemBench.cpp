@@ -0,0 +1,73 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Threading/JobSystem.hpp"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    /// Naive recursion on purpose: the leaves are the work
+    long SerialFibonacci(const int n) {
+        return n < 2 ? n : SerialFibonacci(n - 1) + SerialFibonacci(n - 2);
+    }
+
+    long Fibonacci(JobSystem& jobs, const int n) {
+        if (n < 20) return SerialFibonacci(n);
+        long x = 0, y = 0;
+        jobs.Join([&] { x = Fibonacci(jobs, n - 1); }, [&] { y = Fibonacci(jobs, n - 2); });
+        return x + y;
+    }
+}
+
+// Scaling from one thread up: a flat data-parallel loop and a deep fork/join tree
+int main() {
+    std::vector<float> data(size_t{1} << 22);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i) * 0.001f;
+    std::vector<double> partial(data.size() >> 14);
+
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    Bench::Header("JobSystem scaling");
+    std::printf("hardware threads %u, DefaultWorkerCount() %u\n", hardware, JobSystem::DefaultWorkerCount());
+    std::printf("%8s %16s %10s %14s %10s\n", "threads", "parallel-for ms", "speedup", "fib(32) ms", "speedup");
+
+    double loopBase = 0.0, forkBase = 0.0;
+    for (unsigned threads = 1; threads <= hardware * 2; threads *= 2) {
+        JobSystem jobs(threads - 1);
+        const double loop = Bench::MedianMs([&] {
+            jobs.ParallelForRanges(data.size(), size_t{1} << 14, [&](const size_t begin, const size_t end) {
+                double sum = 0.0;
+                for (size_t i = begin; i < end; ++i) sum += std::sqrt(data[i]) * std::sin(data[i]);
+                partial[begin >> 14] = sum;
+            });
+        });
+        long fib = 0;
+        const double fork = Bench::MedianMs([&] { fib = Fibonacci(jobs, 32); }, 3);
+        Bench::Keep(partial);
+        Bench::Keep(fib);
+
+        if (threads == 1) {
+            loopBase = loop;
+            forkBase = fork;
+        }
+        std::printf("%8u %16.2f %9.2fx %14.2f %9.2fx\n", threads, loop, loopBase / loop, fork, forkBase / fork);
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/MemoryReport.hpp"
+#include "Lithos/Core/Window.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Lithos;
+
+// Counts every allocation in the process, the library's included
+namespace {
+    std::atomic<size_t> allocations{0};
+}
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    /// Element with a hit-test shape, like a plot marker or a rounded button
+    struct Shape : ElementBase<Shape> {
+        explicit Shape(const int i) {
+            geometry = i % 2 ? Geometry::MakeRoundedRect(0.0f, 0.0f, 24.0f, 24.0f, 6.0f, 6.0f)
+                             : Geometry::MakeCircle(12.0f, 12.0f, 12.0f);
+        }
+    };
+}
+
+// Memory and allocations per element for 100,000 shaped elements in a window's pool
+int main() {
+    constexpr int Count = 100000;
+    Window window(1920, 1080, "memory");
+    Element& root = window.GetRoot();
+
+    const size_t before = allocations.load();
+    const auto start = Bench::Clock::now();
+    for (int i = 0; i < Count; ++i) {
+        root.AddChild<Shape>(i).width(24).height(24).margin(0, static_cast<float>(i % 64) * 28.0f);
+    }
+    const double build = std::chrono::duration<double, std::milli>(Bench::Clock::now() - start).count();
+    const size_t built = allocations.load() - before;
+    window.Tick(Bench::Clock::now());
+
+    Bench::Header("100,000 shaped elements");
+    std::printf("sizeof(Geometry) %zu, ElementBase<Shape> %zu bytes\n", sizeof(Geometry), sizeof(Shape));
+    std::printf("build %.2f ms, %.3f allocations per element\n", build, static_cast<double>(built) / Count);
+
+    const MemoryReport report = window.GetMemoryReport();
+    std::printf("%-14s %12s %12s\n", "category", "bytes", "per element");
+    for (size_t c = 0; c < static_cast<size_t>(MemoryCategory::Count); ++c) {
+        const auto category = static_cast<MemoryCategory>(c);
+        if (report.Get(category) == 0) continue;
+        std::printf("%-14s %12zu %12.1f\n", ToString(category), report.Get(category),
+                    static_cast<double>(report.Get(category)) / Count);
+    }
+    std::printf("%-14s %12zu %12.1f\n", "total", report.Total(), static_cast<double>(report.Total()) / Count);
+
+    // Shapes are tested inline by their kind; no allocation or virtual call per probe
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<std::pair<float, float>> points(100000);
+    for (auto& [x, y] : points) {
+        x = unit(rng) * 1920.0f;
+        y = unit(rng) * 1080.0f;
+    }
+    size_t hits = 0;
+    const double probe = Bench::MedianMs([&] {
+        hits = 0;
+        for (const auto& [x, y] : points) {
+            const Element* hit = root.FindElementAt(x, y);
+            hits += hit && hit != &root;
+        }
+    });
+    const size_t probing = allocations.load();
+    for (const auto& [x, y] : points) Bench::Keep(root.FindElementAt(x, y));
+    std::printf("FindElementAt %.3f us/query, %zu hits, %zu allocations\n",
+                probe * 1000.0 / static_cast<double>(points.size()), hits, allocations.load() - probing);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Reconciler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    struct Box : ElementBase<Box> {};
+
+    /// A row of three cells, keyed by id
+    NodeRef Row(const int id, const float shade) {
+        Style row{};
+        row.width = 400;
+        row.height = 20;
+        row.backgroundColor = Color(shade, 0.0f, 0.0f);
+        Style cell{};
+        cell.width = 100;
+        cell.height = 20;
+        return Describe<Box>(std::to_string(id), row, {Describe<Box>("a", cell), Describe<Box>("b", cell), Describe<Box>("c", cell)});
+    }
+
+    double Since(const Bench::Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Bench::Clock::now() - start).count();
+    }
+
+    void Report(const char* name, const double us, const ReconcileStats& s) {
+        std::printf("%-34s %10.1f %8zu %8zu %8zu %8zu %8zu\n", name, us, s.visited, s.skipped, s.created,
+                    s.layoutInvalidations, s.paintInvalidations);
+    }
+}
+
+// Changing one row of a 10,000-row description: the reconciler should write and
+// invalidate one row's worth, against tearing the rows down and re-adding them with AddChild
+int main() {
+    constexpr int Rows = 10000;
+    constexpr int Reps = 100;
+    std::mt19937 rng(5);
+
+    auto root = std::make_shared<Box>();
+    root->width(500).height(1e7f);
+    std::vector<NodeRef> rows;
+    rows.reserve(Rows);
+    for (int i = 0; i < Rows; ++i) rows.push_back(Row(i, 0.5f));
+
+    Reconciler reconciler;
+    Bench::Header("One row changed in 10,000 (3 cells each)");
+    std::printf("%-34s %10s %8s %8s %8s %8s %8s\n", "case", "us", "visited", "skipped", "created", "layout", "paint");
+
+    Bench::Clock::time_point start = Bench::Clock::now();
+    reconciler.Reconcile(*root, rows);
+    root->UpdateLayout();
+    Report("initial build + layout", Since(start), reconciler.GetStats());
+
+    // Unchanged rows are passed again as the same NodeRef
+    double reconcile = 0.0, layout = 0.0;
+    for (int rep = 1; rep <= Reps; ++rep) {
+        const int k = static_cast<int>(rng() % Rows);
+        rows[k] = Row(k, 0.5f + 0.001f * static_cast<float>(rep));
+        reconciler.ResetStats();
+        start = Bench::Clock::now();
+        reconciler.Reconcile(*root, rows);
+        reconcile += Since(start);
+        start = Bench::Clock::now();
+        root->UpdateLayout();
+        layout += Since(start);
+    }
+    Report("reconcile, shared nodes", reconcile / Reps, reconciler.GetStats());
+    std::printf("%-34s %10.1f\n", "layout after it", layout / Reps);
+
+    // Every node rebuilt: each row is compared, but still only one is written
+    double fresh = 0.0;
+    for (int rep = 1; rep <= 10; ++rep) {
+        const int k = static_cast<int>(rng() % Rows);
+        std::vector<NodeRef> rebuilt;
+        rebuilt.reserve(Rows);
+        for (int i = 0; i < Rows; ++i) rebuilt.push_back(Row(i, rows[i]->style.backgroundColor.r));
+        rebuilt[k] = Row(k, 0.9f + 0.001f * static_cast<float>(rep));
+        reconciler.ResetStats();
+        start = Bench::Clock::now();
+        reconciler.Reconcile(*root, rebuilt);
+        fresh += Since(start);
+        rows = std::move(rebuilt);
+    }
+    Report("reconcile, description rebuilt", fresh / 10, reconciler.GetStats());
+
+    // What updating one row cost before: throw the rows away and add them again
+    const double rebuild = Bench::MedianMs([&] {
+        root->ClearChildren();
+        for (int i = 0; i < Rows; ++i) {
+            auto& row = root->AddChild<Box>();
+            row.width(400).height(20).backgroundColor(Color(0.5f, 0.0f, 0.0f));
+            for (int c = 0; c < 3; ++c) row.AddChild<Box>().width(100).height(20);
+        }
+        root->UpdateLayout();
+    }, 3);
+    std::printf("%-34s %10.1f\n", "ClearChildren + AddChild + layout", rebuild * 1000.0);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Bench.hpp"
+#include "Lithos/Core/Components/ScrollView.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Render/SoftwareRenderer.hpp"
+
+#include <cstdio>
+#include <memory>
+
+using namespace Lithos;
+
+namespace {
+    struct Row : ElementBase<Row> {};
+}
+
+// One scroll step in a 400x500 view over 1k to 100k rows: record the frame, shift
+// last frame's pixels and rasterize only the exposed strip. None of it should grow
+// with the amount of content. Re-laying out the view is shown for contrast.
+int main() {
+    Bench::Header("Scrolling, per frame");
+    std::printf("%8s %12s %12s %12s %10s %14s\n", "rows", "record us", "shift+raster", "frame us", "commands", "relayout us");
+
+    for (const int rows : {1000, 10000, 100000}) {
+        auto root = std::make_shared<Row>();
+        root->width(800).height(600);
+        auto& view = root->AddChild<ScrollView>();
+        view.width(400).height(500).margin(20).borderWidth(2).borderColor(Colors::Black).backgroundColor(Colors::White);
+        for (int i = 0; i < rows; ++i) {
+            view.AddChild<Row>().width(380).height(24).margin(1)
+                .backgroundColor(Color(static_cast<float>(i % 7) / 7.0f, 0.5f, 0.5f));
+        }
+        root->UpdateLayout();
+
+        const Rect viewport(0.0f, 0.0f, 800.0f, 600.0f);
+        DisplayList list;
+        Framebuffer target(800, 600);
+        SoftwareRenderer renderer(1);
+        root->Record(list, viewport);
+        renderer.Render(list, target);
+
+        constexpr int Frames = 200;
+        int frame = 0;
+        const auto scroll = [&] {
+            ++frame;
+            const float before = view.GetScrollY();
+            view.ScrollTo(0.0f, static_cast<float>(frame % 500) * 13.0f);
+            return static_cast<int>(before - view.GetScrollY());
+        };
+
+        const double record = Bench::MedianMs([&] {
+            for (int i = 0; i < Frames; ++i) {
+                scroll();
+                list.Clear();
+                root->Record(list, viewport);
+            }
+        });
+
+        Rect exposed[2];
+        const double full = Bench::MedianMs([&] {
+            for (int i = 0; i < Frames; ++i) {
+                const int dy = scroll();
+                const int count = target.Scroll(view.GetClipRect(), 0, dy, exposed);
+                list.Clear();
+                root->Record(list, viewport);
+                renderer.Render(list, target, std::span<const Rect>(exposed, static_cast<size_t>(count)), Colors::White);
+            }
+        });
+
+        const double relayout = Bench::MedianMs([&] {
+            for (int i = 0; i < Frames; ++i) {
+                view.InvalidateLayout();
+                root->UpdateLayout();
+            }
+        });
+
+        const double perFrame = 1000.0 / Frames;
+        std::printf("%8d %12.2f %12.2f %12.2f %10zu %14.2f\n", rows, record * perFrame, (full - record) * perFrame,
+                    full * perFrame, list.Size(), relayout * perFrame);
+    }
+    return 0;
+}
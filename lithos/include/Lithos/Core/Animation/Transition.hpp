@@ -16,20 +16,28 @@
 
 #pragma once
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 #include <unordered_map>
 #include "AnimatableProperty.hpp"
 #include "Easing.hpp"
 
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
     class Element;
+    class Window;
+
     /**
      * @brief Transition configuration for a single property
      *
@@ -118,16 +126,22 @@ namespace Lithos {
      * Manages CSS-like transitions for property changes.
      * When a property with a configured transition changes, the manager
      * automatically creates a smooth animation to the new value.
+     *
+     * The element of the last OnPropertyChange() is the manager's target. While it
+     * has transitions running on an element attached to a window, the manager is
+     * registered with that window, which updates it in every frame's Animate phase
+     * and keeps frames coming until the transitions finish. A target that is destroyed
+     * or leaves the window drops its running transitions.
      */
     class LITHOS_API TransitionManager {
     public:
         TransitionManager() = default;
-        ~TransitionManager() = default;
+        ~TransitionManager();
 
         TransitionManager(const TransitionManager&) = delete;
         TransitionManager& operator=(const TransitionManager&) = delete;
-        TransitionManager(TransitionManager&&) = default;
-        TransitionManager& operator=(TransitionManager&&) = default;
+        TransitionManager(TransitionManager&& other) noexcept;
+        TransitionManager& operator=(TransitionManager&& other) noexcept;
 
         /**
          * @brief Adds a transition configuration for a property
@@ -163,7 +177,8 @@ namespace Lithos {
          * @brief Updates all active transitions
          *
          * Called each frame to interpolate property values and apply them to the element.
-         * This ensures the style always reflects the current animation state.
+         * This ensures the style always reflects the current animation state. The window
+         * does this for managers whose target is attached to it.
          *
          * @param element element to update
          * @param currentTime Current time point
@@ -184,9 +199,31 @@ namespace Lithos {
          */
         bool HasActiveTransition(AnimatableProperty property) const;
 
+        /**
+         * @brief Calls `callback` once, when the property's transition completes or is removed
+         *
+         * Runs right away if the property isn't transitioning. A transition retargeted
+         * before it completes keeps the callback waiting for the new target.
+         */
+        void WhenFinished(AnimatableProperty property, std::function<void()> callback);
+
     private:
         std::unordered_map<AnimatableProperty, TransitionConfig> configs;
         std::unordered_map<AnimatableProperty, ActiveTransition> activeTransitions;
+        std::vector<std::pair<AnimatableProperty, std::function<void()>>> finishCallbacks;
+        std::weak_ptr<Element> target;  ///< Element of the last OnPropertyChange()
+        Window* window = nullptr;       ///< Window updating this manager, while registered
+
+        /**
+         * @brief Frame step run by the window: updates the target
+         * @return false once nothing is left to update on this window; the window then drops the manager
+         */
+        bool UpdateTarget(std::chrono::steady_clock::time_point currentTime);
+
+        /**
+         * @brief Runs the WhenFinished() callbacks of properties no longer transitioning
+         */
+        void NotifyFinished();
 
         /**
          * @brief Gets the current value of a property
@@ -208,5 +245,7 @@ namespace Lithos {
          * @param skipTransition If true, bypasses transition system
          */
         void ApplyValue(Element* element, AnimatableProperty property, const PropertyValue& value, bool skipTransition = true);
+
+        friend class Window;
     };
 }
\ No newline at end of file
@@ -0,0 +1,373 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "AnimatableProperty.hpp"
+#include "Transition.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class CoroutineScheduler;
+    class FrameScheduler;
+    struct FrameInfo;
+
+    struct CoroutineFramePoolStats {
+        uint64_t allocations = 0;   ///< Frames handed out
+        uint64_t reuses = 0;        ///< Allocations served from a free list instead of the heap
+        uint64_t oversized = 0;     ///< Frames above MaxClassBytes, passed straight to the heap
+        size_t live = 0;            ///< Frames currently allocated
+        size_t bytesReserved = 0;   ///< Bytes of size-class blocks, in use or cached
+    };
+
+    /**
+     * @brief Per-thread free lists for coroutine frames
+     *
+     * Frame sizes are rounded up to a multiple of ClassBytes. A freed frame goes on the
+     * list of its size class and serves the next coroutine of that class, so scripts
+     * started over and over stop touching the heap once the lists are warm. Frames
+     * above MaxClassBytes bypass the lists. A frame must be freed on the thread that
+     * allocated it, which for UiTask is the UI thread.
+     */
+    class LITHOS_API CoroutineFramePool {
+    public:
+        static constexpr size_t ClassBytes = 64;
+        static constexpr size_t MaxClassBytes = 2048;
+
+        /**
+         * @brief Pool of the calling thread
+         */
+        static CoroutineFramePool& Local();
+
+        CoroutineFramePool() = default;
+        ~CoroutineFramePool();
+
+        CoroutineFramePool(const CoroutineFramePool&) = delete;
+        CoroutineFramePool& operator=(const CoroutineFramePool&) = delete;
+
+        void* Allocate(size_t bytes);
+        void Deallocate(void* frame, size_t bytes);
+
+        /**
+         * @brief Caches `count` blocks for frames of `bytes`, e.g. ahead of a burst of scripts
+         */
+        void Reserve(size_t bytes, size_t count);
+
+        /**
+         * @brief Returns every cached block to the heap
+         */
+        void Trim();
+
+        size_t GetMemoryBytes() const { return stats.bytesReserved; }
+
+        const CoroutineFramePoolStats& GetStats() const { return stats; }
+        void ResetStats();
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::array<FreeBlock*, MaxClassBytes / ClassBytes> freeLists{};
+        CoroutineFramePoolStats stats;
+    };
+
+    /**
+     * @brief Coroutine for UI logic that waits on the frame loop
+     *
+     * A UiTask starts suspended: hand it to CoroutineScheduler::Spawn() to run it, or
+     * co_await it from another UiTask to run it as a step of that one. Inside, co_await
+     * NextFrame, AfterLayout, Delay or TransitionFinished. Frames come from the
+     * CoroutineFramePool of the UI thread. Scripts must not throw.
+     */
+    class LITHOS_API UiTask {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type {
+            CoroutineScheduler* scheduler = nullptr;
+            uint64_t id = 0;                        ///< Spawned task this frame runs as part of
+            std::coroutine_handle<> continuation;   ///< Awaiting task; empty for a spawned one
+
+            UiTask get_return_object() { return UiTask(Handle::from_promise(*this)); }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+
+            static void* operator new(const size_t bytes) {
+                return CoroutineFramePool::Local().Allocate(bytes);
+            }
+            static void operator delete(void* frame, const size_t bytes) {
+                CoroutineFramePool::Local().Deallocate(frame, bytes);
+            }
+        };
+
+        UiTask() = default;
+        ~UiTask() { if (handle) handle.destroy(); }
+
+        UiTask(UiTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+        UiTask& operator=(UiTask&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        UiTask(const UiTask&) = delete;
+        UiTask& operator=(const UiTask&) = delete;
+
+        bool IsDone() const { return !handle || handle.done(); }
+
+        // Awaiting a task runs it to completion as a step of the caller
+        bool await_ready() const noexcept { return IsDone(); }
+        std::coroutine_handle<> await_suspend(Handle caller) noexcept {
+            promise_type& promise = handle.promise();
+            promise.scheduler = caller.promise().scheduler;
+            promise.id = caller.promise().id;
+            promise.continuation = caller;
+            return handle;
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        friend class CoroutineScheduler;
+
+        Handle handle;
+
+        explicit UiTask(const Handle handle) : handle(handle) {}
+    };
+
+    /**
+     * @brief Points in a frame where waiting tasks resume, in frame order
+     */
+    enum class ResumePoint : uint8_t {
+        FrameStart,     ///< Animate phase, before animations advance: due Delay waits, then NextFrame
+        AfterAnimate,   ///< Animate phase, after animations advanced: TransitionFinished
+        AfterLayout     ///< Layout phase, once layout is done: AfterLayout
+    };
+
+    struct CoroutineStats {
+        uint64_t spawned = 0;       ///< Spawn() calls that started a task
+        uint64_t completed = 0;     ///< Tasks that ran to the end
+        uint64_t cancelled = 0;     ///< Tasks destroyed by Cancel() or the scheduler's destructor
+        uint64_t resumes = 0;       ///< Waits that ended
+        size_t running = 0;         ///< Tasks started and not finished
+    };
+
+    /**
+     * @brief Runs UiTasks, resuming them at fixed points of the frame
+     *
+     * Waiting costs nothing: a suspended task is a parked handle on one list, and the
+     * scheduler books a frame (FrameWork::Resume) only when a wait needs one. Delays book
+     * a frame at their deadline with FrameScheduler::RequestFrameAt(), transition waits
+     * are woken by the TransitionManager itself. Like the FrameScheduler it never reads
+     * a clock inside a frame, so a headless driver calling Resume() with synthetic frame
+     * times gets the same order on every run:
+     *   - ResumePoints run in frame order, each waking the tasks queued before it started;
+     *     a task that waits on a point again waits for that point of the next frame
+     *   - within a point tasks resume in the order they started waiting, delays by
+     *     deadline first
+     *
+     * UI thread only. Changes made by tasks resumed after layout are laid out next frame.
+     */
+    class LITHOS_API CoroutineScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit CoroutineScheduler(FrameScheduler& frames);
+        ~CoroutineScheduler();
+
+        CoroutineScheduler(const CoroutineScheduler&) = delete;
+        CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+        /**
+         * @brief Starts a task; it runs up to its first wait before Spawn() returns
+         * @return Id for Cancel() and IsRunning(), 0 for an empty task
+         */
+        uint64_t Spawn(UiTask task);
+
+        /**
+         * @brief Destroys a waiting task without resuming it; not from inside the task itself
+         * @return false if the task already finished
+         */
+        bool Cancel(uint64_t id);
+        void CancelAll();
+
+        bool IsRunning(uint64_t id) const { return tasks.contains(id); }
+        size_t GetRunningCount() const { return tasks.size(); }
+
+        /**
+         * @brief Resumes the tasks waiting on `point` of the frame described by `info`
+         *
+         * The window calls this from its Animate and Layout phases; headless drivers call
+         * all three points in order from their own frames.
+         */
+        void Resume(ResumePoint point, const FrameInfo& info);
+
+        /**
+         * @brief Clock Delay measures from outside frames; steady_clock::now() by default
+         */
+        void SetClock(std::function<Clock::time_point()> newClock) { clock = std::move(newClock); }
+
+        /**
+         * @brief Time a Delay starts from: the frame time inside a frame, the clock otherwise
+         */
+        Clock::time_point Now() const { return inFrame ? frameTime : clock(); }
+
+        size_t GetMemoryBytes() const;
+
+        const CoroutineStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; stats.running = tasks.size(); }
+
+        // Used by the awaitables
+        void WaitFrame(UiTask::Handle handle);
+        void WaitLayout(UiTask::Handle handle);
+        void WaitUntil(UiTask::Handle handle, Clock::time_point due);
+        void WaitTransition(UiTask::Handle handle, TransitionManager& manager, AnimatableProperty property);
+        void Finish(uint64_t id);
+
+    private:
+        struct Waiter {
+            std::coroutine_handle<> handle;
+            uint64_t id;        ///< Spawned task; stale once it finished or was cancelled
+        };
+
+        struct Timer {
+            Clock::time_point due;
+            uint64_t sequence;  ///< Breaks ties between equal deadlines
+            Waiter waiter;
+        };
+
+        /// Woken transition waits; shared with TransitionManager callbacks, which may outlive the scheduler
+        struct Inbox {
+            std::vector<Waiter> ready;
+            FrameScheduler* frames = nullptr;
+            bool collecting = false;    ///< Between FrameStart and AfterAnimate: no frame needed
+        };
+
+        FrameScheduler& frames;
+        std::function<Clock::time_point()> clock = Clock::now;
+        std::unordered_map<uint64_t, UiTask> tasks;
+        uint64_t nextId = 1;
+        uint64_t nextSequence = 0;
+
+        std::vector<Waiter> frameWaiters;
+        std::vector<Waiter> layoutWaiters;
+        std::vector<Waiter> resuming;
+        std::vector<Timer> timers;          ///< Min-heap on (due, sequence)
+        std::shared_ptr<Inbox> inbox;
+
+        bool inFrame = false;               ///< Between FrameStart and AfterLayout
+        Clock::time_point frameTime;
+        CoroutineStats stats;
+
+        void ResumeWaiters(std::vector<Waiter>& waiters);
+
+        static bool TimerLater(const Timer& a, const Timer& b) {
+            return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+        }
+    };
+
+    /**
+     * @brief Resumes at the start of the next frame, before animations advance
+     */
+    struct NextFrame {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(const UiTask::Handle handle) const { handle.promise().scheduler->WaitFrame(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Resumes once the current frame (or the next, outside a frame) is laid out
+     */
+    struct AfterLayout {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(const UiTask::Handle handle) const { handle.promise().scheduler->WaitLayout(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Resumes at the first frame at least `duration` after CoroutineScheduler::Now()
+     */
+    struct Delay {
+        std::chrono::steady_clock::duration duration;
+
+        explicit Delay(const std::chrono::steady_clock::duration duration) : duration(duration) {}
+
+        bool await_ready() const noexcept { return duration <= std::chrono::steady_clock::duration::zero(); }
+        void await_suspend(const UiTask::Handle handle) const {
+            CoroutineScheduler& scheduler = *handle.promise().scheduler;
+            scheduler.WaitUntil(handle, scheduler.Now() + duration);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Resumes after animations of the frame the property's transition completed in
+     *
+     * Doesn't wait if the property isn't transitioning. The manager must outlive the wait.
+     */
+    struct TransitionFinished {
+        TransitionManager& manager;
+        AnimatableProperty property;
+
+        TransitionFinished(TransitionManager& manager, const AnimatableProperty property)
+            : manager(manager), property(property) {}
+
+        bool await_ready() const { return !manager.HasActiveTransition(property); }
+        void await_suspend(const UiTask::Handle handle) const {
+            handle.promise().scheduler->WaitTransition(handle, manager, property);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    inline std::coroutine_handle<> UiTask::FinalAwaiter::await_suspend(const Handle handle) noexcept {
+        const promise_type& promise = handle.promise();
+        if (promise.continuation) return promise.continuation;
+
+        // Spawned task: the scheduler owns the frame and destroys it here
+        if (promise.scheduler) promise.scheduler->Finish(promise.id);
+        return std::noop_coroutine();
+    }
+}
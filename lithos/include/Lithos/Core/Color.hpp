@@ -15,12 +15,18 @@
  */
 
 #pragma once
-#include "../PCH.hpp"
+#ifdef _WIN32
+    #include "../PCH.hpp"
+#endif
 
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
@@ -43,9 +49,11 @@ namespace Lithos {
             return {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
         }
 
+#ifdef _WIN32
         explicit operator D2D1_COLOR_F() const {
             return D2D1::ColorF(r, g, b, a);
         }
+#endif
     };
 
     namespace Colors {
@@ -0,0 +1,88 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "../Element.hpp"
+#include "../Image/ImageLoader.hpp"
+
+namespace Lithos {
+    /**
+     * @brief Element showing an image decoded in the background
+     *
+     * The image is decoded at the size of the content box (inside the padding) on the
+     * loader's job system, so a large photo shown as a thumbnail never exists at full
+     * size. Until it arrives the content box shows the placeholder color; the swap then
+     * repaints only the element's own bounds, without layout. After a resize the old
+     * image stays up, stretched, until the decode for the new size replaces it.
+     *
+     * The element's size comes from width() and height(), never from the image.
+     */
+    class LITHOS_API ImageElement : public ElementBase<ImageElement> {
+    public:
+        ImageElement();
+        explicit ImageElement(std::string_view source);
+
+        /**
+         * @brief File path (UTF-8), or whatever the loader's fetcher understands; empty = no image
+         */
+        ImageElement& source(std::string_view path);
+        ImageElement& fit(ImageFit mode);
+        ImageElement& placeholderColor(const Color& color);
+
+        /**
+         * @brief Loader to decode with; nullptr (the default) uses Window::GetImageLoader()
+         */
+        ImageElement& loader(ImageLoader* l);
+
+        const std::string& GetSource() const { return key.source; }
+        const std::shared_ptr<const DecodedImage>& GetImage() const { return image; }
+
+        /**
+         * @brief A decode for the current source or size is in flight
+         */
+        bool IsLoading() const { return loading; }
+
+        /**
+         * @brief The source could not be read or decoded
+         */
+        bool HasFailed() const { return failed; }
+
+        void Record(DisplayList& list, const Rect& clip) const override;
+        void AccountMemory(MemoryReport& report) const override;
+
+    protected:
+        void ResolveSize() override;
+
+    private:
+        ImageKey key;           ///< Source, fit and content box size wanted
+        ImageKey requested;     ///< Key of the last request; a mismatch after layout means reload
+        std::shared_ptr<const DecodedImage> image;
+        ImageLoader* customLoader = nullptr;
+        Color placeholder{0.9f, 0.9f, 0.9f, 1.0f};
+        uint64_t requestId = 0; ///< Bumped per request; callbacks of superseded requests are dropped
+        bool loading = false;
+        bool failed = false;
+
+        ImageLoader* GetLoader() const;
+        Rect GetContentBox() const;
+        void Request();
+        void Deliver(uint64_t request, const std::shared_ptr<const DecodedImage>& result);
+    };
+}
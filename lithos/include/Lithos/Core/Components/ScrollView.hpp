@@ -0,0 +1,89 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <chrono>
+#include "../Element.hpp"
+
+namespace Lithos {
+    /**
+     * @brief Element whose children scroll inside its border box
+     *
+     * The scroll offset is a paint-time translation plus clip (see Element::Record), so
+     * scrolling repaints without invalidating layout and costs the same however much
+     * content there is. Children keep their layout coordinates; hit testing maps the
+     * pointer into content space.
+     *
+     * Wheel input scrolls smoothly towards an accumulated target; Fling() starts
+     * inertial scrolling that decays exponentially. Both advance in Animate(), driven
+     * by the window's frame clock.
+     */
+    class LITHOS_API ScrollView : public ElementBase<ScrollView> {
+    public:
+        ScrollView();
+
+        /**
+         * @brief Scrolls so (offsetX, offsetY) of the content is at the top-left of the view
+         * @param smooth Ease towards the offset instead of jumping
+         */
+        ScrollView& ScrollTo(float offsetX, float offsetY, bool smooth = false);
+
+        /**
+         * @brief Scrolls relative to the current target; consecutive smooth calls accumulate
+         */
+        ScrollView& ScrollBy(float dx, float dy, bool smooth = true);
+
+        /**
+         * @brief Starts inertial scrolling at the given content velocity (pixels per second)
+         */
+        void Fling(float velocityX, float velocityY);
+
+        /**
+         * @brief Stops smooth or inertial motion where it is
+         */
+        void StopScrolling();
+
+        /**
+         * @brief Pixels scrolled per wheel notch
+         */
+        ScrollView& scrollStep(float pixels);
+
+        /**
+         * @brief Exponential decay rate of fling velocity, per second
+         */
+        ScrollView& friction(float rate);
+
+        float GetMaxScrollX() const;
+        float GetMaxScrollY() const;
+
+        bool IsScrolling() const { return motion != Motion::None; }
+
+        bool OnMouseEvent(MouseEvent evt) override;
+        bool Animate(std::chrono::steady_clock::time_point now) override;
+
+    private:
+        enum class Motion : uint8_t { None, Smooth, Inertial };
+
+        Motion motion = Motion::None;
+        float targetX = 0.0f, targetY = 0.0f;
+        float velocityX = 0.0f, velocityY = 0.0f;
+        float step = 48.0f;
+        float decay = 4.0f;
+        std::chrono::steady_clock::time_point lastTick{};   ///< Default until the first frame of a motion
+
+        void Start(Motion m);
+    };
+}
@@ -1,8 +1,152 @@
-//
-// Created by main on 2026/01/29.
-//
+/*
+    Copyright 2026 RiriFa
 
-#ifndef LITHOS_TEXTELEMENT_HPP
-#define LITHOS_TEXTELEMENT_HPP
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
 
-#endif //LITHOS_TEXTELEMENT_HPP
\ No newline at end of file
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Element.hpp"
+#include "../Text/TextBuffer.hpp"
+
+namespace Lithos {
+    class DeviceResources;
+
+    struct TextLayoutStats {
+        size_t linesMeasured = 0;       ///< Lines measured since the last ResetStats()
+        size_t sizeChanges = 0;         ///< Edits that changed the element's size and invalidated layout
+        size_t repaints = 0;            ///< Edits that only needed a repaint
+    };
+
+    /**
+     * @brief Element showing multi-line text
+     *
+     * The text lives in a TextBuffer, so edits anywhere cost O(log n) plus the edited
+     * text. Each line ('\n'-separated paragraph) keeps its measured width; an edit
+     * re-measures only the lines it touched. Layout is invalidated only when the
+     * element's size changes (line count, or the widest line while fitting the width);
+     * other edits just repaint. Painting records only the lines inside the clip.
+     *
+     * The height always follows the text. The width follows the widest line until
+     * width() fixes it; longer lines are clipped. Lines don't wrap.
+     *
+     * Widths come from a pluggable measurer. The default estimates a fixed advance
+     * per character, which needs no device; DirectWrite() measures with real fonts.
+     */
+    class LITHOS_API TextElement : public ElementBase<TextElement> {
+    public:
+        /**
+         * @brief Returns the advance width of one line (without its '\n')
+         */
+        using Measurer = std::function<float(std::wstring_view line, std::wstring_view family, float fontSize)>;
+
+        TextElement();
+        explicit TextElement(std::wstring_view text);
+
+        TextElement& SetText(std::wstring_view text);
+        TextElement& AppendText(std::wstring_view text);
+
+        /**
+         * @param offset Clamped to the text length
+         */
+        TextElement& InsertText(size_t offset, std::wstring_view text);
+        TextElement& EraseText(size_t offset, size_t count);
+
+        const TextBuffer& GetBuffer() const { return buffer; }
+        std::wstring GetText() const { return buffer.ToString(); }
+        size_t GetLineCount() const { return buffer.LineCount(); }
+
+        TextElement& font(std::wstring_view family);
+        TextElement& fontSize(float size);
+        TextElement& textColor(const Color& color);
+
+        /**
+         * @brief Distance between baselines; 0 = fontSize * DefaultLineSpacing
+         */
+        TextElement& lineHeight(float pixels);
+
+        /**
+         * @brief Replaces the measurer and re-measures every line; nullptr restores the estimate
+         */
+        TextElement& measurer(Measurer m);
+
+        /**
+         * @brief Fixes the width; the text no longer resizes the element horizontally
+         */
+        TextElement& width(float w);
+
+        /**
+         * @brief Sizes the width to the widest line plus padding (the default)
+         */
+        TextElement& fitWidth();
+
+#ifdef _WIN32
+        /**
+         * @brief Measurer backed by DirectWrite; resources must outlive the element
+         */
+        static Measurer DirectWrite(DeviceResources& resources);
+#endif
+
+        static constexpr float DefaultLineSpacing = 1.25f;
+
+        float GetLineHeight() const;
+        float GetLineWidth(size_t line) const { return lineWidths[line]; }
+
+        /**
+         * @brief Width of the widest line
+         */
+        float GetTextWidth() const;
+
+        void Record(DisplayList& list, const Rect& clip) const override;
+        void AccountMemory(MemoryReport& report) const override;
+
+        const TextLayoutStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    protected:
+        void ResolveSize() override;
+
+    private:
+        TextBuffer buffer;
+        std::vector<float> lineWidths{0.0f};    ///< One per line of buffer
+        mutable float maxWidth = 0.0f;
+        mutable bool maxWidthStale = false;     ///< The widest line shrank or went away; rescan on demand
+
+        std::wstring family = L"Segoe UI";
+        float fixedLineHeight = 0.0f;
+        float measuredFontSize;                 ///< style.fontSize the widths were measured at
+        bool fit = true;
+        Measurer measure;
+        TextLayoutStats stats;
+
+        float Measure(std::wstring_view line);
+        float MeasureLine(size_t line);
+        void MeasureAll();
+
+        /**
+         * @brief Replaces `removed` widths at first with `added` freshly measured lines
+         */
+        void Remeasure(size_t first, size_t removed, size_t added);
+
+        float FittedWidth() const;
+        float FittedHeight() const;
+
+        /**
+         * @brief Invalidates layout if the size no longer matches the text, else repaints
+         */
+        void TextChanged();
+    };
+}
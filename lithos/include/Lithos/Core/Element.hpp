@@ -16,49 +16,169 @@
 
 #pragma once
 #include <algorithm>
-
-#include "../PCH.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+    #include "../PCH.hpp"
+#endif
 #include "Color.hpp"
+#include "ElementPool.hpp"
+#include "FlatTree.hpp"
 #include "Geometry.hpp"
+#include "MemoryReport.hpp"
+#include "Rect.hpp"
+#include "SpatialIndex.hpp"
 #include "Style.hpp"
 
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
     class Window;
+    class DisplayList;
     struct MouseEvent;
+    struct Node;
+    enum class MouseEventType;
+
+    using EventListener = std::function<void(MouseEvent&)>;
+
+    namespace AnimatedColor {
+        inline constexpr uint8_t Background = 1 << 0;
+        inline constexpr uint8_t Border     = 1 << 1;
+        inline constexpr uint8_t Shadow     = 1 << 2;
+        inline constexpr uint8_t Text       = 1 << 3;
+    }
 
     class LITHOS_API Element : public std::enable_shared_from_this<Element> {
     public:
         Element();
         virtual ~Element();
 
+        // Children, siblings and the window point at an element by address
         Element(const Element&) = delete;
         Element& operator=(const Element&) = delete;
-        Element(Element&&) = default;
-        Element& operator=(Element&&) = default;
+        Element(Element&&) = delete;
+        Element& operator=(Element&&) = delete;
+
+        /**
+         * @brief Creates an element in pool, object and control block in one block;
+         *        falls back to std::make_shared when pool is null
+         *
+         * Children added with AddChild<T>(args...) come from their parent's pool.
+         */
+        template<typename T, typename... Args>
+        static std::shared_ptr<T> Make(ElementPool* pool, Args&&... args) {
+            static_assert(std::is_base_of_v<Element, T>);
+            if (!pool) {
+                return std::make_shared<T>(std::forward<Args>(args)...);
+            }
+            auto element = std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+            static_cast<Element*>(element.get())->pool = pool;
+            return element;
+        }
 
         // ========= Child management =========
+        /*
+         * Sibling order lives in an intrusive doubly linked list, so inserting,
+         * removing, moving and reparenting are O(1). `children` is the indexed copy
+         * that layout, painting and hit testing search. Appends keep it in order.
+         * A removal swaps the last entry into the hole, so the removed child's
+         * reference is released at once. That and any other edit mark the array
+         * stale, and the next layout re-sorts it in one pass, so churn costs O(n)
+         * per frame instead of O(n) per edit.
+         */
+
+        /**
+         * @brief Appends child; it is first detached from any previous parent
+         */
         template<typename T>
         T& AddChild(std::shared_ptr<T> child) {
-            static_assert(std::is_base_of_v<Element, T>);
-            T* ptr = child.get();
-            child->parent = shared_from_this();
-            child->windowPtr = this->windowPtr;
-            children.push_back(std::static_pointer_cast<Element>(child));
-            RequestRepaint();
-            return *ptr;
+            return InsertChild(std::move(child), nullptr);
         }
 
         template<typename T, typename... Args>
         T& AddChild(Args&&... args) {
-            return AddChild(std::make_shared<T>(std::forward<Args>(args)...));
+            return AddChild(Make<T>(pool, std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Inserts child before `before` (a child of this element), or appends when null
+         *
+         * Does nothing when child is this element or one of its ancestors: the tree
+         * would own itself.
+         */
+        template<typename T>
+        T& InsertChild(std::shared_ptr<T> child, Element* before) {
+            static_assert(std::is_base_of_v<Element, T>);
+            T& ref = *child;
+            if (AttachChild(std::static_pointer_cast<Element>(std::move(child)), before)) ChildrenChanged();
+            return ref;
         }
 
+        /**
+         * @brief Appends a range of children with a single invalidation
+         * @param range Any range of std::shared_ptr<T>, T derived from Element
+         */
+        template<typename Range>
+        void AddChildren(Range&& range) {
+            if constexpr (std::ranges::sized_range<Range>) {
+                ReserveChildren(childCount + std::ranges::size(range));
+            }
+            for (auto&& child : range) {
+                AttachChild(std::static_pointer_cast<Element>(std::forward<decltype(child)>(child)), nullptr);
+            }
+            ChildrenChanged();
+        }
+
+        /**
+         * @brief Preallocates room for n children
+         */
+        void ReserveChildren(size_t n) { children.reserve(n); }
+
+        /**
+         * @brief Detaches child from this element in O(1)
+         * @return The child, now parentless and outside any window
+         */
+        std::shared_ptr<Element> RemoveChild(Element& child);
+
+        /**
+         * @brief Moves one of this element's children before `before`, or to the end when null
+         */
+        void MoveChild(Element& child, Element* before);
+
+        /**
+         * @brief Detaches every child
+         */
+        void ClearChildren();
+
+        /**
+         * @brief Moves this element under newParent, before `before` or at the end
+         *
+         * Stays O(1) when both parents belong to the same window, plus a walk up from
+         * newParent: moving an element under itself or its own descendant does nothing.
+         */
+        void Reparent(Element& newParent, Element* before = nullptr);
+
+        size_t GetChildCount() const { return childCount; }
+        Element* GetFirstChild() const { return firstChild; }
+        Element* GetLastChild() const { return lastChild; }
+        Element* GetNextSibling() const { return nextSibling; }
+        Element* GetPreviousSibling() const { return prevSibling; }
+
         // ========== Styling (宣言のみ) ==========
         Element& width(float w);
         Element& height(float h);
@@ -79,42 +199,282 @@ namespace Lithos {
 
         Element& cursor(CursorType c);
 
+        /**
+         * @brief Default handler, run after this element's listeners at the target and while bubbling
+         * @return true to stop the event from reaching ancestors
+         */
         virtual bool OnMouseEvent(MouseEvent evt);
-        virtual void Draw(ID2D1DeviceContext* rt);
+
+        /**
+         * @brief Registers a listener for one event type
+         * @param capture true to run while the event travels down (capture phase),
+         *        false to run at the target and while it bubbles up
+         * @return Id for RemoveEventListener()
+         *
+         * Listeners added during a dispatch first run for the next event.
+         */
+        uint32_t AddEventListener(MouseEventType type, EventListener listener, bool capture = false);
+
+        /**
+         * @brief Unregisters a listener; safe to call from inside any listener
+         */
+        void RemoveEventListener(uint32_t id);
+
+#ifdef _WIN32
+        /**
+         * @brief Draws this element and the part of its subtree that intersects clip
+         */
+        virtual void Draw(ID2D1DeviceContext* rt, const Rect& clip);
+#endif
+
+        /**
+         * @brief Records this element and the part of its subtree that intersects clip
+         *        into a backend-neutral display list
+         */
+        virtual void Record(DisplayList& list, const Rect& clip) const;
         bool HitTest(float x, float y) const;
+
+        /**
+         * @brief Topmost visible element of this subtree under the point
+         *
+         * Descends only into children whose subtree bounds contain the point: by binary
+         * search when children are laid out in order, through a grid index for large
+         * unordered child lists. Later children win over earlier ones and over the parent.
+         * @return nullptr if nothing is hit
+         */
+        Element* FindElementAt(float x, float y);
+
+        /**
+         * @brief Parent element, or nullptr for the root / detached elements
+         */
+        Element* GetParent() const { return parent; }
+
         void RequestRepaint();
+
+        /**
+         * @brief Repaints only area (window coordinates), e.g. GetWindowPaintBounds() after a
+         *        change that can't affect anything outside this element's own box
+         */
+        void RequestRepaint(const Rect& area);
+
+        /**
+         * @brief Advances time-driven state (e.g. scrolling) to the frame at `now`
+         * @return true to be called again next frame
+         */
+        virtual bool Animate(std::chrono::steady_clock::time_point now);
+
+        /**
+         * @brief Has the window call Animate() before each frame until it returns false
+         */
+        void RequestAnimationFrame();
+
+        /**
+         * @brief Marks this element for layout; ancestors are flagged so the next
+         *        UpdateLayout() walks down to it without touching clean subtrees
+         */
         void InvalidateLayout();
 
+        /**
+         * @brief Lays out the subtree (block flow: children stacked vertically inside the padding box)
+         * @param originX Left edge assigned by the parent, margins already applied
+         * @param originY Top edge assigned by the parent, margins already applied
+         *
+         * Clean subtrees are only translated when their origin moves.
+         */
+        void UpdateLayout(float originX = 0.0f, float originY = 0.0f);
+
+        bool NeedsLayout() const { return layoutDirty || subtreeLayoutDirty; }
+
+        /**
+         * @brief Area this element alone paints (box, shadow and antialiasing margin)
+         */
+        Rect GetPaintBounds() const;
+
+        /**
+         * @brief Union of the paint bounds of this element and all descendants, as of the last layout
+         */
+        const Rect& GetSubtreeBounds() const { return subtreeBounds; }
+
+        /**
+         * @brief GetPaintBounds() where it shows in the window: shifted by the scroll offsets
+         *        of clipping ancestors and cut to their clip rects
+         */
+        Rect GetWindowPaintBounds() const;
+
+        /**
+         * @brief Region children are clipped to when this element scrolls: the box inside its border
+         */
+        Rect GetClipRect() const;
+
+        float GetScrollX() const { return scrollX; }
+        float GetScrollY() const { return scrollY; }
+
         // Getters
         float getX() const { return x; }
         float getY() const { return y; }
 
-    protected:
-        Window* windowPtr;
+        // ========== Memory ==========
+        /**
+         * @brief Size of the concrete object; ElementBase<T> reports sizeof(T)
+         */
+        virtual size_t ObjectSize() const { return sizeof(Element); }
 
-        std::weak_ptr<Element> parent;
-        std::vector<std::shared_ptr<Element>> children;
+        /**
+         * @brief Adds this element's own memory (not its children's) to report
+         *
+         * Subclasses holding more heap state override this and call the base.
+         */
+        virtual void AccountMemory(MemoryReport& report) const;
 
-        std::unique_ptr<Geometry> geometry;
+        /**
+         * @brief AccountMemory() over the whole subtree
+         */
+        void AccountSubtreeMemory(MemoryReport& report) const;
 
-        // Performance optimization: cached brushes
-        mutable ComPtr<ID2D1SolidColorBrush> cachedBackgroundBrush;
-        mutable Color cachedBackgroundColor;
-        mutable ComPtr<ID2D1SolidColorBrush> cachedBorderBrush;
-        mutable Color cachedBorderColor;
+    protected:
+        Window* windowPtr;
+
+        Element* parent = nullptr;          ///< Owner; cleared when the parent is destroyed
+        ElementPool* pool = nullptr;        ///< Pool this element lives in (kept alive by it); children use it too
+        std::vector<std::shared_ptr<Element>> children;   ///< Owns exactly the linked children; sibling order while !childrenStale
+
+        // Sibling list, the authoritative child order
+        Element* firstChild = nullptr;
+        Element* lastChild = nullptr;
+        Element* prevSibling = nullptr;
+        Element* nextSibling = nullptr;
+        size_t childCount = 0;
+
+        std::shared_ptr<const Node> description;    ///< Node last reconciled into this element, if any
+
+        Geometry geometry;      ///< Hit-test shape; GeometryKind::None uses the layout box
+
+        struct Listener {
+            EventListener callback;
+            uint32_t id;                    ///< 0 once removed
+            MouseEventType type;
+            bool capture;
+        };
+
+        /// Deque so adding during dispatch never moves a running callback
+        struct ListenerList {
+            std::deque<Listener> entries;
+            uint32_t nextId = 1;
+            uint32_t dispatching = 0;
+            bool hasRemoved = false;
+        };
+        std::unique_ptr<ListenerList> listeners;    ///< Created on first AddEventListener()
 
         float x, y;
 
+        /// Color properties currently mid-transition (AnimatedColor bits), drawn with
+        /// the window's mutable brush instead of a cached one
+        uint8_t animatedColors = 0;
+
         bool isVisible = true;
+        bool animationPending = false;      ///< Registered with the window for Animate()
+
+        /// Children are clipped to GetClipRect() and painted shifted by the scroll offset
+        bool clipsChildren = false;
+        float scrollX = 0.0f, scrollY = 0.0f;   ///< Paint-time offset of the children; layout never sees it
+        float contentWidth = 0.0f;          ///< Children's margin boxes plus padding, from the last layout
+        float contentHeight = 0.0f;
+
+        uint32_t indexInParent = 0;         ///< Slot in parent->children (the sibling index while the parent isn't stale)
+
+        bool layoutDirty = true;            ///< Own position/size or child placement changed
+        bool subtreeLayoutDirty = false;    ///< Some descendant has layoutDirty set
+        bool childrenOrdered = true;        ///< Children's subtree tops are non-decreasing
+        bool childrenStale = false;         ///< `children` is out of sibling order
+
+        // FlatTree bookkeeping
+        uint32_t flatIndex = FlatTree::None;
+        bool flatDirty = true;              ///< Fields the flat tree mirrors changed since the last sync
+        bool subtreeFlatDirty = false;      ///< Some descendant has flatDirty or structureDirty set
+        bool structureDirty = true;         ///< Children were added or removed
+        bool customPaint = false;           ///< Set by subclasses overriding Record(); flat passes call it
+
+        Rect subtreeBounds;
+        std::vector<float> childReach;      ///< Running max of children's subtree bottoms, for binary search
+        std::unique_ptr<SpatialIndex> childIndex;   ///< Children's subtree bounds relative to (x, y), when unordered
 
         Style style;
 
+        /**
+         * @brief Children that may intersect clip, as [first, last); falls back to all
+         *        children while layout is pending
+         */
+        std::pair<size_t, size_t> ChildRange(const Rect& clip) const;
+
+        void Translate(float dx, float dy);
+
+        /**
+         * @brief Links child before `before` and takes a reference; no invalidation
+         * @return False, leaving the tree as it was, when child is this element or an ancestor
+         */
+        bool AttachChild(std::shared_ptr<Element> child, Element* before);
+
+        /**
+         * @brief Unlinks child and drops this element's reference to it; may leave `children` stale
+         */
+        void DetachChild(Element& child);
+
+        void Link(Element& child, Element* before);
+        void Unlink(Element& child);
+
+        /**
+         * @brief Flags the structure change for layout and the flat tree
+         */
+        void ChildrenChanged();
+
+        /**
+         * @brief Puts `children` back in sibling order and renumbers indexInParent when stale
+         */
+        void SyncChildren();
+
+        /**
+         * @brief Sets windowPtr across the subtree, moving each element between the windows' running totals
+         */
+        void SetWindow(Window* window);
+
+        void RecordChildren(DisplayList& list, const Rect& clip) const;
+
+        /**
+         * @brief Moves the children's paint-time offset; repaints without invalidating layout
+         */
+        void SetScrollOffset(float sx, float sy);
+
+        /**
+         * @brief Flags this element for the next FlatTree sync
+         */
+        void MarkFlatDirty();
+
+        BoxPaint GetBoxPaint() const;
+
+        /**
+         * @brief Called when layout reaches this element, before its box is used;
+         *        elements with an intrinsic size write it into style.width/height here
+         */
+        virtual void ResolveSize() {}
+
+        /**
+         * @brief Runs this element's listeners for the event's phase
+         */
+        void InvokeListeners(MouseEvent& evt, bool capture);
+
         friend class TransitionManager;
+        friend class HoverTracker;
+        friend class EventDispatcher;
+        friend class FlatTree;
+        friend class Window;
+        friend class Reconciler;
     };
 
     template <typename Derived>
     class ElementBase : public Element {
     public:
+        size_t ObjectSize() const override { return sizeof(Derived); }
+
         Derived& width(float w) {
             style.width = w;
             InvalidateLayout();
@@ -141,14 +501,12 @@ namespace Lithos {
 
         Derived& backgroundColor(const Color& color) {
             style.backgroundColor = color;
-            cachedBackgroundBrush.Reset();
             RequestRepaint();
             return static_cast<Derived&>(*this);
         }
 
         Derived& borderColor(const Color& color) {
             style.borderColor = color;
-            cachedBorderBrush.Reset();
             RequestRepaint();
             return static_cast<Derived&>(*this);
         }
@@ -158,7 +516,8 @@ namespace Lithos {
             style.shadowOffsetY = offsetY;
             style.shadowBlur    = blur;
             style.shadowColor   = c;
-            RequestRepaint();
+            style.shadowEnabled = true;
+            InvalidateLayout(); // Shadow extent feeds the subtree bounds
             return static_cast<Derived&>(*this);
         }
 
@@ -0,0 +1,120 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    struct ElementPoolStats {
+        size_t chunks = 0;          ///< Chunks allocated from the system
+        size_t bytesReserved = 0;   ///< Total chunk bytes (plus oversized blocks)
+        size_t bytesInUse = 0;      ///< Bytes handed out and not yet returned, rounded to size classes
+        size_t liveBlocks = 0;
+    };
+
+    /**
+     * @brief Size-class pool backing element allocation
+     *
+     * Blocks up to MaxBlockSize are carved from large chunks and recycled through one
+     * free list per 16-byte size class; bigger or over-aligned ones go to the system
+     * allocator. Elements and their shared_ptr control blocks come from one block each
+     * (see Element::Make), so building and tearing down a tree never reaches malloc
+     * once the pool is warm.
+     *
+     * The pool is reference counted without atomics: Create() returns one reference and
+     * every live block holds another, so memory stays valid until the owner has called
+     * Release() and the last element is gone. Allocation and release must happen on the
+     * thread that owns the tree.
+     */
+    class LITHOS_API ElementPool {
+    public:
+        static constexpr size_t Granularity = 16;
+        static constexpr size_t MaxBlockSize = 1024;
+        static constexpr size_t ChunkSize = 64 * 1024;
+
+        /**
+         * @return New pool holding one reference for the caller
+         */
+        static ElementPool* Create();
+
+        void Retain() { refs++; }
+        void Release();
+
+        void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+        void Deallocate(void* p, size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+        const ElementPoolStats& GetStats() const { return stats; }
+
+        ElementPool(const ElementPool&) = delete;
+        ElementPool& operator=(const ElementPool&) = delete;
+
+    private:
+        static constexpr size_t ClassCount = MaxBlockSize / Granularity;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        size_t refs = 1;
+        std::array<FreeBlock*, ClassCount> freeLists{};
+        std::vector<void*> chunks;
+        std::byte* cursor = nullptr;    ///< Bump pointer into the newest chunk
+        std::byte* limit = nullptr;
+        ElementPoolStats stats;
+
+        ElementPool() = default;
+        ~ElementPool();
+    };
+
+    /**
+     * @brief Standard allocator over an ElementPool, for std::allocate_shared
+     */
+    template<typename T>
+    struct PoolAllocator {
+        using value_type = T;
+
+        ElementPool* pool;
+
+        explicit PoolAllocator(ElementPool* p) noexcept : pool(p) {}
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>& other) noexcept : pool(other.pool) {}
+
+        T* allocate(const size_t n) {
+            return static_cast<T*>(pool->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, const size_t n) noexcept {
+            pool->Deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>& other) const noexcept { return pool == other.pool; }
+    };
+}
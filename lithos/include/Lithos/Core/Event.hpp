@@ -15,19 +15,29 @@
  */
 
 #pragma once
+#include <chrono>
+#include <cstdint>
 
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
+    class Element;
+
     enum class MouseEventType {
         MouseDown,
         MouseUp,
         MouseMove,
-        MouseWheel
+        MouseWheel,
+        MouseEnter,     ///< Pointer entered the element or one of its descendants (not bubbled)
+        MouseLeave      ///< Pointer left the element and all of its descendants (not bubbled)
     };
 
     enum MouseButton {
@@ -36,10 +46,38 @@ namespace Lithos {
         Middle
     };
 
+    enum class EventPhase : uint8_t {
+        None,
+        Capturing,      ///< Travelling from the root down to the target's parent
+        AtTarget,
+        Bubbling        ///< Travelling from the target's parent back up to the root
+    };
+
     struct MouseEvent {
         MouseEventType type;
         int x = 0, y = 0, wheelDelta = 0;
         MouseButton button = Left;
+        std::chrono::steady_clock::time_point timestamp{};     ///< When the platform delivered the event
+
+        // Filled in by EventDispatcher
+        EventPhase phase = EventPhase::None;
+        Element* target = nullptr;          ///< Element the event was dispatched to
+        Element* currentTarget = nullptr;   ///< Element whose listeners are running
+        bool propagationStopped = false;
+        bool immediatePropagationStopped = false;
+
+        /**
+         * @brief Finishes the current element's listeners, then stops
+         */
+        void StopPropagation() { propagationStopped = true; }
+
+        /**
+         * @brief Stops without running the current element's remaining listeners
+         */
+        void StopImmediatePropagation() {
+            propagationStopped = true;
+            immediatePropagationStopped = true;
+        }
     };
 
     struct WindowEvent {
@@ -0,0 +1,68 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Event.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class Element;
+
+    /**
+     * @brief Delivers mouse events along the target's ancestor path in three phases
+     *
+     * Capture listeners run from the root down to the target's parent, then the target's
+     * capture and bubble listeners and its OnMouseEvent(), then bubble listeners and
+     * OnMouseEvent() from the parent back up to the root. StopPropagation() (or an
+     * OnMouseEvent() returning true) ends the walk after the current element.
+     *
+     * The path is snapshotted before the first listener runs, so handlers that move or
+     * remove elements don't change who receives the event, and it is held in a reused
+     * buffer: once warmed up, dispatch does not allocate. Dispatch may be re-entered
+     * from a listener.
+     */
+    class LITHOS_API EventDispatcher {
+    public:
+        EventDispatcher();
+
+        /**
+         * @brief Runs the capture, target and bubble phases for evt
+         * @return true if propagation was stopped
+         */
+        bool Dispatch(Element& target, MouseEvent& evt);
+
+        /**
+         * @brief Delivers to the target only (MouseEnter / MouseLeave)
+         */
+        static bool DispatchAtTarget(Element& target, MouseEvent& evt);
+
+    private:
+        /// Target first, root last; nested dispatches push above their caller's slice
+        std::vector<std::shared_ptr<Element>> path;
+    };
+}
@@ -0,0 +1,189 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Color.hpp"
+#include "MemoryReport.hpp"
+#include "Rect.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class DisplayList;
+    class Element;
+
+    /**
+     * @brief Style fields a plain element paints with
+     */
+    struct BoxPaint {
+        Color background;
+        Color border;
+        Color shadow;
+        float borderWidth = 0.0f;
+        float borderRadius = 0.0f;
+        float opacity = 1.0f;
+        float shadowOffsetX = 0.0f, shadowOffsetY = 0.0f;
+        float shadowBlur = 0.0f;
+        float scrollX = 0.0f, scrollY = 0.0f;
+        bool shadowEnabled = false;
+        uint8_t animatedColors = 0;     ///< AnimatedColor bits
+    };
+
+    struct FlatTreeStats {
+        size_t rebuilds = 0;        ///< Full rebuilds: first sync, new root, or too much handed back
+        size_t refreshed = 0;       ///< Nodes copied by incremental syncs
+        size_t detached = 0;        ///< Subtrees handed back to their element after a structural change
+    };
+
+    /**
+     * @brief Pre-order, structure-of-arrays copy of an element tree
+     *
+     * Holds each node's parent, subtree end, box, subtree bounds and paint fields in
+     * contiguous arrays, and every node's children as a contiguous slice of indices
+     * with the running bottoms ChildRange() searches. Record() and FindElementAt()
+     * produce the same results as the object-tree versions without touching elements,
+     * except for subtrees handed back to them: elements with custom painting, and
+     * large unordered child lists that have a grid index, and subtrees whose children
+     * changed since the last rebuild.
+     *
+     * Sync() after layout keeps it current. Elements flag themselves when anything
+     * the arrays mirror changes; a sync copies only the flagged nodes, walking the
+     * flagged path the way layout does. An element whose children were added, removed
+     * or reordered keeps its node, but its subtree is walked through the element from
+     * then on; once such subtrees hold a quarter of the nodes the next sync rebuilds.
+     */
+    class LITHOS_API FlatTree {
+    public:
+        static constexpr uint32_t None = UINT32_MAX;
+
+        /**
+         * @brief Brings the arrays up to date with root's subtree; call after UpdateLayout()
+         */
+        void Sync(Element& root);
+
+        /**
+         * @brief Rebuilds everything from root
+         */
+        void Rebuild(Element& root);
+
+        /**
+         * @brief True if the arrays reflect root's subtree with no changes pending
+         */
+        bool IsCurrent(const Element& root) const;
+
+        void Clear();
+
+        size_t Size() const { return elements.size(); }
+
+        /**
+         * @brief Heap bytes held by the arrays
+         */
+        size_t GetMemoryBytes() const;
+
+        /**
+         * @brief Same output as root.Record(list, clip)
+         */
+        void Record(DisplayList& list, const Rect& clip) const;
+
+        /**
+         * @brief Same result as root.FindElementAt(x, y)
+         */
+        Element* FindElementAt(float x, float y) const;
+
+        Element* GetElement(const uint32_t node) const { return elements[node]; }
+        uint32_t GetParent(const uint32_t node) const { return parents[node]; }
+        uint32_t GetSubtreeEnd(const uint32_t node) const { return subtreeEnds[node]; }
+        const Rect& GetBox(const uint32_t node) const { return boxes[node]; }
+        const Rect& GetSubtreeBounds(const uint32_t node) const { return subtreeBounds[node]; }
+
+        /**
+         * @brief Changes when the node is copied again; increases monotonically across syncs
+         */
+        uint64_t GetVersion(const uint32_t node) const { return versions[node]; }
+
+        /**
+         * @brief Highest version in the node's subtree: unchanged means nothing below changed
+         */
+        uint64_t GetSubtreeVersion(const uint32_t node) const { return subtreeVersions[node]; }
+
+        const FlatTreeStats& GetStats() const { return stats; }
+
+        /**
+         * @brief Records one element's shadow, background and border (shared with Element::Record)
+         */
+        static void RecordBox(DisplayList& list, const Rect& box, const BoxPaint& paint);
+
+    private:
+        enum NodeFlags : uint8_t {
+            Visible         = 1 << 0,
+            Unlaid          = 1 << 1,   ///< Layout pending: bounds unusable, children not ranged
+            Ordered         = 1 << 2,   ///< Children's subtree tops are non-decreasing
+            ClipsChildren   = 1 << 3,
+            HasGeometry     = 1 << 4,   ///< Hit test through the element's shape
+            Delegated       = 1 << 5,   ///< Custom paint or grid-indexed children: ask the element
+            Detached        = 1 << 6    ///< Structure changed; descendants' nodes are stale (also Delegated)
+        };
+
+        const Element* root = nullptr;
+
+        // Topology, in pre-order
+        std::vector<Element*> elements;
+        std::vector<uint32_t> parents;
+        std::vector<uint32_t> subtreeEnds;  ///< One past the last descendant
+        std::vector<uint32_t> childBegin;   ///< Slice of childList / childReach
+        std::vector<uint32_t> childCount;
+        std::vector<uint32_t> childList;
+        std::vector<float> childReach;
+
+        // Hot per-node data
+        std::vector<uint8_t> flags;
+        std::vector<Rect> boxes;
+        std::vector<Rect> subtreeBounds;
+        std::vector<Rect> clipRects;
+        std::vector<BoxPaint> paints;
+
+        // Change tracking for consumers that cache per-subtree output (SceneBuilder)
+        std::vector<uint64_t> versions;
+        std::vector<uint64_t> subtreeVersions;
+        uint64_t version = 0;               ///< Last version handed out; survives Clear()
+        size_t staleNodes = 0;              ///< Nodes under Detached nodes
+
+        FlatTreeStats stats;
+
+        uint32_t Append(Element& element, uint32_t parent);
+        void Store(uint32_t node, Element& element);
+        bool Refresh(Element& element);
+        void Detach(Element& element);
+
+        std::pair<uint32_t, uint32_t> ChildRange(uint32_t node, const Rect& clip) const;
+        void RecordNode(uint32_t node, DisplayList& list, const Rect& clip) const;
+        Element* FindNode(uint32_t node, float x, float y) const;
+
+        friend class SceneBuilder;
+    };
+}
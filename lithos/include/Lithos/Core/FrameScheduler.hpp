@@ -0,0 +1,176 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Steps of a frame, run in declaration order
+     */
+    enum class FramePhase : uint8_t {
+        Input,      ///< Deliver queued input
+        Animate,    ///< Advance animations and transitions to the frame time
+        Layout,
+        Paint,      ///< Record and replay (or publish) the display list
+        Present
+    };
+
+    inline constexpr size_t FramePhaseCount = 5;
+
+    /// Reasons a frame is wanted; a frame runs only while at least one is pending
+    namespace FrameWork {
+        inline constexpr uint8_t Input     = 1 << 0;
+        inline constexpr uint8_t Animation = 1 << 1;
+        inline constexpr uint8_t Damage    = 1 << 2;
+        inline constexpr uint8_t Tasks     = 1 << 3;   ///< Background results to pick up (decoded images, dispatched tasks)
+        inline constexpr uint8_t Region    = 1 << 4;   ///< Damage confined to known areas; see Window::RequestRepaint(const Rect&)
+        inline constexpr uint8_t Resume    = 1 << 5;   ///< Suspended coroutines waiting on the frame; see CoroutineScheduler
+    }
+
+    struct FrameInfo {
+        uint64_t frame = 0;     ///< Sequence number, starting at 1
+        std::chrono::steady_clock::time_point time;        ///< Frame time animations should use
+        std::chrono::steady_clock::time_point deadline;    ///< When the next frame is due at the earliest
+        uint8_t work = 0;       ///< FrameWork bits requested for this frame (from Paint on, with damage requested by its earlier phases)
+    };
+
+    struct FrameSchedulerStats {
+        uint64_t frames = 0;            ///< Frames run
+        uint64_t requests = 0;          ///< RequestFrame() calls
+        uint64_t wakeups = 0;           ///< Times work arrived while idle
+        uint64_t missedIntervals = 0;   ///< Intervals skipped while work was pending (frames that ran late)
+        std::array<uint64_t, FramePhaseCount> phaseRuns{}; ///< Frames each phase ran in
+    };
+
+    /**
+     * @brief Decides when frames run, and runs them phase by phase
+     *
+     * Work is requested with FrameWork bits; while none is pending the scheduler is
+     * idle and NextFrameTime() is time_point::max(), so the platform loop can block
+     * until a message arrives instead of polling. Once work is pending a frame is due
+     * one interval after the previous one, or immediately after idling: a burst of
+     * input or damage coalesces into one frame per interval, and running animations
+     * (which re-request Animation from their phase) tick at display cadence.
+     *
+     * The scheduler never reads a clock. Tick() and NextFrameTime() work on the times
+     * passed in, so the platform loop passes steady_clock::now() and headless drivers a
+     * synthetic clock. Tick() and the phase handlers run on one thread; RequestFrame()
+     * may be called from any thread.
+     *
+     * A frame can also be booked for a point in time with RequestFrameAt(); until then
+     * the timer only moves NextFrameTime(), so waiting on it costs nothing.
+     */
+    class LITHOS_API FrameScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using PhaseHandler = std::function<void(const FrameInfo& info)>;
+
+        explicit FrameScheduler(Clock::duration interval = std::chrono::microseconds(16667));
+
+        FrameScheduler(const FrameScheduler&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        /**
+         * @brief Sets the handler run for a phase of every frame; empty to skip the phase
+         */
+        void SetPhase(FramePhase phase, PhaseHandler handler);
+
+        /**
+         * @brief Called when work is requested while idle, from the requesting thread
+         *
+         * Lets the platform wake a loop blocked on its message queue. Requests made by
+         * the phases of a running frame don't wake anything.
+         */
+        void SetWakeHandler(std::function<void()> handler);
+
+        void SetInterval(Clock::duration newInterval) { interval = newInterval; }
+        Clock::duration GetInterval() const { return interval; }
+
+        /**
+         * @brief Asks for a frame
+         * @param work FrameWork bits
+         *
+         * Damage and Region requested by a running frame before its Paint phase are
+         * folded into that frame's work and painted by it. Everything else requested
+         * during a frame, and anything requested from Paint on, goes to the next one.
+         */
+        void RequestFrame(uint8_t work);
+
+        /**
+         * @brief Asks for a frame no earlier than `at`; the earliest booking wins
+         * @param work FrameWork bits the frame runs with
+         *
+         * Scheduler thread only. Callers with later deadlines book again once it fired.
+         */
+        void RequestFrameAt(Clock::time_point at, uint8_t work);
+
+        uint8_t GetPendingWork() const { return pending.load(std::memory_order_acquire); }
+        bool IsIdle() const { return GetPendingWork() == 0; }
+
+        /**
+         * @brief Earliest time the next frame may run; time_point::max() while idle with no timer
+         */
+        Clock::time_point NextFrameTime() const;
+
+        /**
+         * @brief Runs a frame if work is pending and it is due at `now`
+         * @return true if a frame ran
+         */
+        bool Tick(Clock::time_point now);
+
+        /**
+         * @brief Runs a frame now if any work is pending or booked for `now`, ignoring the cadence
+         */
+        bool RunFrame(Clock::time_point now);
+
+        FrameSchedulerStats GetStats() const;
+        void ResetStats();
+
+    private:
+        std::array<PhaseHandler, FramePhaseCount> phases;
+        std::function<void()> wake;
+        Clock::duration interval;
+
+        std::atomic<uint8_t> pending{0};
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<bool> inFrame{false};
+
+        Clock::time_point timer = Clock::time_point::max();   ///< RequestFrameAt() booking
+        uint8_t timerWork = 0;
+        Clock::time_point anchor{};     ///< Cadence point of the last frame
+        bool started = false;
+        bool continuing = false;        ///< Work was already pending when the last frame ended
+        uint64_t frameCount = 0;
+        FrameSchedulerStats stats;
+    };
+}
@@ -15,128 +15,114 @@
  */
 
 #pragma once
-#include "../PCH.hpp"
-
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#include <cstdint>
+#include "Rect.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
+    enum class GeometryKind : uint8_t {
+        None,           ///< No shape; hit testing falls back to the owner's box
+        Rect,
+        Circle,
+        RoundedRect,
+        Path            ///< Backend path registered elsewhere (see DeviceResources::RegisterPath)
+    };
+
     /**
-     * @brief Abstract base class for geometric shapes used in hit testing and rendering
+     * @brief Shape used for hit testing and rendering, stored by value
+     *
+     * A compact tagged value: the bounding box plus corner radii or a path handle. Dispatch is a switch on the kind, so elements keep their shape inline
+     * with no allocation or vtable. Backend objects (e.g. Direct2D geometries) are
+     * not owned here; they are created on demand only for shapes that need them.
      */
     class LITHOS_API Geometry {
         public:
-            virtual ~Geometry() = default;
+            constexpr Geometry() = default;
+
+            static constexpr Geometry MakeRect(const float x, const float y, const float w, const float h) {
+                return {GeometryKind::Rect, x, y, w, h};
+            }
+
+            static constexpr Geometry MakeCircle(const float cx, const float cy, const float r) {
+                return {GeometryKind::Circle, cx - r, cy - r, r * 2.0f, r * 2.0f};
+            }
+
+            static constexpr Geometry MakeRoundedRect(const float x, const float y, const float w, const float h,
+                                                      const float rx, const float ry) {
+                Geometry g{GeometryKind::RoundedRect, x, y, w, h};
+                g.radiusX = rx;
+                g.radiusY = ry;
+                return g;
+            }
+
+            /**
+             * @param handle Path handle from the backend
+             * @param bounds Bounding box of the path, used for hit testing
+             */
+            static constexpr Geometry MakePath(const uint32_t handle, const Rect& bounds) {
+                Geometry g{GeometryKind::Path, bounds.left, bounds.top, bounds.Width(), bounds.Height()};
+                g.pathHandle = handle;
+                return g;
+            }
+
+            GeometryKind Kind() const { return kind; }
+            bool IsEmpty() const { return kind == GeometryKind::None; }
 
             /**
              * @brief Fast bounding box check (AABB test)
              * @return true if point is within axis-aligned bounding box
              */
-            virtual bool ContainsPointFast(float x, float y) const = 0;
+            bool ContainsPointFast(float px, float py) const;
 
             /**
-             * @brief Precise geometric hit test
+             * @brief Precise geometric hit test (paths are tested against their bounds)
              * @return true if point is actually inside the shape
              */
-            virtual bool ContainsPoint(float x, float y) const = 0;
+            bool ContainsPoint(float px, float py) const;
 
             /**
              * @brief Get axis-aligned bounding box
              */
-            virtual void GetBounds(float& left, float& top, float& right, float& bottom) const = 0;
+            Rect GetBounds() const { return Rect::FromXYWH(x, y, width, height); }
 
             /**
-             * @brief Get Direct2D geometry for rendering
-             * @param factory D2D factory for creating geometries
+             * @brief Update geometry position and size (circles stay centered and take the shorter side)
              */
-            virtual ID2D1Geometry* GetD2DGeometry(ID2D1Factory* factory) const = 0;
-
-            /**
-             * @brief Update geometry position and size
-             */
-            virtual void Update(float x, float y, float width, float height) = 0;
+            void Update(float newX, float newY, float newWidth, float newHeight);
 
             /**
              * @brief Get area for optimization decisions
              */
-            virtual float Area() const = 0;
+            float Area() const;
 
             /**
-             * @brief Check if this geometry intersects with another
+             * @brief Check if this geometry intersects with another (bounding boxes)
              */
-            virtual bool Intersects(const Geometry& other) const = 0;
-    };
-
-    /**
-     * @brief Rectangle geometry - most common shape
-     */
-    class LITHOS_API RectGeometry : public Geometry {
-        public:
-            explicit RectGeometry(float x = 0, float y = 0, float w = 0, float h = 0);
-
-            bool ContainsPointFast(float px, float py) const override;
-            bool ContainsPoint(float px, float py) const override;
-            void GetBounds(float& left, float& top, float& right, float& bottom) const override;
-            ID2D1Geometry* GetD2DGeometry(ID2D1Factory* factory) const override;
-            void Update(float x, float y, float width, float height) override;
-            float Area() const override;
-            bool Intersects(const Geometry& other) const override;
-
-        private:
-            float x, y, width, height;
-            mutable ComPtr<ID2D1RectangleGeometry> cachedGeometry;
-            mutable ID2D1Factory* cachedFactory = nullptr;
-    };
-
-    /**
-     * @brief Circular geometry
-     */
-    class LITHOS_API CircleGeometry : public Geometry {
-        public:
-            explicit CircleGeometry(float cx = 0, float cy = 0, float r = 0);
-
-            bool ContainsPointFast(float px, float py) const override;
-            bool ContainsPoint(float px, float py) const override;
-            void GetBounds(float& left, float& top, float& right, float& bottom) const override;
-            ID2D1Geometry* GetD2DGeometry(ID2D1Factory* factory) const override;
-            void Update(float x, float y, float width, float height) override;
-            float Area() const override;
-            bool Intersects(const Geometry& other) const override;
-
-            void SetRadius(float r);
-
-        private:
-            float centerX, centerY, radius;
-            mutable ComPtr<ID2D1EllipseGeometry> cachedGeometry;
-            mutable ID2D1Factory* cachedFactory = nullptr;
-    };
-
-    /**
-     * @brief Rounded rectangle geometry
-     */
-    class LITHOS_API RoundedRectGeometry : public Geometry {
-        public:
-            explicit RoundedRectGeometry(float x = 0, float y = 0, float w = 0, float h = 0, float rx = 0, float ry = 0);
+            bool Intersects(const Geometry& other) const;
 
-            bool ContainsPointFast(float px, float py) const override;
-            bool ContainsPoint(float px, float py) const override;
-            void GetBounds(float& left, float& top, float& right, float& bottom) const override;
-            ID2D1Geometry* GetD2DGeometry(ID2D1Factory* factory) const override;
-            void Update(float x, float y, float width, float height) override;
-            float Area() const override;
-            bool Intersects(const Geometry& other) const override;
+            void SetRadius(float r);            ///< Circle radius, keeping the center
+            void SetRadii(float rx, float ry);  ///< Rounded rect corner radii
 
-            void SetRadii(float rx, float ry);
+            float GetRadiusX() const { return radiusX; }
+            float GetRadiusY() const { return radiusY; }
+            uint32_t GetPathHandle() const { return pathHandle; }
 
         private:
-            float x, y, width, height;
-            float radiusX, radiusY;
-            mutable ComPtr<ID2D1RoundedRectangleGeometry> cachedGeometry;
-            mutable ID2D1Factory* cachedFactory = nullptr;
+            float x = 0.0f, y = 0.0f, width = 0.0f, height = 0.0f;
+            float radiusX = 0.0f, radiusY = 0.0f;
+            uint32_t pathHandle = 0;
+            GeometryKind kind = GeometryKind::None;
 
-            bool ContainsPointPrecise(float px, float py) const;
+            constexpr Geometry(const GeometryKind k, const float gx, const float gy, const float gw, const float gh)
+                : x(gx), y(gy), width(gw), height(gh), kind(k) {}
     };
 }
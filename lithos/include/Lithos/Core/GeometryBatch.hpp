@@ -0,0 +1,109 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Geometry.hpp"
+#include "Rect.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Structure-of-arrays store of rects, circles and rounded rects for bulk queries
+     *
+     * Every shape is kept as a center, half extents and corner radii, which turns all
+     * three kinds into one branchless test: a rect is a rounded rect with zero radii,
+     * a circle one whose radii equal its half extents. Queries evaluate four shapes
+     * per step with SSE2 where available and fall back to the same math in scalar code.
+     * Shape indices are assigned in insertion order.
+     */
+    class LITHOS_API GeometryBatch {
+    public:
+        uint32_t AddRect(const Rect& rect);
+        uint32_t AddCircle(float centerX, float centerY, float radius);
+        uint32_t AddRoundedRect(const Rect& rect, float radiusX, float radiusY);
+
+        /**
+         * @brief Adds a shape of any kind; paths and empty shapes are stored as their bounds
+         */
+        uint32_t Add(const Geometry& geometry);
+
+        /**
+         * @brief Replaces shape `index` with a rounded rect (zero radii = plain rect)
+         */
+        void SetRoundedRect(uint32_t index, const Rect& rect, float radiusX, float radiusY);
+
+        void Reserve(size_t count);
+        void Clear();
+
+        size_t Size() const { return count; }
+        Rect GetBounds(uint32_t index) const;
+
+        /**
+         * @brief Marks every shape containing the point
+         * @param mask Resized to Size(); 1 = hit
+         */
+        void ContainsPoint(float x, float y, std::vector<uint8_t>& mask) const;
+
+        /**
+         * @brief Indices of every shape containing the point, ascending
+         */
+        void ContainsPoint(float x, float y, std::vector<uint32_t>& indices) const;
+
+        /**
+         * @brief Marks every shape that overlaps the rect (exact for rounded corners)
+         */
+        void Intersects(const Rect& rect, std::vector<uint8_t>& mask) const;
+        void Intersects(const Rect& rect, std::vector<uint32_t>& indices) const;
+
+        /**
+         * @brief Marks every shape lying entirely inside the rect (e.g. rubber-band selection)
+         */
+        void ContainedIn(const Rect& rect, std::vector<uint8_t>& mask) const;
+        void ContainedIn(const Rect& rect, std::vector<uint32_t>& indices) const;
+
+    private:
+        enum class Query : uint8_t { Overlap, Enclosed };
+
+        // One lane per shape, padded to a multiple of four with shapes that never match
+        std::vector<float> centerX, centerY;
+        std::vector<float> halfW, halfH;        ///< Half extents of the bounds
+        std::vector<float> innerW, innerH;      ///< Half extents of the rect the corners are rounded around
+        std::vector<float> invRadiusX, invRadiusY;
+        size_t count = 0;
+
+        uint32_t Push();
+        void Store(uint32_t index, float cx, float cy, float hw, float hh, float rx, float ry);
+
+        /**
+         * Evaluates four shapes starting at `base`; returns one bit per shape
+         */
+        unsigned Evaluate4(size_t base, const Rect& query, Query kind) const;
+
+        template<typename Emit>
+        void Run(const Rect& query, Query kind, Emit&& emit) const;
+    };
+}
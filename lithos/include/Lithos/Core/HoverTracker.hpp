@@ -0,0 +1,95 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class Element;
+    class FlatTree;
+
+    struct HoverStats {
+        size_t cacheHits = 0;       ///< Lookups answered by revalidating the previous path
+        size_t cacheMisses = 0;     ///< Lookups that searched from the root
+        size_t enters = 0;          ///< MouseEnter notifications sent
+        size_t leaves = 0;          ///< MouseLeave notifications sent
+    };
+
+    /**
+     * @brief Remembers the root-to-target path under the pointer
+     *
+     * Before searching from the root, the previous path is revalidated: every link
+     * must still hold, the deepest element must still be hit, and no later sibling
+     * along the path may cover the point. For children laid out in order that check
+     * is a single bounds test per level. When the target changes, MouseLeave goes to
+     * the elements that dropped off the path (deepest first) and MouseEnter to the
+     * ones that joined it (outermost first).
+     */
+    class LITHOS_API HoverTracker {
+    public:
+        /**
+         * @brief Finds the element under the point and updates the hover path
+         * @param root Root of the tree; layout must be up to date
+         * @param flat Flat copy of root's tree used for lookups the cache can't answer; must be current
+         * @return Topmost element under the point, or nullptr
+         */
+        Element* Update(Element& root, float x, float y, const FlatTree* flat = nullptr);
+
+        /**
+         * @brief Sends MouseLeave to the whole current path (pointer left the window)
+         */
+        void Clear(float x, float y);
+
+        /**
+         * @brief Element under the pointer at the last update; nullptr once it has been destroyed
+         */
+        Element* GetTarget() const { return path.empty() || path.back().handle.expired() ? nullptr : path.back().element; }
+
+        const HoverStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    private:
+        struct PathEntry {
+            Element* element;
+            std::weak_ptr<Element> handle;  ///< Keeps leave notifications safe after removal
+            uint32_t index;                 ///< Position in the parent's children when recorded
+        };
+
+        std::vector<PathEntry> path;
+        std::vector<PathEntry> nextPath;
+        HoverStats stats;
+
+        /**
+         * @return Deepest element if the cached path still leads to the topmost hit, else nullptr
+         */
+        Element* Revalidate(const Element& root, float x, float y) const;
+
+        void Retarget(Element* target, float x, float y);
+    };
+}
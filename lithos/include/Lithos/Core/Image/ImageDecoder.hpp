@@ -0,0 +1,98 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief CPU pixels of a decoded image: premultiplied 0xAARRGGBB, row-major, no padding
+     *
+     * Same layout as Framebuffer. Immutable once published, so it is shared freely
+     * between threads, caches and display lists.
+     */
+    struct LITHOS_API DecodedImage {
+        int width = 0;
+        int height = 0;
+        int sourceWidth = 0;        ///< Size of the encoded image; width/height are what it was decoded at
+        int sourceHeight = 0;
+        std::vector<uint32_t> pixels;
+        uint64_t id = 0;            ///< Unique id, usable as a key by backend caches
+
+        size_t GetMemoryBytes() const { return sizeof(DecodedImage) + pixels.capacity() * sizeof(uint32_t); }
+
+        /**
+         * @brief Allocates zeroed pixels and assigns a fresh id
+         */
+        static std::shared_ptr<DecodedImage> Create(int width, int height);
+    };
+
+    /**
+     * @brief Decoder for one family of encoded image formats
+     *
+     * Decoders are shared by every decode job, so all calls may run concurrently on
+     * worker threads and must not touch shared mutable state.
+     */
+    class LITHOS_API ImageDecoder {
+    public:
+        /**
+         * @brief Picks the decoded size once the encoded size is known (e.g. ImageLoader::TargetSize)
+         */
+        using SizeFunction = std::function<void(int sourceWidth, int sourceHeight, int& width, int& height)>;
+
+        virtual ~ImageDecoder() = default;
+
+        /**
+         * @brief Whether data starts like a format this decoder reads (magic bytes)
+         */
+        virtual bool CanDecode(std::span<const uint8_t> data) const = 0;
+
+        /**
+         * @brief Reads the header, asks `size` for the output size and decodes straight to it,
+         *        scaling while decoding where the format allows; the data is parsed once
+         * @return nullptr on failure or an empty output size
+         */
+        virtual std::shared_ptr<DecodedImage> Decode(std::span<const uint8_t> data, const SizeFunction& size) const = 0;
+    };
+
+    /**
+     * @brief Reads binary PPM (P6) and PGM (P5) images with up to 8 bits per channel
+     *
+     * Needs no platform codec, so headless builds and tests can load images. Scaling
+     * down averages whole source pixels while streaming the rows, so memory stays at
+     * one output row of accumulators plus the output.
+     */
+    class LITHOS_API PpmDecoder final : public ImageDecoder {
+    public:
+        bool CanDecode(std::span<const uint8_t> data) const override;
+        std::shared_ptr<DecodedImage> Decode(std::span<const uint8_t> data, const SizeFunction& size) const override;
+    };
+}
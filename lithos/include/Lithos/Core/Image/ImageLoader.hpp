@@ -0,0 +1,205 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ImageDecoder.hpp"
+#include "../Rect.hpp"
+#include "../Render/ResourceCache.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class JobSystem;
+
+    enum class ImageFit : uint8_t {
+        Fill,       ///< Stretched to the box
+        Contain     ///< Largest size that fits the box with the image's aspect ratio, centered
+    };
+
+    /**
+     * @brief One decoded variant of an image: its source and the box it is shown in
+     */
+    struct ImageKey {
+        std::string source;
+        int width = 0;
+        int height = 0;
+        ImageFit fit = ImageFit::Fill;
+
+        bool operator==(const ImageKey&) const = default;
+    };
+
+    struct ImageKeyHash {
+        size_t operator()(const ImageKey& key) const {
+            size_t h = std::hash<std::string>{}(key.source);
+            h ^= (static_cast<size_t>(key.width) * 0x9E3779B1u + static_cast<size_t>(key.height)) + (h << 6) + (h >> 2);
+            return h ^ static_cast<size_t>(key.fit);
+        }
+    };
+
+    struct ImageLoaderStats {
+        uint64_t requests = 0;      ///< Load() calls
+        uint64_t cacheHits = 0;     ///< Answered from the decoded-image cache
+        uint64_t coalesced = 0;     ///< Joined a decode already in flight
+        uint64_t decodes = 0;       ///< Decode jobs started
+        uint64_t failures = 0;      ///< Jobs that produced no image (unreadable source, no decoder, bad data)
+        uint64_t delivered = 0;     ///< Callbacks run by Poll()
+    };
+
+    /**
+     * @brief Decodes images on a JobSystem and caches the results by byte budget
+     *
+     * Load() and Poll() belong to one thread (the UI thread). A miss starts a job that
+     * fetches the source bytes, picks the first registered decoder accepting them and
+     * decodes straight at the size the image will be shown at, never larger than the
+     * image itself. Finished jobs queue their result and call the wake handler; Poll()
+     * then caches the image and runs the callbacks on the owning thread. Requests for a
+     * key already being decoded share its job.
+     *
+     * The cache is least-recently-used over decoded bytes. Images still referenced (by
+     * elements or display lists) outlive their eviction.
+     */
+    class LITHOS_API ImageLoader {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Reads a source's encoded bytes; called on worker threads
+         */
+        using Fetcher = std::function<bool(const std::string& source, std::vector<uint8_t>& bytes)>;
+
+        /**
+         * @brief Receives the decoded image, or nullptr if it could not be loaded
+         */
+        using Callback = std::function<void(const std::shared_ptr<const DecodedImage>& image)>;
+
+        static constexpr size_t DefaultCacheBudget = 64 * 1024 * 1024;
+
+        /**
+         * @param jobs System decode jobs run on, with at least one worker; nullptr = JobSystem::Shared()
+         *
+         * A PpmDecoder is registered to begin with, and sources are read as file paths (UTF-8).
+         */
+        explicit ImageLoader(size_t cacheBudget = DefaultCacheBudget, JobSystem* jobs = nullptr);
+        ~ImageLoader();
+
+        ImageLoader(const ImageLoader&) = delete;
+        ImageLoader& operator=(const ImageLoader&) = delete;
+
+        /**
+         * @brief Adds a decoder, tried after the ones already registered; affects later loads
+         */
+        void AddDecoder(std::shared_ptr<const ImageDecoder> decoder);
+
+        /**
+         * @brief Replaces how sources are read (e.g. from memory or an archive); must be thread-safe
+         */
+        void SetFetcher(Fetcher fetcher);
+
+        /**
+         * @brief Called from the worker thread whenever a result is queued for Poll()
+         */
+        void SetWakeHandler(std::function<void()> handler);
+
+        /**
+         * @brief Cached image for key, or nullptr; never starts a decode
+         */
+        std::shared_ptr<const DecodedImage> Find(const ImageKey& key);
+
+        /**
+         * @brief Returns the cached image, or starts (or joins) a decode and returns nullptr
+         *
+         * On a miss, done runs from a later Poll(); on a hit it is not called.
+         */
+        std::shared_ptr<const DecodedImage> Load(const ImageKey& key, Callback done);
+
+        /**
+         * @brief Caches finished decodes and runs their callbacks
+         * @return Number of callbacks run
+         */
+        size_t Poll();
+
+        /**
+         * @brief Blocks until a result is queued for Poll() (headless drivers)
+         * @return false on timeout or if nothing is in flight
+         */
+        bool WaitForResults(Clock::duration timeout);
+
+        size_t GetInFlight() const { return inFlight.size(); }
+
+        void SetCacheBudget(size_t bytes) { cache.SetBudget(bytes); }
+        const ResourceCacheStats& GetCacheStats() const { return cache.GetStats(); }
+
+        const ImageLoaderStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+        /**
+         * @brief Decoded bytes held by the cache
+         */
+        size_t GetMemoryBytes() const { return cache.GetStats().cost; }
+
+        /**
+         * @brief Size a source of sourceWidth x sourceHeight is decoded at for key
+         */
+        static void TargetSize(int sourceWidth, int sourceHeight, const ImageKey& key, int& width, int& height);
+
+        /**
+         * @brief Where an image of the given aspect is drawn inside box
+         */
+        static Rect FitRect(const Rect& box, int imageWidth, int imageHeight, ImageFit fit);
+
+    private:
+        struct Completion {
+            ImageKey key;
+            std::shared_ptr<const DecodedImage> image;
+        };
+
+        /// Shared with running jobs, so the loader may go away before they finish
+        struct Mailbox {
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::vector<Completion> completions;
+            std::function<void()> wake;
+        };
+
+        JobSystem* jobs;
+        std::vector<std::shared_ptr<const ImageDecoder>> decoders;
+        Fetcher fetch;
+        std::shared_ptr<Mailbox> mailbox;
+
+        std::unordered_map<ImageKey, std::vector<Callback>, ImageKeyHash> inFlight;
+        std::vector<Completion> delivering;
+        ResourceCache<ImageKey, std::shared_ptr<const DecodedImage>, ImageKeyHash> cache;
+        ImageLoaderStats stats;
+    };
+}
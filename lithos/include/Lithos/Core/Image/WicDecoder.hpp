@@ -0,0 +1,41 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include "../../PCH.hpp"
+#include "ImageDecoder.hpp"
+
+#ifdef LITHOS_EXPORTS
+    #define LITHOS_API __declspec(dllexport)
+#else
+    #define LITHOS_API __declspec(dllimport)
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Decodes PNG, JPEG, GIF, BMP, TIFF and any other installed codec through WIC
+     *
+     * Register it after decoders for formats WIC doesn't know: it accepts any data and
+     * lets WIC pick the codec. Scaling happens in WIC before pixel conversion, which
+     * lets codecs that support it (JPEG) decode directly at a reduced size. Each call
+     * initializes COM on the calling thread for its own duration.
+     */
+    class LITHOS_API WicDecoder final : public ImageDecoder {
+    public:
+        bool CanDecode(std::span<const uint8_t> data) const override;
+        std::shared_ptr<DecodedImage> Decode(std::span<const uint8_t> data, const SizeFunction& size) const override;
+    };
+}
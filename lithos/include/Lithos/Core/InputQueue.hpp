@@ -0,0 +1,130 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <vector>
+#include "Event.hpp"
+#include "MemoryReport.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    struct InputQueueStats {
+        size_t received = 0;        ///< Raw events pushed
+        size_t dispatched = 0;      ///< Events delivered after coalescing
+        size_t frames = 0;          ///< Dispatch() calls that delivered anything
+        std::chrono::nanoseconds lastMaxDelay{0};   ///< Oldest event's wait at the last dispatch
+        std::chrono::nanoseconds maxDelay{0};       ///< Worst wait seen since the last ResetStats()
+    };
+
+    /**
+     * @brief Platform-neutral mouse input queue, drained once per frame
+     *
+     * The platform layer pushes events as they arrive; the frame loop calls Dispatch()
+     * once before layout. Runs of consecutive moves collapse into the latest move, runs
+     * of wheel events into one event carrying the summed delta; any other event ends a
+     * run, so ordering relative to button presses is preserved. Handlers also receive the
+     * raw events a delivered event stands for, for consumers that need every sample
+     * (e.g. inking or velocity tracking).
+     *
+     * A MouseLeave pushed by the platform means the pointer left the window.
+     */
+    class LITHOS_API InputQueue {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Queues an event; a default timestamp is replaced with Clock::now()
+         */
+        void Push(MouseEvent evt);
+
+        /**
+         * @brief Delivers everything queued so far
+         * @param handler Called as handler(const MouseEvent& event, std::span<const MouseEvent> history)
+         * @param now Frame time used for queueing-delay stats
+         * @return Number of events delivered
+         *
+         * Events pushed from inside the handler are kept for the next call.
+         */
+        template<typename Handler>
+        size_t Dispatch(Handler&& handler, Clock::time_point now = Clock::now());
+
+        bool Empty() const { return pending.empty(); }
+        size_t Pending() const { return pending.size(); }
+
+        size_t GetMemoryBytes() const { return CapacityBytes(pending) + CapacityBytes(draining); }
+
+        const InputQueueStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    private:
+        std::vector<MouseEvent> pending;
+        std::vector<MouseEvent> draining;
+        InputQueueStats stats;
+
+        static bool Coalesces(MouseEventType type) {
+            return type == MouseEventType::MouseMove || type == MouseEventType::MouseWheel;
+        }
+    };
+
+    template<typename Handler>
+    size_t InputQueue::Dispatch(Handler&& handler, const Clock::time_point now) {
+        if (pending.empty()) return 0;
+
+        // Swap so handlers can push without invalidating the run being delivered
+        draining.swap(pending);
+        pending.clear();
+
+        const auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(now - draining.front().timestamp);
+        stats.lastMaxDelay = delay;
+        stats.maxDelay = std::max(stats.maxDelay, delay);
+        stats.frames++;
+
+        size_t delivered = 0;
+        for (size_t first = 0; first < draining.size();) {
+            const MouseEventType type = draining[first].type;
+            size_t last = first + 1;
+            if (Coalesces(type)) {
+                while (last < draining.size() && draining[last].type == type) ++last;
+            }
+
+            MouseEvent merged = draining[last - 1];
+            if (type == MouseEventType::MouseWheel) {
+                merged.wheelDelta = 0;
+                for (size_t i = first; i < last; ++i) merged.wheelDelta += draining[i].wheelDelta;
+            }
+
+            handler(static_cast<const MouseEvent&>(merged), std::span<const MouseEvent>(draining.data() + first, last - first));
+            delivered++;
+            first = last;
+        }
+
+        stats.dispatched += delivered;
+        draining.clear();
+        return delivered;
+    }
+}
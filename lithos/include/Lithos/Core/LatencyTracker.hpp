@@ -0,0 +1,143 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MemoryReport.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Timestamps of one produced frame and the input it consumed
+     */
+    struct FrameTiming {
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        uint64_t frame = 0;         ///< Sequence number, starting at 1
+        TimePoint begin{};          ///< Frame started (before input dispatch)
+        TimePoint dispatched{};     ///< Input delivered
+        TimePoint laidOut{};        ///< Layout done
+        TimePoint painted{};        ///< Recording and replay done
+        TimePoint presented{};      ///< Present returned
+        size_t inputs = 0;          ///< Raw input events consumed, before coalescing
+        TimePoint oldestInput{};    ///< Arrival of the oldest consumed input; default if none
+        TimePoint newestInput{};
+
+        /**
+         * @brief Arrival of the oldest consumed input to present; zero for frames without input
+         */
+        std::chrono::nanoseconds InputLatency() const {
+            return inputs ? presented - oldestInput : std::chrono::nanoseconds{0};
+        }
+
+        std::chrono::nanoseconds Duration() const { return presented - begin; }
+    };
+
+    /**
+     * @brief Distribution of a latency sample window
+     */
+    struct LatencySummary {
+        size_t samples = 0;
+        std::chrono::nanoseconds mean{0};
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p90{0};
+        std::chrono::nanoseconds p99{0};
+        std::chrono::nanoseconds max{0};
+    };
+
+    /**
+     * @brief Records input-to-present latency per frame
+     *
+     * The frame loop calls the Mark* functions in order, once per frame; InputConsumed()
+     * is called for every raw event the frame delivered, with its arrival stamp. Every
+     * consumed event contributes one sample (arrival to present) and every frame one
+     * duration sample, kept in rings of the last `capacity` entries. All times are
+     * passed in, so headless drivers can use a synthetic clock.
+     */
+    class LITHOS_API LatencyTracker {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit LatencyTracker(size_t capacity = 1024);
+
+        void BeginFrame(Clock::time_point now);
+        void InputConsumed(Clock::time_point arrival);
+        void MarkDispatched(Clock::time_point now);
+        void MarkLaidOut(Clock::time_point now);
+        void MarkPainted(Clock::time_point now);
+
+        /**
+         * @brief Completes the frame and records its samples
+         */
+        void MarkPresented(Clock::time_point now);
+
+        /**
+         * @brief Last completed frame; default-constructed before the first
+         */
+        const FrameTiming& GetLastFrame() const { return lastFrame; }
+
+        /**
+         * @brief Retained frames, oldest first
+         */
+        void GetFrames(std::vector<FrameTiming>& out) const;
+
+        /**
+         * @brief Arrival-to-present latency over the retained input samples
+         */
+        LatencySummary GetInputLatency() const;
+
+        /**
+         * @brief Begin-to-present duration over the retained frames
+         */
+        LatencySummary GetFrameDuration() const;
+
+        void Reset();
+
+        size_t GetMemoryBytes() const {
+            return CapacityBytes(pendingInputs) + CapacityBytes(frames) + CapacityBytes(inputLatency) + CapacityBytes(scratch);
+        }
+
+    private:
+        size_t capacity;
+        FrameTiming current;
+        FrameTiming lastFrame;
+        uint64_t frameCount = 0;
+
+        std::vector<Clock::time_point> pendingInputs;   ///< Arrivals consumed by the current frame
+
+        // Rings; next* is the slot written next
+        std::vector<FrameTiming> frames;
+        size_t nextFrame = 0;
+        std::vector<std::chrono::nanoseconds> inputLatency;
+        size_t nextInput = 0;
+
+        mutable std::vector<std::chrono::nanoseconds> scratch;
+
+        LatencySummary Summarize(std::vector<std::chrono::nanoseconds>& samples) const;
+    };
+}
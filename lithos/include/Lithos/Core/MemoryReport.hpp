@@ -0,0 +1,100 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Lithos {
+    enum class MemoryCategory : uint8_t {
+        Elements,       ///< Element objects, minus style and geometry, plus shared_ptr control blocks
+        Styles,
+        Geometry,
+        Children,       ///< Child arrays
+        Listeners,
+        Layout,         ///< Per-element hit-test and culling indexes (child reach, spatial grids)
+        Animation,      ///< Animation state held outside the element objects
+        Text,           ///< Text storage and layout caches
+        Images,         ///< Decoded images held by the image cache
+        RenderCaches,   ///< Brushes, shadow masks, shadow bitmaps and image bitmaps
+        FrameData,      ///< Display list, flat tree, culling, input, task and timing buffers
+        PoolSlack,      ///< Reserved by the element pool but not handed out
+        Count
+    };
+
+    /**
+     * @brief Name of a category, for metric keys
+     */
+    constexpr const char* ToString(const MemoryCategory category) {
+        constexpr const char* names[] = {
+            "elements", "styles", "geometry", "children", "listeners", "layout",
+            "animation", "text", "images", "render_caches", "frame_data", "pool_slack"
+        };
+        return category < MemoryCategory::Count ? names[static_cast<size_t>(category)] : "unknown";
+    }
+
+    /**
+     * @brief Heap bytes a vector holds, by capacity
+     */
+    template<typename T>
+    size_t CapacityBytes(const std::vector<T>& v) {
+        return v.capacity() * sizeof(T);
+    }
+
+    /**
+     * @brief Bytes by category from a full walk (Window::GetMemoryReport)
+     *
+     * Sizes come from object sizes and container capacities. Allocator headers and
+     * driver-side memory are not visible, so GPU objects are estimated.
+     */
+    struct MemoryReport {
+        std::array<size_t, static_cast<size_t>(MemoryCategory::Count)> bytes{};
+        size_t elements = 0;
+
+        void Add(const MemoryCategory category, const size_t n) { bytes[static_cast<size_t>(category)] += n; }
+        size_t Get(const MemoryCategory category) const { return bytes[static_cast<size_t>(category)]; }
+
+        size_t Total() const {
+            size_t total = 0;
+            for (const size_t b : bytes) total += b;
+            return total;
+        }
+    };
+
+    /**
+     * @brief Running totals a window keeps as elements attach and detach; O(1) to read
+     *
+     * Meant to be sampled every frame as a production metric. Element bytes cover
+     * object sizes only; containers owned by elements show up in MemoryReport alone.
+     */
+    struct MemoryTotals {
+        size_t elements = 0;            ///< Elements attached to the window
+        size_t elementBytes = 0;        ///< Their object sizes, style and geometry included
+        size_t poolReserved = 0;        ///< Element pool chunks
+        size_t poolInUse = 0;
+        size_t images = 0;              ///< Decoded-image cache
+        size_t renderCaches = 0;
+        size_t frameData = 0;
+
+        /**
+         * @brief Pool reserve (or element bytes, if elements were made outside the pool) plus caches and frame data
+         */
+        size_t Total() const { return std::max(poolReserved, elementBytes) + images + renderCaches + frameData; }
+    };
+}
@@ -0,0 +1,136 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Element.hpp"
+
+namespace Lithos {
+    struct Node;
+    using NodeRef = std::shared_ptr<const Node>;
+
+    /**
+     * @brief Immutable description of one element and its subtree
+     *
+     * Descriptions are shared, not copied: an unchanged subtree should be passed again
+     * as the same NodeRef, which lets the reconciler skip it with one pointer compare.
+     */
+    struct Node {
+        using Factory = std::shared_ptr<Element> (*)(ElementPool* pool);
+
+        std::string key;                ///< Identity among siblings; empty = matched by position
+        Factory create = nullptr;       ///< Also the node's type: elements are only reused by nodes with the same factory
+        Style style;
+        bool visible = true;
+        std::vector<NodeRef> children;
+        std::function<void(Element&)> mount;    ///< Runs once when the element is created (listeners, subclass state)
+    };
+
+    /**
+     * @brief Describes an element of type T
+     * @return Mutable until shared; set Node::mount here if needed
+     */
+    template<typename T = Element>
+    std::shared_ptr<Node> Describe(std::string key, const Style& style, std::vector<NodeRef> children = {}) {
+        static_assert(std::is_base_of_v<Element, T>);
+        auto node = std::make_shared<Node>();
+        node->key = std::move(key);
+        node->create = [](ElementPool* pool) -> std::shared_ptr<Element> { return Element::Make<T>(pool); };
+        node->style = style;
+        node->children = std::move(children);
+        return node;
+    }
+
+    struct ReconcileStats {
+        size_t visited = 0;         ///< Nodes compared against an element
+        size_t skipped = 0;         ///< Subtrees skipped because their node was unchanged
+        size_t created = 0;
+        size_t reused = 0;          ///< Existing elements matched to a changed node
+        size_t moved = 0;
+        size_t removed = 0;
+        size_t layoutInvalidations = 0;
+        size_t paintInvalidations = 0;
+    };
+
+    /**
+     * @brief Brings an element tree in line with a description, reusing elements
+     *
+     * Children are matched by key (or by position when unkeyed) and type, so matched
+     * elements keep their cached brushes, geometry, listeners and running animations.
+     * Only Style fields that differ between the old and new node are written. That
+     * leaves state set imperatively on untouched fields alone and costs one
+     * InvalidateLayout() or RequestRepaint() per element that really changed. Siblings
+     * are first walked in step; keyed lookup starts at the first mismatch, and
+     * reordering uses Element::MoveChild(), so edits near one row stay near one row.
+     *
+     * The reconciler owns every child of the element it is given: children it did not
+     * create are removed.
+     */
+    class LITHOS_API Reconciler {
+    public:
+        /**
+         * @brief Makes parent's children match `children`
+         */
+        void Reconcile(Element& parent, const std::vector<NodeRef>& children);
+
+        /**
+         * @brief Makes element and its subtree match node; element must have node's type
+         */
+        void Update(Element& element, const NodeRef& node);
+
+        const ReconcileStats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+    private:
+        struct SlotKey {
+            std::string_view key;
+            size_t index;           ///< Position among siblings, for unkeyed nodes only
+
+            bool operator==(const SlotKey&) const = default;
+        };
+
+        struct SlotHash {
+            size_t operator()(const SlotKey& k) const {
+                return k.key.empty() ? std::hash<size_t>{}(k.index) : std::hash<std::string_view>{}(k.key);
+            }
+        };
+
+        ReconcileStats stats;
+
+        // Scratch for the keyed phase, reused across calls
+        struct Match {
+            Element* element;
+            size_t oldIndex;
+        };
+        std::unordered_map<SlotKey, Match, SlotHash> existing;
+
+        void ReconcileKeyed(Element& parent, Element* first, const std::vector<NodeRef>& nodes, size_t begin);
+        void ApplyStyle(Element& element, const Node* previous, const Node& node);
+        std::shared_ptr<Element> Create(Element& parent, const NodeRef& node);
+        void Remove(Element& parent, Element& child);
+
+        static bool Matches(const Element& element, const Node& node);
+        static SlotKey SlotOf(const Node& node, size_t index) {
+            return {node.key, node.key.empty() ? index : 0};
+        }
+    };
+}
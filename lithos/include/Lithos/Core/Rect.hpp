@@ -0,0 +1,79 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <algorithm>
+
+namespace Lithos {
+    /**
+     * @brief Axis-aligned rectangle stored as edges (right/bottom exclusive for pixel work)
+     */
+    struct Rect {
+        float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+
+        constexpr Rect() = default;
+
+        constexpr Rect(const float l, const float t, const float r, const float b)
+            : left(l), top(t), right(r), bottom(b) {}
+
+        static constexpr Rect FromXYWH(const float x, const float y, const float w, const float h) {
+            return {x, y, x + w, y + h};
+        }
+
+        constexpr float Width() const { return right - left; }
+        constexpr float Height() const { return bottom - top; }
+
+        constexpr bool IsEmpty() const { return right <= left || bottom <= top; }
+
+        constexpr bool Contains(const float x, const float y) const {
+            return x >= left && x <= right && y >= top && y <= bottom;
+        }
+
+        /**
+         * @brief True if this rect fully covers the other
+         */
+        constexpr bool Contains(const Rect& o) const {
+            return o.left >= left && o.right <= right && o.top >= top && o.bottom <= bottom;
+        }
+
+        constexpr bool Intersects(const Rect& o) const {
+            return left < o.right && o.left < right && top < o.bottom && o.top < bottom;
+        }
+
+        constexpr Rect Intersect(const Rect& o) const {
+            return {std::max(left, o.left), std::max(top, o.top), std::min(right, o.right), std::min(bottom, o.bottom)};
+        }
+
+        /**
+         * @brief Smallest rect containing both (an empty operand is ignored)
+         */
+        constexpr Rect Union(const Rect& o) const {
+            if (IsEmpty()) return o;
+            if (o.IsEmpty()) return *this;
+            return {std::min(left, o.left), std::min(top, o.top), std::max(right, o.right), std::max(bottom, o.bottom)};
+        }
+
+        constexpr Rect Inflate(const float dx, const float dy) const {
+            return {left - dx, top - dy, right + dx, bottom + dy};
+        }
+
+        constexpr Rect Offset(const float dx, const float dy) const {
+            return {left + dx, top + dy, right + dx, bottom + dy};
+        }
+
+        constexpr bool operator==(const Rect&) const = default;
+    };
+}
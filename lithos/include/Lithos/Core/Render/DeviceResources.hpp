@@ -0,0 +1,164 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include "../../PCH.hpp"
+#include "../Color.hpp"
+#include "../Geometry.hpp"
+#include "DisplayList.hpp"
+#include "ResourceCache.hpp"
+#include "ShadowCache.hpp"
+
+#ifdef LITHOS_EXPORTS
+    #define LITHOS_API __declspec(dllexport)
+#else
+    #define LITHOS_API __declspec(dllimport)
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Direct2D resources shared by every element of a window
+     *
+     * Brushes are deduplicated by color, so any number of identically colored
+     * elements share one brush; colors that are mid-transition go through a single
+     * mutable brush instead of filling the cache with one-frame entries. Shadow
+     * masks and the device bitmaps uploaded from them are cached the same way, as
+     * are the bitmaps decoded images are uploaded to.
+     * Device-dependent objects are dropped whenever a different device context is seen;
+     * DirectWrite text formats are device-independent and survive that.
+     */
+    class LITHOS_API DeviceResources {
+    public:
+        DeviceResources();
+
+        DeviceResources(const DeviceResources&) = delete;
+        DeviceResources& operator=(const DeviceResources&) = delete;
+
+        /**
+         * @brief Draws a blurred rounded-rectangle shadow using a cached nine-slice mask
+         * @param rt Device context to draw into
+         * @param x Left edge of the shadow-casting shape (offset already applied)
+         * @param y Top edge of the shadow-casting shape
+         * @param w Shape width
+         * @param h Shape height
+         * @param radius Corner radius
+         * @param blur Blur radius
+         * @param color Shadow color (opacity already applied)
+         * @param animatedColor True while the color is mid-transition
+         */
+        void DrawShadow(ID2D1DeviceContext* rt, float x, float y, float w, float h,
+                        float radius, float blur, const Color& color, bool animatedColor = false);
+
+        /**
+         * @brief Draws a display list in painter's order
+         * @param rt Device context to draw into
+         * @param list Recorded commands
+         * @param culled Optional per-command skip mask (e.g. from OcclusionCuller), empty to draw everything
+         */
+        void Replay(ID2D1DeviceContext* rt, const DisplayList& list, const std::vector<uint8_t>& culled = {});
+
+        /**
+         * @brief Returns a shared brush for a static color
+         * @return Brush owned by the cache; valid until evicted by a later call
+         */
+        ID2D1SolidColorBrush* GetSolidBrush(ID2D1DeviceContext* rt, const Color& color);
+
+        /**
+         * @brief Returns the single mutable brush recolored for an animating color
+         *
+         * The brush is reused by every caller, so it must be consumed before the next call.
+         */
+        ID2D1SolidColorBrush* GetAnimatedBrush(ID2D1DeviceContext* rt, const Color& color);
+
+        /**
+         * @brief Stores a path so elements can refer to it with Geometry::MakePath
+         * @return Handle, never 0
+         */
+        uint32_t RegisterPath(ComPtr<ID2D1Geometry> path);
+
+        void ReleasePath(uint32_t handle);
+
+        /**
+         * @brief Direct2D geometry for a shape, for callers that need one (clipping, outlines)
+         *
+         * Paths return their registered object. Other kinds are built on request and not
+         * cached; plain fills should use the device context's rectangle/ellipse calls instead.
+         */
+        ComPtr<ID2D1Geometry> GetD2DGeometry(ID2D1Factory* factory, const Geometry& geometry) const;
+
+        /**
+         * @brief Shared non-wrapping text format for a font family and size
+         * @return Format owned by the cache, or nullptr if DirectWrite is unavailable
+         */
+        IDWriteTextFormat* GetTextFormat(std::wstring_view family, float fontSize);
+
+        /**
+         * @brief Advance width of one line of text, including trailing whitespace
+         */
+        float MeasureText(std::wstring_view text, std::wstring_view family, float fontSize);
+
+        /**
+         * @brief Limits the number of distinct cached brushes
+         */
+        void SetBrushBudget(size_t count) { brushes.SetBudget(count); }
+
+        const ResourceCacheStats& GetBrushStats() const { return brushes.GetStats(); }
+        const ResourceCacheStats& GetShadowBitmapStats() const { return shadowBitmaps.GetStats(); }
+
+        /**
+         * @brief Limits the bytes of uploaded image bitmaps
+         */
+        void SetImageBitmapBudget(size_t bytes) { imageBitmaps.SetBudget(bytes); }
+        const ResourceCacheStats& GetImageBitmapStats() const { return imageBitmaps.GetStats(); }
+
+        ShadowCache& GetShadowCache() { return shadowCache; }
+
+        /**
+         * @brief Bytes held by the caches; brushes are a per-object estimate
+         */
+        size_t GetMemoryBytes() const;
+
+        /**
+         * @brief Releases all device-dependent resources (e.g. after device loss)
+         */
+        void ReleaseDeviceResources();
+
+    private:
+        ShadowCache shadowCache;
+
+        ID2D1DeviceContext* cachedContext = nullptr;
+        ResourceCache<uint32_t, ComPtr<ID2D1SolidColorBrush>> brushes;
+        ResourceCache<uint64_t, ComPtr<ID2D1Bitmap>> shadowBitmaps;   ///< Keyed by ShadowMask::id
+        ResourceCache<uint64_t, ComPtr<ID2D1Bitmap>> imageBitmaps;    ///< Keyed by DecodedImage::id
+        ComPtr<ID2D1SolidColorBrush> animatedBrush;
+
+        std::vector<ComPtr<ID2D1Geometry>> paths;   ///< Device-independent; index = handle - 1
+        std::vector<uint32_t> freePaths;
+
+        struct TextFormatEntry {
+            std::wstring family;
+            float fontSize;
+            ComPtr<IDWriteTextFormat> format;
+        };
+
+        ComPtr<IDWriteFactory> writeFactory;
+        std::vector<TextFormatEntry> textFormats;   ///< Few families and sizes per window; searched linearly
+
+        void BindContext(ID2D1DeviceContext* rt);
+        ID2D1Bitmap* GetShadowBitmap(ID2D1DeviceContext* rt, const ShadowMask& mask);
+        ID2D1Bitmap* GetImageBitmap(ID2D1DeviceContext* rt, const DecodedImage& image);
+    };
+}
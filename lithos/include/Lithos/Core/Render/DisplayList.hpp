@@ -0,0 +1,289 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../Color.hpp"
+#include "../MemoryReport.hpp"
+#include "../Rect.hpp"
+#include "../Image/ImageDecoder.hpp"
+
+namespace Lithos {
+    enum class DrawCommandType : uint8_t {
+        FillRect,           ///< Solid rectangle (radius ignored)
+        FillRoundedRect,    ///< Solid rounded rectangle
+        StrokeRect,         ///< Border drawn inside rect, `param` = stroke width
+        Shadow,             ///< Blurred rounded-rect shadow, `param` = blur radius
+        Text,               ///< Single line clipped to rect, `param` = font size (see DisplayList::GetText)
+        Image               ///< Bitmap stretched to rect, `color.a` = opacity (see DisplayList::GetImage)
+    };
+
+    /// Clip of commands recorded outside any PushClip()
+    inline constexpr Rect Unclipped{
+        -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()
+    };
+
+    namespace DrawCommandFlags {
+        inline constexpr uint8_t AnimatedColor = 1 << 0;   ///< Color changes every frame; don't cache resources for it
+    }
+
+    /**
+     * @brief One recorded drawing operation in window coordinates
+     */
+    struct DrawCommand {
+        DrawCommandType type;
+        Rect rect;          ///< Shape rectangle
+        Rect bounds;        ///< Conservative pixel coverage (shape plus blur/antialiasing), within clip
+        float radius = 0.0f;
+        float param = 0.0f;
+        Color color;        ///< Straight (non-premultiplied) color, opacity already applied
+        uint8_t flags = 0;
+        uint32_t group = 0; ///< Element that recorded the command (see DisplayList::BeginGroup)
+        Rect clip = Unclipped;  ///< Pixel-aligned scissor; nothing outside it is touched
+        uint32_t payload = 0;   ///< Text and Image commands: index into the list's out-of-line storage
+    };
+
+    /**
+     * @brief Characters and font of one Text command, stored out of line
+     */
+    struct TextRun {
+        size_t offset;      ///< Into the list's character storage
+        size_t length;
+        uint32_t font;      ///< Index of the font family name
+    };
+
+    /**
+     * @brief Flat, backend-neutral list of draw commands in painter's order
+     *
+     * Elements record into a display list; software and hardware backends replay it.
+     * Scroll containers push a clip and a translation around their children; both are
+     * resolved while recording, so every command carries its final window-space rect
+     * and scissor, and backends never track nesting.
+     */
+    class DisplayList {
+    public:
+        /**
+         * @brief Starts attributing subsequent commands to a new element
+         * @return Group id of the new element
+         */
+        uint32_t BeginGroup() { return ++currentGroup; }
+
+        uint32_t GroupCount() const { return currentGroup; }
+
+        void FillRect(const Rect& rect, const Color& color, const uint8_t flags = 0) {
+            Push({DrawCommandType::FillRect, rect, rect.Inflate(1.0f, 1.0f), 0.0f, 0.0f, color, flags});
+        }
+
+        void FillRoundedRect(const Rect& rect, const float radius, const Color& color, const uint8_t flags = 0) {
+            if (radius <= 0.0f) {
+                FillRect(rect, color, flags);
+                return;
+            }
+            Push({DrawCommandType::FillRoundedRect, rect, rect.Inflate(1.0f, 1.0f), radius, 0.0f, color, flags});
+        }
+
+        void StrokeRect(const Rect& rect, const float radius, const float width, const Color& color, const uint8_t flags = 0) {
+            Push({DrawCommandType::StrokeRect, rect, rect.Inflate(1.0f, 1.0f), radius, width, color, flags});
+        }
+
+        void Shadow(const Rect& rect, const float radius, const float blur, const Color& color, const uint8_t flags = 0) {
+            // Triple box blur support is ~1.5 * blur; pad generously
+            const float pad = blur * 2.0f + 2.0f;
+            Push({DrawCommandType::Shadow, rect, rect.Inflate(pad, pad), radius, blur, color, flags});
+        }
+
+        /**
+         * @brief Draws one line of text at the top left of rect, clipped to rect
+         *
+         * The characters are copied into the list, so the source may change after recording.
+         */
+        void Text(const Rect& rect, const std::wstring_view text, const std::wstring_view family, const float fontSize,
+                  const Color& color, const uint8_t flags = 0) {
+            if (text.empty() || fontSize <= 0.0f) return;
+
+            DrawCommand cmd{DrawCommandType::Text, rect, rect.Inflate(1.0f, 1.0f), 0.0f, fontSize, color, flags};
+            cmd.payload = static_cast<uint32_t>(textRuns.size());
+            if (!Push(cmd)) return;
+
+            textRuns.push_back({textData.size(), text.size(), InternFont(family)});
+            textData.append(text);
+        }
+
+        /**
+         * @brief Draws a decoded image stretched to rect
+         *
+         * The list keeps a reference, so the image stays alive until the list is cleared.
+         */
+        void Image(const Rect& rect, std::shared_ptr<const DecodedImage> image, const float opacity = 1.0f,
+                   const uint8_t flags = 0) {
+            if (!image || image->width <= 0 || image->height <= 0 || opacity <= 0.0f) return;
+
+            DrawCommand cmd{DrawCommandType::Image, rect, rect.Inflate(1.0f, 1.0f), 0.0f, 0.0f,
+                            Color{1.0f, 1.0f, 1.0f, opacity}, flags};
+            cmd.payload = static_cast<uint32_t>(images.size());
+            if (!Push(cmd)) return;
+
+            images.push_back(std::move(image));
+        }
+
+        /**
+         * @brief Copies other's commands after the current ones, as already-resolved output
+         *
+         * The current clip and translation don't apply; other's groups are renumbered to
+         * follow this list's.
+         */
+        void Append(const DisplayList& other) {
+            const size_t first = commands.size();
+            const auto runBase = static_cast<uint32_t>(textRuns.size());
+            const auto imageBase = static_cast<uint32_t>(images.size());
+            commands.insert(commands.end(), other.commands.begin(), other.commands.end());
+            for (size_t i = first; i < commands.size(); ++i) {
+                DrawCommand& cmd = commands[i];
+                cmd.group += currentGroup;
+                if (cmd.type == DrawCommandType::Text) cmd.payload += runBase;
+                if (cmd.type == DrawCommandType::Image) cmd.payload += imageBase;
+            }
+            images.insert(images.end(), other.images.begin(), other.images.end());
+
+            for (const TextRun& run : other.textRuns) {
+                textRuns.push_back({textData.size() + run.offset, run.length, InternFont(other.fonts[run.font])});
+            }
+            textData.append(other.textData);
+            currentGroup += other.currentGroup;
+        }
+
+        /**
+         * @brief Restricts subsequent commands to rect (in the current translation),
+         *        intersected with the enclosing clip
+         *
+         * Edges are rounded to whole pixels so every backend clips identically.
+         */
+        void PushClip(const Rect& rect) {
+            clipStack.push_back(clip);
+            const Rect r = rect.Offset(offsetX, offsetY);
+            clip = clip.Intersect({std::round(r.left), std::round(r.top), std::round(r.right), std::round(r.bottom)});
+        }
+
+        void PopClip() {
+            clip = clipStack.back();
+            clipStack.pop_back();
+        }
+
+        /**
+         * @brief Offsets subsequent commands by (dx, dy), on top of the enclosing translation
+         */
+        void PushTranslation(const float dx, const float dy) {
+            offsetStack.push_back({offsetX, offsetY});
+            offsetX += dx;
+            offsetY += dy;
+        }
+
+        void PopTranslation() {
+            offsetX = offsetStack.back().first;
+            offsetY = offsetStack.back().second;
+            offsetStack.pop_back();
+        }
+
+        const Rect& CurrentClip() const { return clip; }
+        std::pair<float, float> CurrentTranslation() const { return {offsetX, offsetY}; }
+
+        std::wstring_view GetText(const DrawCommand& cmd) const {
+            const TextRun& run = textRuns[cmd.payload];
+            return std::wstring_view(textData).substr(run.offset, run.length);
+        }
+
+        const std::wstring& GetFont(const DrawCommand& cmd) const { return fonts[textRuns[cmd.payload].font]; }
+
+        const DecodedImage& GetImage(const DrawCommand& cmd) const { return *images[cmd.payload]; }
+
+        void Clear() {
+            commands.clear();
+            textRuns.clear();
+            textData.clear();
+            images.clear();
+            currentGroup = 0;
+            clip = Unclipped;
+            clipStack.clear();
+            offsetX = offsetY = 0.0f;
+            offsetStack.clear();
+        }
+        void Reserve(const size_t n) { commands.reserve(n); }
+
+        const std::vector<DrawCommand>& Commands() const { return commands; }
+        size_t Size() const { return commands.size(); }
+
+        size_t GetMemoryBytes() const {
+            size_t bytes = CapacityBytes(commands) + CapacityBytes(clipStack) + CapacityBytes(offsetStack) +
+                           CapacityBytes(textRuns) + CapacityBytes(fonts) + textData.capacity() * sizeof(wchar_t) +
+                           CapacityBytes(images);
+            for (const auto& font : fonts) bytes += font.capacity() * sizeof(wchar_t);
+            return bytes;
+        }
+        bool Empty() const { return commands.empty(); }
+
+    private:
+        std::vector<DrawCommand> commands;
+        uint32_t currentGroup = 0;
+
+        Rect clip = Unclipped;
+        std::vector<Rect> clipStack;
+        float offsetX = 0.0f, offsetY = 0.0f;
+        std::vector<std::pair<float, float>> offsetStack;
+
+        std::vector<TextRun> textRuns;
+        std::wstring textData;
+        std::vector<std::wstring> fonts;    ///< Kept across Clear(); a window uses few families
+
+        std::vector<std::shared_ptr<const DecodedImage>> images;
+
+        uint32_t InternFont(const std::wstring_view family) {
+            for (size_t i = 0; i < fonts.size(); ++i) {
+                if (fonts[i] == family) return static_cast<uint32_t>(i);
+            }
+            fonts.emplace_back(family);
+            return static_cast<uint32_t>(fonts.size() - 1);
+        }
+
+        /**
+         * @return False if the command was dropped (invisible or clipped away)
+         */
+        bool Push(DrawCommand cmd) {
+            if (cmd.color.a <= 0.0f || cmd.rect.IsEmpty()) return false;
+
+            if (offsetX != 0.0f || offsetY != 0.0f) {
+                cmd.rect = cmd.rect.Offset(offsetX, offsetY);
+                cmd.bounds = cmd.bounds.Offset(offsetX, offsetY);
+            }
+            if (clip != Unclipped) {
+                cmd.bounds = cmd.bounds.Intersect(clip);
+                if (cmd.bounds.IsEmpty()) return false;
+                cmd.clip = clip;
+            }
+
+            cmd.group = currentGroup;
+            commands.push_back(cmd);
+            return true;
+        }
+    };
+}
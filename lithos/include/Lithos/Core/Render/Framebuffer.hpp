@@ -0,0 +1,91 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "../Rect.hpp"
+
+namespace Lithos {
+    /**
+     * @brief CPU render target: premultiplied 0xAARRGGBB pixels, row-major, no padding
+     */
+    struct Framebuffer {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+
+        Framebuffer() = default;
+
+        Framebuffer(const int w, const int h)
+            : width(w), height(h), pixels(static_cast<size_t>(w) * static_cast<size_t>(h), 0u) {}
+
+        void Resize(const int w, const int h) {
+            width = w;
+            height = h;
+            pixels.assign(static_cast<size_t>(w) * static_cast<size_t>(h), 0u);
+        }
+
+        uint32_t* Row(const int y) { return pixels.data() + static_cast<size_t>(y) * width; }
+        const uint32_t* Row(const int y) const { return pixels.data() + static_cast<size_t>(y) * width; }
+
+        /**
+         * @brief Shifts the pixels inside area by (dx, dy), reusing the last frame for a scroll
+         * @param area Region to shift, snapped to whole pixels and clamped to the framebuffer
+         * @param exposed Receives up to two strips whose content is stale and must be repainted
+         * @return Number of rects written to exposed
+         */
+        int Scroll(const Rect& area, const int dx, const int dy, Rect exposed[2]) {
+            const int x0 = std::max(0, static_cast<int>(std::round(area.left)));
+            const int y0 = std::max(0, static_cast<int>(std::round(area.top)));
+            const int x1 = std::min(width, static_cast<int>(std::round(area.right)));
+            const int y1 = std::min(height, static_cast<int>(std::round(area.bottom)));
+            if (x0 >= x1 || y0 >= y1) return 0;
+
+            const auto r = [](const int l, const int t, const int rr, const int b) {
+                return Rect{static_cast<float>(l), static_cast<float>(t), static_cast<float>(rr), static_cast<float>(b)};
+            };
+
+            const int w = x1 - x0 - std::abs(dx);
+            const int h = y1 - y0 - std::abs(dy);
+            if (w <= 0 || h <= 0) {
+                exposed[0] = r(x0, y0, x1, y1);
+                return 1;
+            }
+
+            // Copy rows in the order that never reads an already overwritten one
+            const int srcX = dx > 0 ? x0 : x0 - dx;
+            const int dstX = dx > 0 ? x0 + dx : x0;
+            for (int i = 0; i < h; ++i) {
+                const int row = dy > 0 ? h - 1 - i : i;
+                const int srcY = (dy > 0 ? y0 : y0 - dy) + row;
+                std::memmove(Row(srcY + dy) + dstX, Row(srcY) + srcX, static_cast<size_t>(w) * sizeof(uint32_t));
+            }
+
+            int count = 0;
+            if (dy > 0) exposed[count++] = r(x0, y0, x1, y0 + dy);
+            if (dy < 0) exposed[count++] = r(x0, y1 + dy, x1, y1);
+            const int top = dy > 0 ? y0 + dy : y0;
+            const int bottom = dy < 0 ? y1 + dy : y1;
+            if (dx > 0) exposed[count++] = r(x0, top, x0 + dx, bottom);
+            if (dx < 0) exposed[count++] = r(x1 + dx, top, x1, bottom);
+            return count;
+        }
+    };
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DisplayList.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Per-frame occlusion results
+     */
+    struct OcclusionStats {
+        size_t commandsCulled = 0;      ///< Commands hidden behind later opaque fills
+        size_t elementsCulled = 0;      ///< Elements whose every command was hidden
+        size_t occluders = 0;           ///< Opaque rects tracked at the end of the pass
+    };
+
+    /**
+     * @brief Front-to-back occlusion pass over a display list
+     *
+     * Walks commands from last (front) to first (back), collecting the pixel-aligned
+     * opaque interiors of fully opaque fills. A command whose bounds lie entirely
+     * inside one collected occluder is flagged as culled.
+     */
+    class LITHOS_API OcclusionCuller {
+    public:
+        /**
+         * @param maxOccluders Occluders kept at once; the smallest are replaced first
+         */
+        explicit OcclusionCuller(size_t maxOccluders = 32);
+
+        /**
+         * @brief Flags hidden commands
+         * @return One entry per command, non-zero = culled; valid until the next call
+         */
+        const std::vector<uint8_t>& Cull(const DisplayList& list);
+
+        const OcclusionStats& GetStats() const { return stats; }
+
+        size_t GetMemoryBytes() const {
+            return CapacityBytes(occluders) + CapacityBytes(culled) + CapacityBytes(groupState);
+        }
+
+        /**
+         * @brief Pixel-aligned region a command paints with full opacity
+         * @param cmd Command to inspect
+         * @param out Receives the opaque rect (integral edges)
+         * @return false if the command has no opaque interior
+         */
+        static bool OpaqueRect(const DrawCommand& cmd, Rect& out);
+
+        /**
+         * @brief Pixels a command can touch, snapped outwards to whole pixels
+         */
+        static Rect PixelBounds(const DrawCommand& cmd);
+
+    private:
+        size_t maxOccluders;
+        std::vector<Rect> occluders;
+        std::vector<uint8_t> culled;
+        std::vector<uint8_t> groupState;
+        OcclusionStats stats;
+
+        void AddOccluder(const Rect& r);
+    };
+}
@@ -0,0 +1,116 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Scene.hpp"
+#include "../Threading/SnapshotExchange.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    struct RenderFrameInfo {
+        uint64_t frame = 0;         ///< Frames rendered before this one
+        std::chrono::steady_clock::time_point time;
+    };
+
+    struct RenderThreadStats {
+        uint64_t published = 0;     ///< Snapshots handed over by the UI thread
+        uint64_t consumed = 0;      ///< Snapshots the render thread picked up; the rest were superseded
+        uint64_t frames = 0;        ///< Frames rendered
+        uint64_t lastSequence = 0;  ///< SceneSnapshot::sequence of the latest frame
+    };
+
+    /**
+     * @brief Renders published SceneSnapshots on a dedicated thread
+     *
+     * The UI thread publishes snapshots through a SnapshotExchange and goes on; the
+     * render thread wakes, takes the newest one and calls the render function with it.
+     * Neither side waits for the other's work: a slow frame only makes the render
+     * thread skip to a newer snapshot, and a stalled UI thread leaves the last frame on
+     * screen. Every snapshot is rendered at most once; animations keep the UI thread
+     * scheduling frames, so the render thread is paced by what gets published.
+     *
+     * The render function runs only on the render thread; device resources it uses
+     * belong to that thread while it runs.
+     */
+    class LITHOS_API RenderThread {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using RenderFunction = std::function<void(const SceneSnapshot& scene, const RenderFrameInfo& info)>;
+
+        explicit RenderThread(RenderFunction render);
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        void Start();
+
+        /**
+         * @brief Finishes the frame in progress and joins the thread
+         */
+        void Stop();
+
+        bool IsRunning() const { return thread.joinable(); }
+
+        /**
+         * @brief Hands a snapshot to the render thread; call from one thread only
+         */
+        void Publish(std::shared_ptr<const SceneSnapshot> scene);
+
+        RenderThreadStats GetStats() const;
+
+        /**
+         * @brief Blocks until at least `count` frames were rendered in total
+         * @return false on timeout
+         */
+        bool WaitForFrames(uint64_t count, Clock::duration timeout) const;
+
+    private:
+        RenderFunction render;
+        SnapshotExchange<SceneSnapshot> exchange;
+        std::thread thread;
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        mutable std::condition_variable rendered;
+        bool pending = false;           ///< A snapshot was published since the thread last looked
+        bool stopping = false;
+
+        std::atomic<uint64_t> published{0};
+        std::atomic<uint64_t> consumed{0};
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> lastSequence{0};
+
+        void Loop();
+    };
+}
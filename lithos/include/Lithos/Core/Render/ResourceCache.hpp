@@ -0,0 +1,156 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace Lithos {
+    /**
+     * @brief Counters reported by a ResourceCache
+     */
+    struct ResourceCacheStats {
+        uint64_t hits = 0;          ///< Lookups served from the cache
+        uint64_t misses = 0;        ///< Lookups that had to create a resource
+        uint64_t evictions = 0;     ///< Resources dropped to stay within budget
+        size_t live = 0;            ///< Resources currently held
+        size_t cost = 0;            ///< Sum of the costs of held resources
+    };
+
+    /**
+     * @brief Value-keyed LRU cache for render resources
+     *
+     * Deduplicates resources (brushes, bitmaps, masks, ...) by the value they were
+     * created from and evicts the least recently used ones once the summed cost
+     * exceeds the budget. The cost unit is up to the owner: 1 per object for
+     * count budgets, or a byte size for memory budgets.
+     *
+     * Backend-agnostic: the resource type is whatever the factory returns, so the
+     * same cache serves Direct2D objects and plain CPU data.
+     *
+     * @tparam Key Value the resource is derived from
+     * @tparam Resource Cached object (must be movable)
+     * @tparam Hash Hash functor for Key
+     */
+    template <typename Key, typename Resource, typename Hash = std::hash<Key>>
+    class ResourceCache {
+    public:
+        explicit ResourceCache(const size_t budget) : budget(budget) {}
+
+        ResourceCache(const ResourceCache&) = delete;
+        ResourceCache& operator=(const ResourceCache&) = delete;
+
+        /**
+         * @brief Returns the cached resource for a key, creating it on a miss
+         *
+         * The returned reference stays valid until the entry is evicted; the entry
+         * returned by the latest call is never evicted by that call.
+         *
+         * @param key Value identifying the resource
+         * @param create Callable returning a new Resource
+         * @param cost Cost charged against the budget when created
+         */
+        template <typename Factory>
+        Resource& Acquire(const Key& key, Factory&& create, const size_t cost = 1) {
+            if (const auto it = index.find(key); it != index.end()) {
+                lru.splice(lru.begin(), lru, it->second);
+                stats.hits++;
+                return it->second->resource;
+            }
+
+            stats.misses++;
+            lru.push_front(Entry{key, std::forward<Factory>(create)(), cost});
+            index.emplace(key, lru.begin());
+            stats.live++;
+            stats.cost += cost;
+
+            Trim();
+            return lru.front().resource;
+        }
+
+        /**
+         * @brief Looks a resource up without creating it
+         * @return Pointer to the resource, or nullptr on a miss
+         */
+        Resource* Find(const Key& key) {
+            const auto it = index.find(key);
+            if (it == index.end()) return nullptr;
+            lru.splice(lru.begin(), lru, it->second);
+            return &it->second->resource;
+        }
+
+        void Erase(const Key& key) {
+            const auto it = index.find(key);
+            if (it == index.end()) return;
+            stats.live--;
+            stats.cost -= it->second->cost;
+            lru.erase(it->second);
+            index.erase(it);
+        }
+
+        void Clear() {
+            lru.clear();
+            index.clear();
+            stats.live = 0;
+            stats.cost = 0;
+        }
+
+        void SetBudget(const size_t newBudget) {
+            budget = newBudget;
+            Trim();
+        }
+
+        size_t GetBudget() const { return budget; }
+
+        const ResourceCacheStats& GetStats() const { return stats; }
+
+        /**
+         * @brief Zeroes hit/miss/eviction counters (live and cost are kept)
+         */
+        void ResetCounters() {
+            stats.hits = 0;
+            stats.misses = 0;
+            stats.evictions = 0;
+        }
+
+    private:
+        struct Entry {
+            Key key;
+            Resource resource;
+            size_t cost;
+        };
+
+        size_t budget;
+        std::list<Entry> lru;   ///< Most recently used at the front
+        std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+        ResourceCacheStats stats;
+
+        void Trim() {
+            while (stats.cost > budget && lru.size() > 1) {
+                const Entry& victim = lru.back();
+                stats.cost -= victim.cost;
+                stats.live--;
+                stats.evictions++;
+                index.erase(victim.key);
+                lru.pop_back();
+            }
+        }
+    };
+}
@@ -0,0 +1,140 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DisplayList.hpp"
+#include "../Rect.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class FlatTree;
+
+    /**
+     * @brief Recorded output of one subtree (or one element's own box), never modified once built
+     */
+    struct SceneChunk {
+        DisplayList list;       ///< Window coordinates; clips and scroll offsets already resolved
+        Rect bounds;            ///< Union of the commands' bounds
+    };
+
+    /**
+     * @brief Immutable render state of one UI frame
+     *
+     * Consecutive snapshots share every chunk whose subtree didn't change, so a
+     * snapshot costs one pointer per chunk plus whatever was re-recorded. Snapshots
+     * are safe to read from any thread; nothing in them refers back to elements.
+     */
+    struct SceneSnapshot {
+        uint64_t sequence = 0;      ///< Increases with every SceneBuilder::Build()
+        Rect viewport;
+        std::chrono::steady_clock::time_point built;
+        std::vector<std::shared_ptr<const SceneChunk>> chunks;  ///< Painter's order
+
+        size_t CommandCount() const;
+
+        /**
+         * @brief Appends every chunk to out, for renderers that take a single list
+         */
+        void Flatten(DisplayList& out) const;
+    };
+
+    struct SceneStats {
+        size_t chunks = 0;              ///< Chunks in the last snapshot
+        size_t chunksReused = 0;        ///< ...of which shared with earlier snapshots
+        size_t chunksRecorded = 0;      ///< ...of which recorded for this snapshot
+        size_t commandsRecorded = 0;    ///< Commands recorded for the last snapshot
+    };
+
+    /**
+     * @brief Turns a FlatTree into immutable, structurally shared SceneSnapshots
+     *
+     * Subtrees of at most chunkNodes nodes, and every subtree an element paints itself,
+     * become one chunk each; larger subtrees contribute a chunk for their own box and
+     * are split further. A chunk is reused while its subtree's version (see
+     * FlatTree::GetSubtreeVersion) and the clip, scissor and scroll translation it was
+     * recorded under are unchanged, so an edit re-records only the chunks on its path.
+     *
+     * Runs on the UI thread; the snapshots it returns can go to any thread.
+     */
+    class LITHOS_API SceneBuilder {
+    public:
+        static constexpr uint32_t DefaultChunkNodes = 256;
+
+        explicit SceneBuilder(uint32_t chunkNodes = DefaultChunkNodes) : chunkNodes(chunkNodes) {}
+
+        /**
+         * @param tree Flat copy of the tree; must be current (FlatTree::Sync after layout)
+         * @param viewport Region to record; culls like FlatTree::Record
+         */
+        std::shared_ptr<const SceneSnapshot> Build(const FlatTree& tree, const Rect& viewport);
+
+        /**
+         * @brief Drops every cached chunk; snapshots already built keep theirs
+         */
+        void Clear();
+
+        const SceneStats& GetStats() const { return stats; }
+
+        /**
+         * @brief Bytes held by the cached chunks (shared with the latest snapshot)
+         */
+        size_t GetMemoryBytes() const;
+
+    private:
+        struct Cached {
+            std::shared_ptr<const SceneChunk> chunk;
+            uint64_t version = 0;       ///< 0 = empty slot; versions start at 1
+            Rect clip;                  ///< Culling clip in the chunk's content coordinates
+            Rect scissor;               ///< Window-space clip in effect
+            std::pair<float, float> offset;
+        };
+
+        /// A scrolling ancestor: its viewport and scroll offset, as pushed while recording
+        struct Frame {
+            Rect viewport;
+            float scrollX, scrollY;
+        };
+
+        uint32_t chunkNodes;
+        uint64_t sequence = 0;
+
+        std::vector<Cached> boxes;      ///< By node: own box of a node split into chunks
+        std::vector<Cached> subtrees;   ///< By node: a whole subtree
+        std::vector<Frame> frames;
+        DisplayList state;              ///< Tracks the scissor and translation of `frames`
+
+        SceneSnapshot* building = nullptr;
+        SceneStats stats;
+
+        void Visit(const FlatTree& tree, uint32_t node, const Rect& clip);
+
+        template<typename RecordFn>
+        void Emit(Cached& slot, uint64_t version, const Rect& clip, RecordFn&& record);
+    };
+}
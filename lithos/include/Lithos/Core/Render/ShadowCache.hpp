@@ -0,0 +1,123 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ResourceCache.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief One piece of a nine-slice blit (source rect in mask pixels, destination rect in DIPs)
+     */
+    struct ShadowSlice {
+        float srcLeft, srcTop, srcRight, srcBottom;
+        float dstLeft, dstTop, dstRight, dstBottom;
+    };
+
+    /**
+     * @brief Pre-blurred 8-bit coverage mask of a rounded rectangle
+     *
+     * When the shape is large enough, the mask is built for a minimal template
+     * whose centre row/column is constant, so any larger shape with the same
+     * radius and blur can be drawn by stretching the centre (nine-slice).
+     */
+    struct LITHOS_API ShadowMask {
+        uint64_t id = 0;                ///< Unique id, usable as a key by backend caches
+        int width = 0, height = 0;      ///< Mask size in pixels
+        int shapeWidth = 0;             ///< Width of the rasterized shape inside the mask
+        int shapeHeight = 0;            ///< Height of the rasterized shape inside the mask
+        int extent = 0;                 ///< How far the blur reaches past the shape edge
+        int corner = 0;                 ///< Inset from each shape edge to the constant centre row/column
+        bool stretchX = false;          ///< Centre column may be stretched horizontally
+        bool stretchY = false;          ///< Centre row may be stretched vertically
+        std::vector<uint8_t> alpha;     ///< width * height coverage values
+
+        /**
+         * @brief Computes the blits needed to draw this mask for a shape of the given size
+         * @param x Left edge of the shape (not of the blurred area)
+         * @param y Top edge of the shape
+         * @param w Shape width
+         * @param h Shape height
+         * @param out Receives up to 9 slices
+         * @return Number of slices written
+         */
+        int Slices(float x, float y, float w, float h, ShadowSlice out[9]) const;
+    };
+
+    /**
+     * @brief Cache of blurred shadow masks shared by every element of a window
+     *
+     * Masks are keyed by quantized (template size, radius, blur), so elements
+     * with the same shape reuse one mask and resizing a card does not re-blur.
+     * The blur is a separable triple box blur approximating a Gaussian with
+     * sigma = blur / 2, which costs O(1) per pixel regardless of blur radius.
+     */
+    class LITHOS_API ShadowCache {
+    public:
+        /**
+         * @param budgetBytes Maximum summed size of cached masks
+         */
+        explicit ShadowCache(size_t budgetBytes = 8 * 1024 * 1024);
+
+        ShadowCache(const ShadowCache&) = delete;
+        ShadowCache& operator=(const ShadowCache&) = delete;
+
+        /**
+         * @brief Returns the mask for a rounded rectangle, building it on a miss
+         * @param width Shape width in pixels
+         * @param height Shape height in pixels
+         * @param radius Corner radius
+         * @param blur CSS-style blur radius
+         * @return Shared mask; stays alive for holders even after eviction
+         */
+        std::shared_ptr<const ShadowMask> Acquire(float width, float height, float radius, float blur);
+
+        void Clear() { masks.Clear(); }
+
+        const ResourceCacheStats& GetStats() const { return masks.GetStats(); }
+
+        /**
+         * @brief Builds an uncached mask (exposed for reuse by other render paths)
+         */
+        static ShadowMask BuildMask(int width, int height, int radius, int blur);
+
+    private:
+        struct Key {
+            int width, height, radius, blur;
+            bool operator==(const Key&) const = default;
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& k) const noexcept;
+        };
+
+        uint64_t nextId = 1;
+        ResourceCache<Key, std::shared_ptr<const ShadowMask>, KeyHash> masks;
+    };
+}
@@ -0,0 +1,135 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <memory>
+#include <span>
+#include <vector>
+#include "DisplayList.hpp"
+#include "Framebuffer.hpp"
+#include "OcclusionCuller.hpp"
+#include "ShadowCache.hpp"
+#include "../Threading/JobSystem.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief CPU rasterizer for display lists
+     *
+     * Render() bins commands into square screen tiles and rasterizes the tiles that
+     * intersect the damage region in parallel. Every pixel is computed from its own
+     * coordinates with integer blending, so the output is bit-identical to
+     * RenderSerial() regardless of tile size or thread count.
+     *
+     * With occlusion culling on, commands hidden behind later opaque fills are
+     * dropped before binning, and each tile/damage region starts at the last
+     * opaque command that covers it entirely. Neither changes the output.
+     *
+     * Text commands are skipped; there is no glyph rasterizer on this path. Images
+     * are sampled nearest-neighbour.
+     */
+    class LITHOS_API SoftwareRenderer {
+    public:
+        struct FrameStats {
+            size_t commands = 0;        ///< Commands in the display list
+            size_t tilesTotal = 0;      ///< Tiles covering the framebuffer
+            size_t tilesRendered = 0;   ///< Tiles touched by the damage region
+            size_t tilesSkipped = 0;    ///< Tiles left untouched
+            size_t binEntries = 0;      ///< Sum of per-tile command counts
+            size_t commandsCulled = 0;  ///< Commands dropped by the occlusion pass
+            size_t elementsCulled = 0;  ///< Elements dropped entirely by the occlusion pass
+            size_t regionSkips = 0;     ///< Bin entries skipped because a region was fully covered
+        };
+
+        /**
+         * @param threadCount Rasterization threads including the caller; 0 = JobSystem::Shared()
+         * @param tileSize Tile edge length in pixels
+         */
+        explicit SoftwareRenderer(unsigned threadCount = 0, int tileSize = 64);
+
+        SoftwareRenderer(const SoftwareRenderer&) = delete;
+        SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+        /**
+         * @brief Tiled, multithreaded rasterization
+         * @param list Commands to draw
+         * @param target Framebuffer; pixels outside the damage region are preserved
+         * @param damage Regions to repaint; empty = whole framebuffer
+         * @param clearColor Color the damaged pixels are reset to before drawing
+         */
+        void Render(const DisplayList& list, Framebuffer& target,
+                    std::span<const Rect> damage = {}, const Color& clearColor = Colors::Transparent);
+
+        /**
+         * @brief Single-threaded reference path with identical output
+         */
+        void RenderSerial(const DisplayList& list, Framebuffer& target,
+                          std::span<const Rect> damage = {}, const Color& clearColor = Colors::Transparent);
+
+        void SetThreadCount(unsigned threadCount);
+        unsigned GetThreadCount() const { return jobs->GetWorkerCount() + 1; }
+
+        int GetTileSize() const { return tileSize; }
+
+        void SetOcclusionCulling(const bool enabled) { occlusionCulling = enabled; }
+        bool GetOcclusionCulling() const { return occlusionCulling; }
+
+        /**
+         * @brief Occlusion results of the last frame rendered with culling on
+         */
+        const OcclusionStats& GetOcclusionStats() const { return occlusionCuller.GetStats(); }
+
+        const FrameStats& GetLastFrameStats() const { return stats; }
+
+        ShadowCache& GetShadowCache() { return shadowCache; }
+
+        /**
+         * @brief Integer pixel rectangle, right/bottom exclusive
+         */
+        struct PixelRect {
+            int x0, y0, x1, y1;
+        };
+
+    private:
+        int tileSize;
+        std::unique_ptr<JobSystem> ownJobs;     ///< Set when a thread count was given
+        JobSystem* jobs = nullptr;
+        ShadowCache shadowCache;
+        OcclusionCuller occlusionCuller;
+        bool occlusionCulling = true;
+        FrameStats stats;
+
+        // Per-frame scratch, kept to avoid reallocating every frame
+        std::vector<std::shared_ptr<const ShadowMask>> masks;
+        std::vector<uint8_t> culled;
+        std::vector<PixelRect> regions;
+        std::vector<std::vector<uint32_t>> bins;
+        std::vector<uint32_t> activeTiles;
+        std::vector<uint8_t> tileActive;
+        std::vector<uint32_t> serialBin;
+
+        void Prepare(const DisplayList& list, const Framebuffer& target, std::span<const Rect> damage);
+    };
+}
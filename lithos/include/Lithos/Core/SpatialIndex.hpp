@@ -0,0 +1,94 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "MemoryReport.hpp"
+#include "Rect.hpp"
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Uniform grid over a set of rectangles for point queries
+     *
+     * Items are identified by their index in the span passed to Build(). The cell
+     * size follows the average item size, so a query touches one cell holding a
+     * handful of items. Items spanning too many cells are kept in a separate list
+     * and tested linearly.
+     *
+     * Update() moves single items between cells. Each occupied cell is built with room
+     * for one more item; an item entering a cell with no room left joins the linear
+     * list, and once that list grows past an eighth of the items the grid is rebuilt.
+     */
+    class LITHOS_API SpatialIndex {
+    public:
+        /**
+         * @brief Rebuilds the grid; empty rects are not indexed
+         */
+        void Build(std::span<const Rect> rects);
+
+        void Clear();
+
+        /**
+         * @brief Moves one item to rect, touching only the cells it leaves and enters
+         */
+        void Update(uint32_t item, const Rect& rect);
+
+        /**
+         * @brief Collects the items whose rect contains the point
+         * @param out Item indices are appended in descending order (topmost first for paint-ordered items)
+         */
+        void Query(float x, float y, std::vector<uint32_t>& out) const;
+
+        size_t Size() const { return rects.size(); }
+        size_t CellCount() const { return static_cast<size_t>(cols) * static_cast<size_t>(rows); }
+
+        /**
+         * @brief Heap bytes held by the grid
+         */
+        size_t GetMemoryBytes() const {
+            return CapacityBytes(rects) + CapacityBytes(cellStart) + CapacityBytes(cellEnd) + CapacityBytes(cellItems)
+                 + CapacityBytes(linear) + CapacityBytes(isLinear);
+        }
+
+    private:
+        std::vector<Rect> rects;
+        std::vector<uint32_t> cellStart;    ///< CSR offsets into cellItems, CellCount() + 1 entries
+        std::vector<uint32_t> cellEnd;      ///< End of each cell's live items; the rest up to the next start is room
+        std::vector<uint32_t> cellItems;
+        std::vector<uint32_t> linear;       ///< Items covering more than MaxCellsPerItem cells or moved into full ones
+        std::vector<uint8_t> isLinear;      ///< By item
+
+        Rect extent;
+        float cellSize = 1.0f;
+        int cols = 0;
+        int rows = 0;
+
+        void CellRange(const Rect& r, int& c0, int& r0, int& c1, int& r1) const;
+        bool Fits(const Rect& r, int& c0, int& r0, int& c1, int& r1) const;
+    };
+}
@@ -45,5 +45,8 @@ struct Style {
     float shadowOffsetX = 0, shadowOffsetY = 0;
     float shadowBlur = 0;
     Lithos::Color shadowColor = Lithos::Color(0, 0, 0, 0.5f);
+
+    Lithos::Color textColor = Lithos::Colors::Black;
+    float fontSize = 14.0f;
     CursorType cursor = CursorType::Arrow;
 };
@@ -0,0 +1,156 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    /**
+     * @brief Editable UTF-16 text as a piece table with a line index
+     *
+     * Text is never moved once stored: the initial text stays in one buffer, and
+     * inserted text is appended to a second one. The document is the sequence of
+     * pieces (spans of either buffer), kept in a treap ordered by position. Every node
+     * caches its subtree's length and line-break count, so Insert(), Erase(),
+     * LineStart() and LineOf() are O(log n). Each buffer keeps the sorted offsets of
+     * its '\n' characters, so counting breaks inside a piece is a binary search.
+     *
+     * Inserting right after the previous insertion (typing, streaming appends) extends
+     * the last piece instead of adding one, so Append() costs O(appended + log n).
+     * Erased text stays in the buffers until Compact().
+     *
+     * Lines end at '\n'. A preceding '\r' stays part of the line's text.
+     */
+    class LITHOS_API TextBuffer {
+    public:
+        TextBuffer() = default;
+        explicit TextBuffer(std::wstring_view text);
+
+        /**
+         * @brief Replaces the whole text and drops all history
+         */
+        void SetText(std::wstring_view text);
+
+        /**
+         * @param offset Clamped to Length()
+         */
+        void Insert(size_t offset, std::wstring_view text);
+        void Append(std::wstring_view text) { Insert(Length(), text); }
+
+        /**
+         * @brief Removes up to count characters starting at offset
+         */
+        void Erase(size_t offset, size_t count);
+
+        void Clear() { SetText({}); }
+
+        /**
+         * @brief Rewrites the text into one buffer, releasing erased text and merging pieces; O(n)
+         */
+        void Compact();
+
+        size_t Length() const { return root ? nodes[root].size : 0; }
+        bool Empty() const { return Length() == 0; }
+
+        /**
+         * @brief Line breaks plus one; an empty buffer has one empty line
+         */
+        size_t LineCount() const { return (root ? nodes[root].subtreeBreaks : 0) + 1; }
+
+        /**
+         * @brief Offset of the first character of line; Length() past the last line
+         */
+        size_t LineStart(size_t line) const;
+
+        /**
+         * @brief Characters in line, excluding its '\n'
+         */
+        size_t LineLength(size_t line) const;
+
+        /**
+         * @brief Line containing offset (a '\n' belongs to the line it ends)
+         */
+        size_t LineOf(size_t offset) const;
+
+        /**
+         * @brief Appends the characters in [offset, offset + count) to out
+         */
+        void CopyText(size_t offset, size_t count, std::wstring& out) const;
+
+        std::wstring GetText(size_t offset, size_t count) const;
+        std::wstring GetLine(size_t line) const;
+        std::wstring ToString() const { return GetText(0, Length()); }
+
+        size_t PieceCount() const { return nodes.size() - 1 - freeNodes.size(); }
+
+        /**
+         * @brief Heap bytes held by the buffers, line indexes and pieces
+         */
+        size_t GetMemoryBytes() const;
+
+    private:
+        static constexpr uint32_t Null = 0;
+
+        struct Buffer {
+            std::wstring text;
+            std::vector<size_t> breaks;     ///< Offsets of '\n' in text, ascending
+        };
+
+        struct Node {
+            uint32_t left = Null;
+            uint32_t right = Null;
+            uint32_t priority = 0;
+            uint8_t buffer = 0;             ///< 0 = initial text, 1 = inserted text
+            size_t start = 0;               ///< Piece: [start, start + length) of the buffer
+            size_t length = 0;
+            size_t breaks = 0;              ///< Line breaks inside the piece
+            size_t size = 0;                ///< Subtree totals
+            size_t subtreeBreaks = 0;
+        };
+
+        Buffer buffers[2];
+        std::vector<Node> nodes{Node{}};    ///< Index 0 is the null node
+        std::vector<uint32_t> freeNodes;
+        uint32_t root = Null;
+        uint32_t seed = 0x9e3779b9u;
+
+        uint32_t NewNode(uint8_t buffer, size_t start, size_t length);
+        void FreeSubtree(uint32_t node);
+        void Update(uint32_t node);
+
+        size_t CountBreaks(uint8_t buffer, size_t start, size_t length) const;
+        static void AppendText(Buffer& buffer, std::wstring_view text);
+
+        void Split(uint32_t node, size_t offset, uint32_t& left, uint32_t& right);
+        uint32_t Merge(uint32_t left, uint32_t right);
+
+        void Copy(uint32_t node, size_t offset, size_t count, std::wstring& out) const;
+    };
+}
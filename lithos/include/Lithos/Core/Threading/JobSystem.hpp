@@ -0,0 +1,185 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    class JobSystem;
+
+    struct JobWorkerStats {
+        uint64_t jobs = 0;          ///< Jobs run
+        uint64_t steals = 0;        ///< Jobs taken from another worker's deque
+        uint64_t sleeps = 0;        ///< Times the worker blocked for lack of work
+        std::chrono::nanoseconds busy{0};   ///< Time spent running jobs
+        std::chrono::nanoseconds idle{0};   ///< Time between jobs, searching or asleep, up to the last job
+    };
+
+    struct JobSystemStats {
+        std::vector<JobWorkerStats> workers;
+        uint64_t submitted = 0;     ///< Jobs queued
+        uint64_t helped = 0;        ///< Jobs run by non-worker threads while waiting on a TaskGroup
+    };
+
+    /**
+     * @brief Set of jobs that can be waited on together (fork/join)
+     *
+     * Wait() runs queued jobs on the calling thread until every job of the group
+     * finished, so groups nest: a job may fork its own group and wait on it without
+     * tying up a worker. The destructor waits too.
+     */
+    class LITHOS_API TaskGroup {
+    public:
+        explicit TaskGroup(JobSystem& jobs) : jobs(jobs) {}
+        ~TaskGroup() { Wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void Run(std::function<void()> fn);
+        void Wait();
+
+    private:
+        JobSystem& jobs;
+        std::atomic<size_t> pending{0};
+    };
+
+    /**
+     * @brief Work-stealing job scheduler
+     *
+     * Every worker owns a deque: jobs submitted from a worker go to the back of its own
+     * deque and are taken back LIFO (hot in cache, depth first), while idle workers
+     * steal from the front of other deques, taking the oldest and usually largest
+     * piece of work. Jobs submitted from other threads go to a shared queue. Workers
+     * with nothing to do spin briefly, then sleep until a job is submitted.
+     *
+     * Jobs never run on the submitting thread's stack: a system without workers keeps
+     * them queued for threads waiting on a TaskGroup or calling RunPending().
+     *
+     * Shared() is the library's instance, for subsystems without their own; it always
+     * has a worker, so fire-and-forget jobs make progress. Jobs must not throw.
+     */
+    class LITHOS_API JobSystem {
+    public:
+        /**
+         * @param workerCount Background threads; callers waiting on work also run jobs,
+         *        so with 0 only Wait()/RunPending() callers run anything
+         */
+        explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Hardware concurrency minus the calling thread
+         */
+        static unsigned DefaultWorkerCount();
+
+        /**
+         * @brief Library-wide instance, created on first use
+         */
+        static JobSystem& Shared();
+
+        /**
+         * @brief Sets the worker count Shared() will be created with; at least one
+         * @return false if Shared() already exists
+         */
+        static bool ConfigureShared(unsigned workerCount);
+
+        /**
+         * @brief Queues a job nobody waits for; without workers it waits for RunPending()
+         */
+        void Submit(std::function<void()> fn);
+
+        /**
+         * @brief Runs a and b, possibly in parallel, and returns once both finished
+         */
+        void Join(const std::function<void()>& a, std::function<void()> b);
+
+        /**
+         * @brief Runs fn(begin, end) over subranges covering [0, count), and returns once all finished
+         * @param grain Largest subrange; 0 picks one giving every thread several pieces
+         *
+         * The range is split in halves, so thieves take large pieces first.
+         */
+        void ParallelForRanges(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+        /**
+         * @brief Runs fn(i) for every i in [0, count) and returns once all calls finished
+         */
+        void ParallelFor(size_t count, const std::function<void(size_t)>& fn, size_t grain = 0);
+
+        /**
+         * @brief Runs one queued job on the calling thread
+         * @return false if no job was available
+         */
+        bool RunPending();
+
+        unsigned GetWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+        JobSystemStats GetStats() const;
+        void ResetStats();
+
+    private:
+        struct Job {
+            std::function<void()> fn;
+            std::atomic<size_t>* pending = nullptr;     ///< Group counter, decremented when done
+        };
+
+        struct Worker;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        std::mutex injectedMutex;
+        std::deque<Job> injected;       ///< Jobs from non-worker threads, taken oldest first
+
+        std::atomic<int64_t> queued{0};     ///< Jobs in all queues; may briefly run ahead of them
+        std::atomic<unsigned> sleepers{0};
+        std::atomic<bool> stopping{false};
+        std::mutex sleepMutex;
+        std::condition_variable sleep;
+
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> helped{0};
+
+        void Push(Job job);
+        bool Take(Worker* self, Job& job);
+        static void Execute(Job& job);
+        void WorkerLoop(Worker& self);
+
+        friend class TaskGroup;
+    };
+}
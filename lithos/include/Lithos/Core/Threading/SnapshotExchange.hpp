@@ -0,0 +1,71 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Lithos {
+    /**
+     * @brief Hands the latest immutable value from one producer thread to one consumer thread
+     *
+     * Front and back buffers plus a spare in the middle: the producer fills its back slot
+     * and swaps it with the middle, the consumer swaps its front slot with the middle
+     * when a fresh value is there. Both swaps are a single atomic exchange, so neither
+     * side ever waits for the other. Values published faster than they are consumed
+     * are skipped; the consumer always sees the newest.
+     *
+     * A replaced value is released by the producer on its next Publish().
+     */
+    template<typename T>
+    class SnapshotExchange {
+    public:
+        /**
+         * @brief Producer only
+         */
+        void Publish(std::shared_ptr<const T> value) {
+            slots[back] = std::move(value);
+            const uint8_t previous = middle.exchange(static_cast<uint8_t>(back | Fresh), std::memory_order_acq_rel);
+            back = previous & IndexMask;
+        }
+
+        /**
+         * @brief Consumer only
+         * @return Newest value published since the last call, or nullptr if there is none
+         */
+        std::shared_ptr<const T> Acquire() {
+            if (!(middle.load(std::memory_order_acquire) & Fresh)) return nullptr;
+            const uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+            front = previous & IndexMask;
+            return slots[front];
+        }
+
+        /**
+         * @brief Consumer only: the value the last successful Acquire() returned
+         */
+        const std::shared_ptr<const T>& Current() const { return slots[front]; }
+
+    private:
+        static constexpr uint8_t IndexMask = 0x3;
+        static constexpr uint8_t Fresh = 0x4;
+
+        std::shared_ptr<const T> slots[3];
+        std::atomic<uint8_t> middle{1};     ///< Slot index, plus Fresh when the consumer hasn't taken it
+        uint8_t back = 0;                   ///< Owned by the producer
+        uint8_t front = 2;                  ///< Owned by the consumer
+    };
+}
@@ -0,0 +1,156 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
+#else
+    #define LITHOS_API
+#endif
+
+namespace Lithos {
+    struct UiDispatcherStats {
+        uint64_t posted = 0;        ///< Tasks accepted since the last ResetStats()
+        uint64_t executed = 0;      ///< Tasks run by Drain()
+        uint64_t rejected = 0;      ///< Posts refused because the queue was (and stayed) full
+        uint64_t waits = 0;         ///< Posts that had to wait for room
+        uint64_t drains = 0;        ///< Drain() calls that ran anything
+        size_t depth = 0;           ///< Tasks queued when the stats were read
+        size_t maxDepth = 0;        ///< Deepest the queue got
+        size_t capacity = 0;
+        std::chrono::nanoseconds lastMaxDelay{0};   ///< Longest post-to-run wait in the last drain
+        std::chrono::nanoseconds maxDelay{0};       ///< Longest post-to-run wait seen
+    };
+
+    /**
+     * @brief Queue of closures posted from any thread and run on the UI thread
+     *
+     * Producers claim a slot of a fixed ring with one compare-and-swap and publish it
+     * with a sequence number, so posting never takes a lock while there is room; the
+     * UI thread is the single consumer. The first post after a drain calls the wake
+     * handler, which asks for a frame; Drain() then runs everything posted so far in
+     * one go at the start of that frame, so any number of updates share one layout
+     * and paint.
+     *
+     * A full queue pushes back on producers: TryPost() fails, Post() waits for the
+     * next drain to make room (up to a timeout). The owning thread never waits, since
+     * only it can make room.
+     */
+    class LITHOS_API UiDispatcher {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Task = std::function<void()>;
+
+        static constexpr size_t DefaultCapacity = 4096;
+
+        /**
+         * @param capacity Rounded up to a power of two
+         *
+         * The constructing thread becomes the owner (the thread that drains).
+         */
+        explicit UiDispatcher(size_t capacity = DefaultCapacity);
+        ~UiDispatcher();
+
+        UiDispatcher(const UiDispatcher&) = delete;
+        UiDispatcher& operator=(const UiDispatcher&) = delete;
+
+        /**
+         * @brief Queues task unless the queue is full; any thread
+         */
+        bool TryPost(Task task);
+
+        /**
+         * @brief Queues task, waiting up to timeout for room; any thread
+         * @return false if the queue stayed full (always immediately on the owning thread)
+         */
+        bool Post(Task task, Clock::duration timeout = Clock::duration::max());
+
+        /**
+         * @brief Runs the tasks posted before the call, in posting order per producer; owning thread only
+         * @param now Time queueing delay is measured against
+         * @return Number of tasks run
+         *
+         * Tasks posted while draining wait for the next call.
+         */
+        size_t Drain(Clock::time_point now = Clock::now());
+
+        /**
+         * @brief Called, from the posting thread, when work arrives while none was signaled
+         */
+        void SetWakeHandler(std::function<void()> handler) { wake = std::move(handler); }
+
+        void SetOwnerThread(std::thread::id id) { owner = id; }
+        bool IsOwnerThread() const { return std::this_thread::get_id() == owner; }
+
+        size_t GetDepth() const;
+        size_t GetCapacity() const { return mask + 1; }
+
+        UiDispatcherStats GetStats() const;
+        void ResetStats();
+
+        size_t GetMemoryBytes() const;
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;   ///< == position: free; == position + 1: holds the task of that position
+            Task task;
+            Clock::time_point posted;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        std::thread::id owner;
+        std::function<void()> wake;
+
+        alignas(64) std::atomic<size_t> tail{0};    ///< Next position producers claim
+        alignas(64) std::atomic<size_t> head{0};    ///< Next position to run; written by the owner only
+        std::atomic<bool> signaled{false};          ///< A wake is outstanding since the last drain
+
+        // Slow path of Post() while the queue is full
+        std::mutex roomMutex;
+        std::condition_variable room;
+        std::atomic<uint32_t> waiting{0};
+
+        std::atomic<size_t> maxDepth{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> waits{0};
+        uint64_t drains = 0;
+        size_t postedBase = 0;
+        size_t executedBase = 0;
+        std::chrono::nanoseconds lastMaxDelay{0};
+        std::chrono::nanoseconds maxDelay{0};
+
+        /**
+         * @brief Moves task into a free slot; leaves it untouched on failure
+         */
+        bool TryPush(Task& task);
+        void Signal();
+    };
+}
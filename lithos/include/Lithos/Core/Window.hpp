@@ -16,16 +16,42 @@
 
 // lithos/include/Lithos/Core/Window.hpp
 #pragma once
-#include "../PCH.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#ifdef _WIN32
+    #include "../PCH.hpp"
+#endif
 
-#ifdef LITHOS_EXPORTS
-    #define LITHOS_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef LITHOS_EXPORTS
+        #define LITHOS_API __declspec(dllexport)
+    #else
+        #define LITHOS_API __declspec(dllimport)
+    #endif
 #else
-    #define LITHOS_API __declspec(dllimport)
+    #define LITHOS_API
 #endif
 
 namespace Lithos {
     class Element;
+    class DeviceResources;
+    struct Framebuffer;
+    struct OcclusionStats;
+    struct HoverStats;
+    struct InputQueueStats;
+    struct MouseEvent;
+    class LatencyTracker;
+    class ElementPool;
+    struct MemoryReport;
+    struct MemoryTotals;
+    struct RenderThreadStats;
+    struct FrameSchedulerStats;
+    struct Rect;
+    class ImageLoader;
+    class UiDispatcher;
+    class CoroutineScheduler;
+    class TransitionManager;
 
     class LITHOS_API Window {
         public:
@@ -34,12 +60,178 @@ namespace Lithos {
 
             Element& GetRoot();
 
+            /**
+             * @brief Pool the window's elements are allocated from; pass it to Element::Make()
+             *        to build detached subtrees in the same pool
+             */
+            ElementPool& GetElementPool();
+
+            /**
+             * @brief Paints and hit tests from a flat array copy of the tree (default) or by
+             *        walking the elements directly
+             */
+            void SetFlatTraversal(bool enabled);
+
+            /**
+             * @brief Moves replay and presentation to a dedicated render thread
+             *
+             * Each frame the UI thread then lays out, publishes an immutable SceneSnapshot
+             * and returns without waiting for the GPU; a slow callback no longer holds up
+             * presenting what was already published. While enabled the device context and
+             * swap chain belong to the render thread. GetDeviceResources() stays on the UI
+             * thread (text measuring, paths); the render thread has its own caches.
+             */
+            void SetRenderThread(bool enabled);
+
+            /**
+             * @brief Frames and snapshots handled by the render thread; zeros while it is off
+             */
+            RenderThreadStats GetRenderThreadStats() const;
+
+#ifdef _WIN32
+            /**
+             * @brief Direct2D resources shared by all elements of this window
+             */
+            DeviceResources& GetDeviceResources();
+#else
+            /**
+             * @brief Pixels of the last frame; headless builds paint with the software renderer
+             */
+            const Framebuffer& GetFramebuffer() const;
+#endif
+
+            /**
+             * @brief Occlusion results of the last frame painted on the UI thread
+             *
+             * Not updated while the render thread is on.
+             */
+            const OcclusionStats& GetOcclusionStats() const;
+
+            /**
+             * @brief Hover-path cache hits/misses and enter/leave counts since startup
+             */
+            const HoverStats& GetHoverStats() const;
+
+            /**
+             * @brief Input received vs. dispatched after coalescing, and queueing delay
+             */
+            const InputQueueStats& GetInputStats() const;
+
+            /**
+             * @brief Per-frame input-to-present timings and latency percentiles
+             */
+            const LatencyTracker& GetLatency() const;
+
+            /**
+             * @brief Walks the tree and caches and reports bytes by category
+             *
+             * Costs a full tree walk; use GetMemoryTotals() for continuous monitoring.
+             */
+            MemoryReport GetMemoryReport() const;
+
+            /**
+             * @brief Running element count and sizes plus pool, cache and frame buffer sizes, in O(1)
+             */
+            MemoryTotals GetMemoryTotals() const;
+
+            /**
+             * @brief Queues a synthetic mouse event, delivered with the next frame like platform input
+             *
+             * An unset timestamp is stamped on arrival, so input latency covers the wait for
+             * the frame; replayed input can keep its recorded time.
+             */
+            void PostMouseEvent(MouseEvent evt);
+
+            /**
+             * @brief Schedules a repaint of the whole client area
+             *
+             * UI thread only. A request made before the current frame's Paint phase
+             * (from a posted task, an input handler or an animation) is painted in it.
+             */
+            void RequestRepaint() const;
+
+            /**
+             * @brief Schedules a repaint of area only (window coordinates; UI thread)
+             *
+             * A frame with nothing but such requests redraws the union of their areas
+             * (plus what the swap chain's other buffer is missing) and presents it as a
+             * dirty rect. Without the render thread only; with it every frame is whole.
+             */
+            void RequestRepaint(const Rect& area) const;
+
+            /**
+             * @brief Loader image elements use unless given their own; decodes with WIC
+             *
+             * Results are picked up at the start of each frame.
+             */
+            ImageLoader& GetImageLoader();
+
+            /**
+             * @brief Queue for running closures on the UI thread from other threads
+             *
+             * Tasks run at the start of the next frame, before input, so the frame's
+             * layout and paint cover every update posted since the last one. This is the
+             * only safe way for other threads to touch elements.
+             */
+            UiDispatcher& GetDispatcher();
+
+            /**
+             * @brief Runs UiTask scripts against this window's frames
+             *
+             * Waiting tasks resume in the Animate phase (delays, next frame, then finished
+             * transitions) and after layout. Tasks still running when the window closes
+             * are destroyed before its elements.
+             */
+            CoroutineScheduler& GetCoroutines();
+
+            /**
+             * @brief Calls element.Animate() before each frame until it returns false
+             *
+             * Prefer Element::RequestAnimationFrame(), which avoids duplicate registrations.
+             */
+            void RequestAnimationFrame(Element& element);
+
+            /**
+             * @brief Frames run and requested, wakeups from idle and late frames
+             */
+            FrameSchedulerStats GetFrameStats() const;
+
+            /**
+             * @brief Minimum time between frames while work keeps coming (default 60 Hz)
+             */
+            void SetFrameInterval(std::chrono::steady_clock::duration interval);
+
             void Show() const;
 
+            /**
+             * @brief Pumps messages and runs frames until the window quits
+             *
+             * Frames run only while input, damage or animations are pending, at most once
+             * per frame interval; otherwise the thread sleeps in WaitMessage(). Headless
+             * builds have no messages and return once no frame is scheduled.
+             */
             void Run();
 
+            /**
+             * @brief Runs a frame if one is due at now; for headless drivers and tests
+             * @return true if a frame ran
+             */
+            bool Tick(std::chrono::steady_clock::time_point now);
+
         private:
             struct Impl;
             std::unique_ptr<Impl> pimpl;
+
+            // Called by Element::SetWindow() as elements attach and detach
+            void TrackElement(const Element& element);
+            void UntrackElement(const Element& element);
+
+            // Called by TransitionManager while transitions run on this window's elements
+            void RegisterTransitions(TransitionManager& manager);
+            void UnregisterTransitions(TransitionManager& manager);
+            void RunTransitions(std::chrono::steady_clock::time_point now);
+
+            friend class Element;
+            friend class TransitionManager;
     };
 }
\ No newline at end of file
@@ -18,21 +18,84 @@
 
 #include "Lithos/Core/Animation/Transition.hpp"
 #include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Window.hpp"
 #include <algorithm>
 
 namespace Lithos {
+    namespace {
+        /**
+         * Maps a color property to its Element::animatedColors bit (0 for non-color properties)
+         */
+        uint8_t AnimatedColorBit(const AnimatableProperty property) {
+            switch (property) {
+                case AnimatableProperty::BackgroundColor: return AnimatedColor::Background;
+                case AnimatableProperty::BorderColor:     return AnimatedColor::Border;
+                case AnimatableProperty::ShadowColor:     return AnimatedColor::Shadow;
+                case AnimatableProperty::TextColor:       return AnimatedColor::Text;
+                default:                                  return 0;
+            }
+        }
+    }
+
+    TransitionManager::~TransitionManager() {
+        if (window) window->UnregisterTransitions(*this);
+    }
+
+    TransitionManager::TransitionManager(TransitionManager&& other) noexcept
+        : configs(std::move(other.configs)),
+          activeTransitions(std::move(other.activeTransitions)),
+          finishCallbacks(std::move(other.finishCallbacks)),
+          target(std::move(other.target)) {
+        if (Window* registered = other.window) {
+            // The window must update the manager at its new address
+            registered->UnregisterTransitions(other);
+            registered->RegisterTransitions(*this);
+        }
+    }
+
+    TransitionManager& TransitionManager::operator=(TransitionManager&& other) noexcept {
+        if (this == &other) return *this;
+        if (window) window->UnregisterTransitions(*this);
+
+        configs = std::move(other.configs);
+        activeTransitions = std::move(other.activeTransitions);
+        finishCallbacks = std::move(other.finishCallbacks);
+        target = std::move(other.target);
+        if (Window* registered = other.window) {
+            registered->UnregisterTransitions(other);
+            registered->RegisterTransitions(*this);
+        }
+        return *this;
+    }
+
     void TransitionManager::AddTransition(const TransitionConfig& config) {
         configs.insert_or_assign(config.property, config);
     }
 
     void TransitionManager::RemoveTransition(AnimatableProperty property) {
         configs.erase(property);
-        activeTransitions.erase(property);
+        if (activeTransitions.erase(property) != 0) {
+            // Stopped mid-way: the color stays where it was, drawn with cached brushes again
+            if (const std::shared_ptr<Element> element = target.lock()) {
+                element->animatedColors &= static_cast<uint8_t>(~AnimatedColorBit(property));
+                element->RequestRepaint();
+            }
+        }
+        NotifyFinished();
     }
 
     void TransitionManager::ClearTransitions() {
         configs.clear();
-        activeTransitions.clear();
+        if (!activeTransitions.empty()) {
+            if (const std::shared_ptr<Element> element = target.lock()) {
+                for (const auto& [property, transition] : activeTransitions) {
+                    element->animatedColors &= static_cast<uint8_t>(~AnimatedColorBit(property));
+                }
+                element->RequestRepaint();
+            }
+            activeTransitions.clear();
+        }
+        NotifyFinished();
     }
 
     void TransitionManager::OnPropertyChange(Element* element, AnimatableProperty property, const PropertyValue& newValue) {
@@ -62,6 +125,29 @@ namespace Lithos {
 
         // Insert or replace existing transition for this property
         activeTransitions.insert_or_assign(property, transition);
+
+        // Let the element's window run it; an element in no window is left to explicit Update() calls
+        target = element->weak_from_this();
+        if (element->windowPtr != window) {
+            if (window) window->UnregisterTransitions(*this);
+            if (element->windowPtr) element->windowPtr->RegisterTransitions(*this);
+        }
+    }
+
+    bool TransitionManager::UpdateTarget(const std::chrono::steady_clock::time_point currentTime) {
+        const std::shared_ptr<Element> element = target.lock();
+        if (!element || element->windowPtr != window) {
+            // Nothing left to animate here; waiting callbacks hear the transitions are gone
+            if (element) {
+                for (const auto& [property, transition] : activeTransitions) {
+                    element->animatedColors &= static_cast<uint8_t>(~AnimatedColorBit(property));
+                }
+            }
+            activeTransitions.clear();
+            NotifyFinished();
+            return false;
+        }
+        return Update(element.get(), currentTime);
     }
 
     bool TransitionManager::Update(Element* element, std::chrono::steady_clock::time_point currentTime) {
@@ -94,10 +180,11 @@ namespace Lithos {
             if (animElapsed >= transition.duration) {
                 // Apply final value
                 ApplyValue(element, property, transition.targetValue, true);
+                element->animatedColors &= static_cast<uint8_t>(~AnimatedColorBit(property));
                 completedTransitions.push_back(property);
             } else {
-                // Calculate progress (0.0 to 1.0)
-                float t = animElapsed / transition.duration;
+                // Calculate progress (0.0 to 1.0); frame times may precede the start
+                float t = std::max(animElapsed / transition.duration, 0.0f);
 
                 // Apply easing function
                 float easedT = transition.easing ? transition.easing(t) : t;
@@ -111,6 +198,7 @@ namespace Lithos {
 
                 // Apply interpolated value
                 ApplyValue(element, property, interpolatedValue, true);
+                element->animatedColors |= AnimatedColorBit(property);
             }
         }
 
@@ -118,6 +206,9 @@ namespace Lithos {
         for (auto property : completedTransitions) {
             activeTransitions.erase(property);
         }
+        if (!completedTransitions.empty()) {
+            NotifyFinished();
+        }
 
         return !activeTransitions.empty();
     }
@@ -126,6 +217,29 @@ namespace Lithos {
         return activeTransitions.find(property) != activeTransitions.end();
     }
 
+    void TransitionManager::WhenFinished(AnimatableProperty property, std::function<void()> callback) {
+        if (!HasActiveTransition(property)) {
+            callback();
+            return;
+        }
+        finishCallbacks.emplace_back(property, std::move(callback));
+    }
+
+    void TransitionManager::NotifyFinished() {
+        if (finishCallbacks.empty()) return;
+
+        // Collect first: callbacks may register new ones
+        std::vector<std::function<void()>> ready;
+        std::erase_if(finishCallbacks, [&](auto& entry) {
+            if (HasActiveTransition(entry.first)) return false;
+            ready.push_back(std::move(entry.second));
+            return true;
+        });
+        for (auto& callback : ready) {
+            callback();
+        }
+    }
+
     PropertyValue TransitionManager::GetCurrentValue(Element* element, AnimatableProperty property) {
         // Check if there's an active transition for this property
         auto it = activeTransitions.find(property);
@@ -324,18 +438,21 @@ namespace Lithos {
             case AnimatableProperty::ShadowOffsetX:
                 if (const float* v = std::get_if<float>(&value)) {
                     element->style.shadowOffsetX = *v;
+                    needsLayout = true;     // Shadow extent feeds the subtree bounds
                 }
                 break;
 
             case AnimatableProperty::ShadowOffsetY:
                 if (const float* v = std::get_if<float>(&value)) {
                     element->style.shadowOffsetY = *v;
+                    needsLayout = true;
                 }
                 break;
 
             case AnimatableProperty::ShadowBlur:
                 if (const float* v = std::get_if<float>(&value)) {
                     element->style.shadowBlur = *v;
+                    needsLayout = true;
                 }
                 break;
 
@@ -423,13 +540,10 @@ namespace Lithos {
                 break;
         }
 
-        //TODO
-        // // Trigger appropriate update
-        // if (needsLayout) {
-        //     element->RequestLayout();
-        // } else {
-        //     // MarkDirty() automatically routes to RequestRepaint() when differential rendering is enabled
-        //     element->MarkDirty();
-        // }
+        if (needsLayout) {
+            element->InvalidateLayout();
+        } else {
+            element->RequestRepaint();
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Animation/UiTask.hpp"
+#include "Lithos/Core/FrameScheduler.hpp"
+#include "Lithos/Core/MemoryReport.hpp"
+#include <algorithm>
+#include <new>
+
+namespace Lithos {
+    namespace {
+        size_t SizeClass(const size_t bytes) {
+            return (bytes + CoroutineFramePool::ClassBytes - 1) / CoroutineFramePool::ClassBytes - 1;
+        }
+
+        size_t ClassSize(const size_t sizeClass) {
+            return (sizeClass + 1) * CoroutineFramePool::ClassBytes;
+        }
+    }
+
+    CoroutineFramePool& CoroutineFramePool::Local() {
+        thread_local CoroutineFramePool pool;
+        return pool;
+    }
+
+    CoroutineFramePool::~CoroutineFramePool() {
+        Trim();
+    }
+
+    void* CoroutineFramePool::Allocate(const size_t bytes) {
+        stats.allocations++;
+        stats.live++;
+        if (bytes > MaxClassBytes) {
+            stats.oversized++;
+            return ::operator new(bytes);
+        }
+
+        const size_t sizeClass = SizeClass(bytes);
+        if (FreeBlock* block = freeLists[sizeClass]) {
+            freeLists[sizeClass] = block->next;
+            stats.reuses++;
+            return block;
+        }
+
+        stats.bytesReserved += ClassSize(sizeClass);
+        return ::operator new(ClassSize(sizeClass));
+    }
+
+    void CoroutineFramePool::Deallocate(void* frame, const size_t bytes) {
+        if (!frame) return;
+        stats.live--;
+        if (bytes > MaxClassBytes) {
+            ::operator delete(frame);
+            return;
+        }
+
+        const size_t sizeClass = SizeClass(bytes);
+        freeLists[sizeClass] = ::new (frame) FreeBlock{freeLists[sizeClass]};
+    }
+
+    void CoroutineFramePool::Reserve(const size_t bytes, const size_t count) {
+        if (bytes == 0 || bytes > MaxClassBytes) return;
+
+        const size_t sizeClass = SizeClass(bytes);
+        for (size_t i = 0; i < count; ++i) {
+            freeLists[sizeClass] = ::new (::operator new(ClassSize(sizeClass))) FreeBlock{freeLists[sizeClass]};
+            stats.bytesReserved += ClassSize(sizeClass);
+        }
+    }
+
+    void CoroutineFramePool::Trim() {
+        for (size_t sizeClass = 0; sizeClass < freeLists.size(); ++sizeClass) {
+            while (FreeBlock* block = freeLists[sizeClass]) {
+                freeLists[sizeClass] = block->next;
+                ::operator delete(block);
+                stats.bytesReserved -= ClassSize(sizeClass);
+            }
+        }
+    }
+
+    void CoroutineFramePool::ResetStats() {
+        const size_t live = stats.live;
+        const size_t bytesReserved = stats.bytesReserved;
+        stats = {};
+        stats.live = live;
+        stats.bytesReserved = bytesReserved;
+    }
+
+    CoroutineScheduler::CoroutineScheduler(FrameScheduler& frames)
+        : frames(frames),
+          inbox(std::make_shared<Inbox>()) {
+        inbox->frames = &frames;
+    }
+
+    CoroutineScheduler::~CoroutineScheduler() {
+        CancelAll();
+    }
+
+    uint64_t CoroutineScheduler::Spawn(UiTask task) {
+        if (task.IsDone()) return 0;
+
+        const uint64_t id = nextId++;
+        const UiTask::Handle handle = task.handle;
+        handle.promise().scheduler = this;
+        handle.promise().id = id;
+        tasks.emplace(id, std::move(task));
+        stats.spawned++;
+        stats.running = tasks.size();
+
+        // Runs to its first wait; a task that never waits is finished (and gone) on return
+        handle.resume();
+        return id;
+    }
+
+    bool CoroutineScheduler::Cancel(const uint64_t id) {
+        const auto it = tasks.find(id);
+        if (it == tasks.end()) return false;
+
+        // Move out first: destroying the frame may run destructors that touch the scheduler
+        UiTask task = std::move(it->second);
+        tasks.erase(it);
+        stats.cancelled++;
+        stats.running = tasks.size();
+
+        // Waits the task left behind are skipped when their point comes; deadlines would
+        // still book frames, so drop those now
+        if (std::erase_if(timers, [id](const Timer& timer) { return timer.waiter.id == id; })) {
+            std::make_heap(timers.begin(), timers.end(), TimerLater);
+        }
+        return true;
+    }
+
+    void CoroutineScheduler::CancelAll() {
+        auto cancelled = std::move(tasks);
+        tasks.clear();
+        stats.cancelled += cancelled.size();
+        stats.running = 0;
+        timers.clear();
+        cancelled.clear();
+    }
+
+    void CoroutineScheduler::Resume(const ResumePoint point, const FrameInfo& info) {
+        frameTime = info.time;
+
+        switch (point) {
+            case ResumePoint::FrameStart: {
+                inFrame = true;
+                inbox->collecting = true;
+
+                // Deadlines first, earliest first
+                resuming.clear();
+                while (!timers.empty() && timers.front().due <= info.time) {
+                    std::pop_heap(timers.begin(), timers.end(), TimerLater);
+                    resuming.push_back(timers.back().waiter);
+                    timers.pop_back();
+                }
+                ResumeWaiters(resuming);
+
+                resuming.swap(frameWaiters);
+                ResumeWaiters(resuming);
+
+                // The booking that woke this frame is used up
+                if (!timers.empty()) {
+                    frames.RequestFrameAt(timers.front().due, FrameWork::Resume);
+                }
+                break;
+            }
+            case ResumePoint::AfterAnimate:
+                inbox->collecting = false;
+                resuming.swap(inbox->ready);
+                ResumeWaiters(resuming);
+                break;
+            case ResumePoint::AfterLayout:
+                resuming.swap(layoutWaiters);
+                ResumeWaiters(resuming);
+                inFrame = false;
+                break;
+        }
+    }
+
+    void CoroutineScheduler::ResumeWaiters(std::vector<Waiter>& waiters) {
+        // Tasks resumed here queue new waits on the live lists, never on `waiters`
+        for (size_t i = 0; i < waiters.size(); ++i) {
+            const Waiter waiter = waiters[i];
+            if (!tasks.contains(waiter.id)) continue;     // Cancelled while waiting
+            stats.resumes++;
+            waiter.handle.resume();
+        }
+        waiters.clear();
+    }
+
+    size_t CoroutineScheduler::GetMemoryBytes() const {
+        return CapacityBytes(frameWaiters) + CapacityBytes(layoutWaiters) + CapacityBytes(resuming)
+             + CapacityBytes(timers) + CapacityBytes(inbox->ready)
+             + tasks.size() * (sizeof(uint64_t) + sizeof(UiTask) + sizeof(void*));
+    }
+
+    void CoroutineScheduler::WaitFrame(const UiTask::Handle handle) {
+        frameWaiters.push_back({handle, handle.promise().id});
+        frames.RequestFrame(FrameWork::Resume);
+    }
+
+    void CoroutineScheduler::WaitLayout(const UiTask::Handle handle) {
+        layoutWaiters.push_back({handle, handle.promise().id});
+        if (!inFrame) frames.RequestFrame(FrameWork::Resume);
+    }
+
+    void CoroutineScheduler::WaitUntil(const UiTask::Handle handle, const Clock::time_point due) {
+        timers.push_back({due, nextSequence++, {handle, handle.promise().id}});
+        std::push_heap(timers.begin(), timers.end(), TimerLater);
+        frames.RequestFrameAt(due, FrameWork::Resume);
+    }
+
+    void CoroutineScheduler::WaitTransition(const UiTask::Handle handle, TransitionManager& manager,
+                                            const AnimatableProperty property) {
+        manager.WhenFinished(property, [weak = std::weak_ptr<Inbox>(inbox), waiter = Waiter{handle, handle.promise().id}] {
+            const auto box = weak.lock();
+            if (!box) return;     // Scheduler gone
+            box->ready.push_back(waiter);
+            if (!box->collecting) box->frames->RequestFrame(FrameWork::Resume);
+        });
+    }
+
+    void CoroutineScheduler::Finish(const uint64_t id) {
+        const auto it = tasks.find(id);
+        if (it == tasks.end()) return;
+
+        UiTask task = std::move(it->second);
+        tasks.erase(it);
+        stats.completed++;
+        stats.running = tasks.size();
+    }
+}
@@ -0,0 +1,146 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Components/ImageElement.hpp"
+
+#include "Lithos/Core/Window.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+
+#include <cmath>
+
+namespace Lithos {
+    ImageElement::ImageElement() {
+        customPaint = true;
+    }
+
+    ImageElement::ImageElement(const std::string_view source) : ImageElement() {
+        this->source(source);
+    }
+
+    ImageElement& ImageElement::source(const std::string_view path) {
+        if (key.source == path) return *this;
+        key.source = path;
+
+        // A different picture; the old one must not linger while the new one loads
+        image.reset();
+        requestId++;
+        loading = false;
+        failed = false;
+        requested = {};
+        InvalidateLayout();     // Requested from ResolveSize(), once the box is known
+        return *this;
+    }
+
+    ImageElement& ImageElement::fit(const ImageFit mode) {
+        if (key.fit == mode) return *this;
+        key.fit = mode;
+        InvalidateLayout();
+        return *this;
+    }
+
+    ImageElement& ImageElement::placeholderColor(const Color& color) {
+        placeholder = color;
+        if (!image) RequestRepaint();
+        return *this;
+    }
+
+    ImageElement& ImageElement::loader(ImageLoader* l) {
+        if (customLoader == l) return *this;
+        customLoader = l;
+        requested = {};
+        InvalidateLayout();
+        return *this;
+    }
+
+    void ImageElement::Record(DisplayList& list, const Rect& clip) const {
+        if (!isVisible || style.opacity <= 0.0f) return;
+        if (!NeedsLayout() && !subtreeBounds.Intersects(clip)) return;
+
+        list.BeginGroup();
+        FlatTree::RecordBox(list, Rect::FromXYWH(x, y, style.width, style.height), GetBoxPaint());
+
+        const Rect content = GetContentBox();
+        if (image) {
+            // Placed by the source's aspect; the decoded size is rounded
+            const Rect target = ImageLoader::FitRect(content, image->sourceWidth, image->sourceHeight, key.fit);
+            if (target.Intersects(clip)) list.Image(target, image, style.opacity);
+        } else if (placeholder.a > 0.0f && !content.IsEmpty()) {
+            list.FillRect(content, {placeholder.r, placeholder.g, placeholder.b, placeholder.a * style.opacity});
+        }
+
+        RecordChildren(list, clip);
+    }
+
+    void ImageElement::AccountMemory(MemoryReport& report) const {
+        Element::AccountMemory(report);
+
+        // Pixels are shared with the loader's cache and reported there
+        report.Add(MemoryCategory::Images, key.source.capacity() + requested.source.capacity());
+    }
+
+    void ImageElement::ResolveSize() {
+        const Rect content = GetContentBox();
+        key.width = std::max(0, static_cast<int>(std::lround(content.Width())));
+        key.height = std::max(0, static_cast<int>(std::lround(content.Height())));
+        if (!(key == requested)) Request();
+    }
+
+    ImageLoader* ImageElement::GetLoader() const {
+        if (customLoader) return customLoader;
+        return windowPtr ? &windowPtr->GetImageLoader() : nullptr;
+    }
+
+    Rect ImageElement::GetContentBox() const {
+        return {
+            x + style.paddingLeft, y + style.paddingTop,
+            x + style.width - style.paddingRight, y + style.height - style.paddingBottom
+        };
+    }
+
+    void ImageElement::Request() {
+        ImageLoader* l = GetLoader();
+        if (!l || key.source.empty() || key.width <= 0 || key.height <= 0) return;
+
+        requested = key;
+        const uint64_t id = ++requestId;
+        auto cached = l->Load(key, [handle = weak_from_this(), id](const std::shared_ptr<const DecodedImage>& result) {
+            if (const auto self = handle.lock()) {
+                static_cast<ImageElement&>(*self).Deliver(id, result);
+            }
+        });
+
+        if (cached) {
+            // Still inside layout; the frame's paint picks it up
+            image = std::move(cached);
+            loading = false;
+            failed = false;
+            MarkFlatDirty();
+        } else {
+            loading = true;
+        }
+    }
+
+    void ImageElement::Deliver(const uint64_t request, const std::shared_ptr<const DecodedImage>& result) {
+        if (request != requestId) return;
+
+        loading = false;
+        failed = !result;
+        image = result;
+
+        // Nothing moves, so the element's own pixels are all that change
+        RequestRepaint(GetWindowPaintBounds());
+    }
+}
@@ -0,0 +1,171 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Components/ScrollView.hpp"
+
+#include "Lithos/Core/Event.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Lithos {
+    namespace {
+        /// Wheel delta of one notch (WHEEL_DELTA)
+        constexpr float WheelNotch = 120.0f;
+
+        /// Time constant of smooth scrolling: ~95% of the way after three
+        constexpr float SmoothTime = 0.05f;
+
+        /// Assumed length of the first frame of a motion, before a previous tick exists
+        constexpr float NominalFrame = 1.0f / 60.0f;
+
+        /// Longest step simulated at once, so a stalled frame doesn't teleport
+        constexpr float MaxFrame = 0.1f;
+
+        constexpr float SettleDistance = 0.25f;     ///< Pixels
+        constexpr float SettleVelocity = 5.0f;      ///< Pixels per second
+    }
+
+    ScrollView::ScrollView() {
+        clipsChildren = true;
+    }
+
+    ScrollView& ScrollView::ScrollTo(const float offsetX, const float offsetY, const bool smooth) {
+        targetX = std::clamp(offsetX, 0.0f, GetMaxScrollX());
+        targetY = std::clamp(offsetY, 0.0f, GetMaxScrollY());
+
+        if (smooth) {
+            Start(Motion::Smooth);
+        } else {
+            motion = Motion::None;
+            SetScrollOffset(targetX, targetY);
+        }
+        return *this;
+    }
+
+    ScrollView& ScrollView::ScrollBy(const float dx, const float dy, const bool smooth) {
+        // Continue from the pending target so quick wheel notches add up
+        const float fromX = motion == Motion::Smooth ? targetX : scrollX;
+        const float fromY = motion == Motion::Smooth ? targetY : scrollY;
+        return ScrollTo(fromX + dx, fromY + dy, smooth);
+    }
+
+    void ScrollView::Fling(const float vx, const float vy) {
+        velocityX = vx;
+        velocityY = vy;
+        Start(Motion::Inertial);
+    }
+
+    void ScrollView::StopScrolling() {
+        motion = Motion::None;
+        velocityX = velocityY = 0.0f;
+        targetX = scrollX;
+        targetY = scrollY;
+    }
+
+    ScrollView& ScrollView::scrollStep(const float pixels) {
+        step = pixels;
+        return *this;
+    }
+
+    ScrollView& ScrollView::friction(const float rate) {
+        decay = std::max(rate, 0.01f);
+        return *this;
+    }
+
+    float ScrollView::GetMaxScrollX() const {
+        return std::max(0.0f, x + contentWidth - GetClipRect().right);
+    }
+
+    float ScrollView::GetMaxScrollY() const {
+        return std::max(0.0f, y + contentHeight - GetClipRect().bottom);
+    }
+
+    bool ScrollView::OnMouseEvent(const MouseEvent evt) {
+        if (evt.type != MouseEventType::MouseWheel || evt.wheelDelta == 0) return false;
+
+        // Positive delta rolls the wheel away from the user: content moves down
+        const float dy = -static_cast<float>(evt.wheelDelta) / WheelNotch * step;
+        const float from = motion == Motion::Smooth ? targetY : scrollY;
+
+        // At the edge the wheel belongs to an enclosing scroller
+        if (std::clamp(from + dy, 0.0f, GetMaxScrollY()) == from) return false;
+
+        ScrollBy(0.0f, dy, true);
+        return true;
+    }
+
+    bool ScrollView::Animate(const std::chrono::steady_clock::time_point now) {
+        if (motion == Motion::None) return false;
+
+        float dt = NominalFrame;
+        if (lastTick != std::chrono::steady_clock::time_point{}) {
+            dt = std::min(std::chrono::duration<float>(now - lastTick).count(), MaxFrame);
+        }
+        lastTick = now;
+        if (dt <= 0.0f) return true;
+
+        const float maxX = GetMaxScrollX();
+        const float maxY = GetMaxScrollY();
+        float nextX = scrollX;
+        float nextY = scrollY;
+
+        if (motion == Motion::Smooth) {
+            targetX = std::clamp(targetX, 0.0f, maxX);
+            targetY = std::clamp(targetY, 0.0f, maxY);
+
+            const float t = 1.0f - std::exp(-dt / SmoothTime);
+            nextX += (targetX - nextX) * t;
+            nextY += (targetY - nextY) * t;
+
+            if (std::abs(targetX - nextX) < SettleDistance && std::abs(targetY - nextY) < SettleDistance) {
+                nextX = targetX;
+                nextY = targetY;
+                motion = Motion::None;
+            }
+        } else {
+            // Exact integral of v(t) = v0 * e^(-decay * t) over the frame
+            const float keep = std::exp(-decay * dt);
+            nextX += velocityX * (1.0f - keep) / decay;
+            nextY += velocityY * (1.0f - keep) / decay;
+            velocityX *= keep;
+            velocityY *= keep;
+
+            // Hitting an edge kills the motion along that axis
+            if (nextX <= 0.0f || nextX >= maxX) velocityX = 0.0f;
+            if (nextY <= 0.0f || nextY >= maxY) velocityY = 0.0f;
+            nextX = std::clamp(nextX, 0.0f, maxX);
+            nextY = std::clamp(nextY, 0.0f, maxY);
+
+            if (std::abs(velocityX) < SettleVelocity && std::abs(velocityY) < SettleVelocity) {
+                StopScrolling();
+            }
+            targetX = nextX;
+            targetY = nextY;
+        }
+
+        SetScrollOffset(nextX, nextY);
+        return motion != Motion::None;
+    }
+
+    void ScrollView::Start(const Motion m) {
+        if (motion == Motion::None) {
+            lastTick = {};
+        }
+        motion = m;
+        RequestAnimationFrame();
+    }
+}
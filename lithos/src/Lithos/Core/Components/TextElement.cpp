@@ -0,0 +1,282 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Components/TextElement.hpp"
+
+#include "Lithos/Core/Render/DisplayList.hpp"
+#ifdef _WIN32
+    #include "Lithos/Core/Render/DeviceResources.hpp"
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace Lithos {
+    namespace {
+        /// Average advance of a proportional UI font, as a fraction of its size
+        constexpr float EstimatedAdvance = 0.55f;
+
+        /**
+         * Drops the '\r' of a CRLF line ending; it belongs to the text but not to what is shown
+         */
+        std::wstring_view VisiblePart(std::wstring_view line) {
+            if (!line.empty() && line.back() == L'\r') line.remove_suffix(1);
+            return line;
+        }
+    }
+
+    TextElement::TextElement() : measuredFontSize(style.fontSize) {
+        customPaint = true;
+    }
+
+    TextElement::TextElement(const std::wstring_view text) : TextElement() {
+        SetText(text);
+    }
+
+    TextElement& TextElement::SetText(const std::wstring_view text) {
+        buffer.SetText(text);
+
+        // Measure straight from the source instead of going through the buffer per line
+        lineWidths.clear();
+        lineWidths.reserve(buffer.LineCount());
+        maxWidth = 0.0f;
+        maxWidthStale = false;
+        for (size_t start = 0;;) {
+            const size_t end = std::min(text.find(L'\n', start), text.size());
+            const float w = Measure(text.substr(start, end - start));
+            lineWidths.push_back(w);
+            maxWidth = std::max(maxWidth, w);
+            if (end == text.size()) break;
+            start = end + 1;
+        }
+        stats.linesMeasured += lineWidths.size();
+        measuredFontSize = style.fontSize;
+
+        TextChanged();
+        return *this;
+    }
+
+    TextElement& TextElement::AppendText(const std::wstring_view text) {
+        return InsertText(buffer.Length(), text);
+    }
+
+    TextElement& TextElement::InsertText(size_t offset, const std::wstring_view text) {
+        if (text.empty()) return *this;
+        offset = std::min(offset, buffer.Length());
+
+        const size_t line = buffer.LineOf(offset);
+        const auto breaks = static_cast<size_t>(std::count(text.begin(), text.end(), L'\n'));
+        buffer.Insert(offset, text);
+
+        // The line the text went into becomes breaks + 1 lines
+        Remeasure(line, 1, breaks + 1);
+        TextChanged();
+        return *this;
+    }
+
+    TextElement& TextElement::EraseText(const size_t offset, size_t count) {
+        const size_t length = buffer.Length();
+        if (offset >= length || count == 0) return *this;
+        count = std::min(count, length - offset);
+
+        const size_t first = buffer.LineOf(offset);
+        const size_t last = buffer.LineOf(offset + count);
+        buffer.Erase(offset, count);
+
+        // Lines first..last join into one
+        Remeasure(first, last - first + 1, 1);
+        TextChanged();
+        return *this;
+    }
+
+    TextElement& TextElement::font(const std::wstring_view f) {
+        if (family == f) return *this;
+        family = f;
+        MeasureAll();
+        TextChanged();
+        return *this;
+    }
+
+    TextElement& TextElement::fontSize(const float size) {
+        style.fontSize = std::max(size, 0.0f);
+        InvalidateLayout();     // Re-measured in ResolveSize()
+        return *this;
+    }
+
+    TextElement& TextElement::textColor(const Color& color) {
+        style.textColor = color;
+        RequestRepaint();
+        return *this;
+    }
+
+    TextElement& TextElement::lineHeight(const float pixels) {
+        fixedLineHeight = std::max(pixels, 0.0f);
+        InvalidateLayout();
+        return *this;
+    }
+
+    TextElement& TextElement::measurer(Measurer m) {
+        measure = std::move(m);
+        MeasureAll();
+        TextChanged();
+        return *this;
+    }
+
+    TextElement& TextElement::width(const float w) {
+        fit = false;
+        return ElementBase::width(w);
+    }
+
+    TextElement& TextElement::fitWidth() {
+        fit = true;
+        InvalidateLayout();
+        return *this;
+    }
+
+#ifdef _WIN32
+    TextElement::Measurer TextElement::DirectWrite(DeviceResources& resources) {
+        return [&resources](const std::wstring_view line, const std::wstring_view f, const float size) {
+            return resources.MeasureText(line, f, size);
+        };
+    }
+#endif
+
+    float TextElement::GetLineHeight() const {
+        return fixedLineHeight > 0.0f ? fixedLineHeight : style.fontSize * DefaultLineSpacing;
+    }
+
+    float TextElement::GetTextWidth() const {
+        if (maxWidthStale) {
+            maxWidth = lineWidths.empty() ? 0.0f : *std::ranges::max_element(lineWidths);
+            maxWidthStale = false;
+        }
+        return maxWidth;
+    }
+
+    void TextElement::Record(DisplayList& list, const Rect& clip) const {
+        if (!isVisible || style.opacity <= 0.0f) return;
+        if (!NeedsLayout() && !subtreeBounds.Intersects(clip)) return;
+
+        list.BeginGroup();
+        FlatTree::RecordBox(list, Rect::FromXYWH(x, y, style.width, style.height), GetBoxPaint());
+
+        const float lh = GetLineHeight();
+        const float top = y + style.paddingTop;
+        const Rect content{
+            x + style.paddingLeft, top,
+            x + style.width - style.paddingRight, y + style.height - style.paddingBottom
+        };
+        const Rect visible = content.Intersect(clip);
+
+        if (!visible.IsEmpty() && lh > 0.0f) {
+            const size_t lines = buffer.LineCount();
+            const size_t first = static_cast<size_t>(std::max(0.0f, std::floor((visible.top - top) / lh)));
+            const size_t last = std::min(lines, static_cast<size_t>(std::max(0.0f, std::ceil((visible.bottom - top) / lh))));
+
+            const Color color{style.textColor.r, style.textColor.g, style.textColor.b, style.textColor.a * style.opacity};
+            const uint8_t flags = (animatedColors & AnimatedColor::Text) ? DrawCommandFlags::AnimatedColor : uint8_t{0};
+
+            std::wstring text;
+            size_t offset = buffer.LineStart(first);
+            for (size_t line = first; line < last; ++line) {
+                const size_t next = buffer.LineStart(line + 1);
+                const size_t length = next - offset - (line + 1 < lines ? 1 : 0);
+
+                text.clear();
+                buffer.CopyText(offset, length, text);
+                const float lineTop = top + static_cast<float>(line) * lh;
+                list.Text({content.left, lineTop, content.right, lineTop + lh}, VisiblePart(text), family,
+                          style.fontSize, color, flags);
+                offset = next;
+            }
+        }
+
+        RecordChildren(list, clip);
+    }
+
+    void TextElement::AccountMemory(MemoryReport& report) const {
+        Element::AccountMemory(report);
+        report.Add(MemoryCategory::Text,
+                   buffer.GetMemoryBytes() + CapacityBytes(lineWidths) + family.capacity() * sizeof(wchar_t));
+    }
+
+    void TextElement::ResolveSize() {
+        if (style.fontSize != measuredFontSize) {
+            MeasureAll();
+        }
+        style.height = FittedHeight();
+        if (fit) style.width = FittedWidth();
+    }
+
+    float TextElement::Measure(const std::wstring_view line) {
+        const std::wstring_view shown = VisiblePart(line);
+        if (measure) return measure(shown, family, style.fontSize);
+        return static_cast<float>(shown.size()) * style.fontSize * EstimatedAdvance;
+    }
+
+    float TextElement::MeasureLine(const size_t line) {
+        std::wstring text;
+        buffer.CopyText(buffer.LineStart(line), buffer.LineLength(line), text);
+        return Measure(text);
+    }
+
+    void TextElement::MeasureAll() {
+        measuredFontSize = style.fontSize;
+        lineWidths.clear();
+        maxWidth = 0.0f;
+        maxWidthStale = false;
+        Remeasure(0, 0, buffer.LineCount());
+    }
+
+    void TextElement::Remeasure(const size_t first, const size_t removed, const size_t added) {
+        const auto at = lineWidths.begin() + static_cast<ptrdiff_t>(first);
+        if (!maxWidthStale && std::any_of(at, at + static_cast<ptrdiff_t>(removed),
+                                          [&](const float w) { return w >= maxWidth; })) {
+            maxWidthStale = true;
+        }
+
+        if (added > removed) {
+            lineWidths.insert(at + static_cast<ptrdiff_t>(removed), added - removed, 0.0f);
+        } else {
+            lineWidths.erase(at + static_cast<ptrdiff_t>(added), at + static_cast<ptrdiff_t>(removed));
+        }
+
+        for (size_t line = first; line < first + added; ++line) {
+            const float w = MeasureLine(line);
+            lineWidths[line] = w;
+            if (!maxWidthStale) maxWidth = std::max(maxWidth, w);
+        }
+        stats.linesMeasured += added;
+    }
+
+    float TextElement::FittedWidth() const {
+        return GetTextWidth() + style.paddingLeft + style.paddingRight;
+    }
+
+    float TextElement::FittedHeight() const {
+        return static_cast<float>(buffer.LineCount()) * GetLineHeight() + style.paddingTop + style.paddingBottom;
+    }
+
+    void TextElement::TextChanged() {
+        if (style.height != FittedHeight() || (fit && style.width != FittedWidth())) {
+            stats.sizeChanges++;
+            InvalidateLayout();
+        } else {
+            stats.repaints++;
+            RequestRepaint();
+        }
+    }
+}
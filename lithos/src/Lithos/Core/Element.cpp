@@ -1,3 +1,752 @@
-//
-// Created by main on 2026/01/30.
-//
\ No newline at end of file
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Lithos/Core/Element.hpp"
+
+#include "Lithos/Core/Event.hpp"
+#include "Lithos/Core/Window.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+#ifdef _WIN32
+    #include "Lithos/Core/Render/DeviceResources.hpp"
+#endif
+
+#include <cmath>
+#include <limits>
+
+namespace Lithos {
+    namespace {
+        /// Unordered child lists at least this long get a grid index for hit testing
+        constexpr size_t ChildIndexThreshold = 32;
+
+        /// shared_ptr control block: vtable pointer plus the two reference counts
+        constexpr size_t ControlBlockBytes = 2 * sizeof(void*);
+
+#ifdef _WIN32
+        Color WithOpacity(const Color& c, const float opacity) {
+            return {c.r, c.g, c.b, c.a * opacity};
+        }
+#endif
+    }
+
+    Element::Element()
+        : windowPtr(nullptr),
+          x(0.0f),
+          y(0.0f) {}
+
+    Element::~Element() {
+        // Children kept alive elsewhere must not point back at us or their siblings
+        for (const auto& child : children) {
+            if (child->parent != this) continue;
+            child->parent = nullptr;
+            child->prevSibling = child->nextSibling = nullptr;
+        }
+    }
+
+    // ========== Child management ==========
+    std::shared_ptr<Element> Element::RemoveChild(Element& child) {
+        if (child.parent != this) return nullptr;
+
+        auto handle = child.shared_from_this();
+        DetachChild(child);
+        if (child.windowPtr) child.SetWindow(nullptr);
+        ChildrenChanged();
+        return handle;
+    }
+
+    void Element::MoveChild(Element& child, Element* before) {
+        if (child.parent != this || before == &child) return;
+        if (before && before->parent != this) before = nullptr;
+        if (child.nextSibling == before) return;
+
+        Unlink(child);
+        Link(child, before);
+        childrenStale = true;
+        ChildrenChanged();
+    }
+
+    void Element::ClearChildren() {
+        if (!firstChild) return;
+
+        for (Element* child = firstChild; child;) {
+            Element* next = child->nextSibling;
+            child->parent = nullptr;
+            child->prevSibling = child->nextSibling = nullptr;
+            if (child->windowPtr) child->SetWindow(nullptr);
+            child = next;
+        }
+        firstChild = lastChild = nullptr;
+        childCount = 0;
+        childrenStale = false;
+        children.clear();
+        ChildrenChanged();
+    }
+
+    void Element::Reparent(Element& newParent, Element* before) {
+        newParent.InsertChild(shared_from_this(), before);
+    }
+
+    bool Element::AttachChild(std::shared_ptr<Element> child, Element* before) {
+        Element& c = *child;
+        if (before && before->parent != this) before = nullptr;
+
+        if (c.parent == this) {
+            // Already ours; only the order changes
+            if (before == &c || c.nextSibling == before) return true;
+            Unlink(c);
+            Link(c, before);
+            childrenStale = true;
+            return true;
+        }
+
+        // Under itself or a descendant, child would hold the last reference to its own ancestors
+        for (const Element* e = this; e; e = e->parent) {
+            if (e == &c) return false;
+        }
+
+        if (Element* old = c.parent) {
+            old->DetachChild(c);
+            old->ChildrenChanged();
+        }
+        Link(c, before);
+        if (c.windowPtr != windowPtr) c.SetWindow(windowPtr);
+
+        if (before) childrenStale = true;
+        c.indexInParent = static_cast<uint32_t>(children.size());
+        children.push_back(std::move(child));
+        return true;
+    }
+
+    void Element::DetachChild(Element& child) {
+        Unlink(child);
+
+        // Swap-and-pop: the reference goes now, only the order waits for SyncChildren()
+        const uint32_t slot = child.indexInParent;
+        if (slot + 1 != children.size()) {
+            children[slot].swap(children.back());
+            children[slot]->indexInParent = slot;
+            childrenStale = true;
+        }
+        children.pop_back();
+    }
+
+    void Element::Link(Element& child, Element* before) {
+        child.parent = this;
+        child.nextSibling = before;
+        child.prevSibling = before ? before->prevSibling : lastChild;
+        (child.prevSibling ? child.prevSibling->nextSibling : firstChild) = &child;
+        (before ? before->prevSibling : lastChild) = &child;
+        childCount++;
+    }
+
+    void Element::Unlink(Element& child) {
+        (child.prevSibling ? child.prevSibling->nextSibling : firstChild) = child.nextSibling;
+        (child.nextSibling ? child.nextSibling->prevSibling : lastChild) = child.prevSibling;
+        child.parent = nullptr;
+        child.prevSibling = child.nextSibling = nullptr;
+        childCount--;
+    }
+
+    void Element::ChildrenChanged() {
+        structureDirty = true;
+        InvalidateLayout();
+    }
+
+    void Element::SyncChildren() {
+        if (!childrenStale) return;
+
+        // `children` holds exactly the linked children, each at its indexInParent slot
+        std::vector<std::shared_ptr<Element>> ordered;
+        ordered.reserve(children.capacity());
+        for (Element* child = firstChild; child; child = child->nextSibling) {
+            ordered.push_back(std::move(children[child->indexInParent]));
+            child->indexInParent = static_cast<uint32_t>(ordered.size() - 1);
+        }
+        children.swap(ordered);
+        childrenStale = false;
+    }
+
+    void Element::SetWindow(Window* window) {
+        if (windowPtr) windowPtr->UntrackElement(*this);
+        windowPtr = window;
+        if (window) window->TrackElement(*this);
+        for (Element* child = firstChild; child; child = child->nextSibling) {
+            if (child->windowPtr != window) child->SetWindow(window);
+        }
+    }
+
+    // ========== Memory ==========
+    void Element::AccountMemory(MemoryReport& report) const {
+        report.elements++;
+        report.Add(MemoryCategory::Elements, ObjectSize() - sizeof(Style) - sizeof(Geometry) + ControlBlockBytes);
+        report.Add(MemoryCategory::Styles, sizeof(Style));
+        report.Add(MemoryCategory::Geometry, sizeof(Geometry));
+        report.Add(MemoryCategory::Children, CapacityBytes(children));
+        if (listeners) {
+            report.Add(MemoryCategory::Listeners, sizeof(ListenerList) + listeners->entries.size() * sizeof(Listener));
+        }
+        report.Add(MemoryCategory::Layout, CapacityBytes(childReach));
+        if (childIndex) {
+            report.Add(MemoryCategory::Layout, sizeof(SpatialIndex) + childIndex->GetMemoryBytes());
+        }
+    }
+
+    void Element::AccountSubtreeMemory(MemoryReport& report) const {
+        AccountMemory(report);
+        for (const Element* child = firstChild; child; child = child->nextSibling) {
+            child->AccountSubtreeMemory(report);
+        }
+    }
+
+    // ========== Styling ==========
+    Element& Element::width(const float w) {
+        style.width = w;
+        InvalidateLayout();
+        return *this;
+    }
+
+    Element& Element::height(const float h) {
+        style.height = h;
+        InvalidateLayout();
+        return *this;
+    }
+
+    Element& Element::opacity(const float o) {
+        style.opacity = std::clamp(o, 0.0f, 1.0f);
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::visible(const bool v) {
+        isVisible = v;
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::backgroundColor(const Color& color) {
+        style.backgroundColor = color;
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::borderColor(const Color& color) {
+        style.borderColor = color;
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::boxShadow(const float offsetX, const float offsetY, const float blur, const Color c) {
+        style.shadowOffsetX = offsetX;
+        style.shadowOffsetY = offsetY;
+        style.shadowBlur    = blur;
+        style.shadowColor   = c;
+        style.shadowEnabled = true;
+        InvalidateLayout(); // Shadow extent feeds the subtree bounds
+        return *this;
+    }
+
+    Element& Element::borderWidth(const float w) {
+        style.borderWidth = w;
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::borderRadius(const float r) {
+        style.borderRadius = r;
+        RequestRepaint();
+        return *this;
+    }
+
+    Element& Element::margin(const float all) {
+        return margin(all, all, all, all);
+    }
+
+    Element& Element::margin(const float tb, const float lr) {
+        return margin(tb, lr, tb, lr);
+    }
+
+    Element& Element::margin(const float top, const float right, const float bottom, const float left) {
+        style.marginTop    = top;
+        style.marginRight  = right;
+        style.marginBottom = bottom;
+        style.marginLeft   = left;
+        InvalidateLayout();
+        return *this;
+    }
+
+    Element& Element::padding(const float all) {
+        return padding(all, all, all, all);
+    }
+
+    Element& Element::padding(const float tb, const float lr) {
+        return padding(tb, lr, tb, lr);
+    }
+
+    Element& Element::padding(const float top, const float right, const float bottom, const float left) {
+        style.paddingTop    = top;
+        style.paddingRight  = right;
+        style.paddingBottom = bottom;
+        style.paddingLeft   = left;
+        InvalidateLayout();
+        return *this;
+    }
+
+    Element& Element::cursor(const CursorType c) {
+        style.cursor = c;
+        return *this;
+    }
+
+    // ========== Events ==========
+    bool Element::OnMouseEvent(const MouseEvent evt) {
+        // Routing is done by EventDispatcher
+        (void)evt;
+        return false;
+    }
+
+    uint32_t Element::AddEventListener(const MouseEventType type, EventListener listener, const bool capture) {
+        if (!listeners) {
+            listeners = std::make_unique<ListenerList>();
+        }
+
+        ListenerList& list = *listeners;
+        if (list.hasRemoved && list.dispatching == 0) {
+            std::erase_if(list.entries, [](const Listener& l) { return l.id == 0; });
+            list.hasRemoved = false;
+        }
+
+        const uint32_t id = list.nextId++;
+        list.entries.push_back({std::move(listener), id, type, capture});
+        return id;
+    }
+
+    void Element::RemoveEventListener(const uint32_t id) {
+        if (!listeners || id == 0) return;
+
+        ListenerList& list = *listeners;
+        for (Listener& l : list.entries) {
+            if (l.id != id) continue;
+
+            // A running callback can't be destroyed; drop it once dispatch unwinds
+            l.id = 0;
+            list.hasRemoved = true;
+            break;
+        }
+        if (list.dispatching == 0) {
+            std::erase_if(list.entries, [](const Listener& l) { return l.id == 0; });
+            list.hasRemoved = false;
+        }
+    }
+
+    void Element::InvokeListeners(MouseEvent& evt, const bool capture) {
+        if (!listeners) return;
+
+        ListenerList& list = *listeners;
+        list.dispatching++;
+
+        // Snapshot the count: listeners added from a callback wait for the next event
+        const size_t count = list.entries.size();
+        for (size_t i = 0; i < count && !evt.immediatePropagationStopped; ++i) {
+            Listener& l = list.entries[i];
+            if (l.id != 0 && l.type == evt.type && l.capture == capture) {
+                l.callback(evt);
+            }
+        }
+
+        if (--list.dispatching == 0 && list.hasRemoved) {
+            std::erase_if(list.entries, [](const Listener& l) { return l.id == 0; });
+            list.hasRemoved = false;
+        }
+    }
+
+    bool Element::HitTest(const float px, const float py) const {
+        if (!geometry.IsEmpty()) {
+            return geometry.ContainsPointFast(px, py) && geometry.ContainsPoint(px, py);
+        }
+        return px >= x && px <= x + style.width && py >= y && py <= y + style.height;
+    }
+
+    Element* Element::FindElementAt(const float px, const float py) {
+        if (!isVisible) return nullptr;
+        if (!NeedsLayout() && !subtreeBounds.Contains(px, py)) return nullptr;
+        SyncChildren();
+
+        // Children of a scrolling element live in content coordinates
+        const bool reachesChildren = !clipsChildren || GetClipRect().Contains(px, py);
+        const float cx = clipsChildren ? px + scrollX : px;
+        const float cy = clipsChildren ? py + scrollY : py;
+
+        if (!reachesChildren) {
+            // Clipped away; only this element can be hit
+        } else if (childIndex && !NeedsLayout()) {
+            // Shared stack of candidates; each level appends its own and pops them on the way out
+            thread_local std::vector<uint32_t> candidates;
+            const size_t base = candidates.size();
+            childIndex->Query(cx - x, cy - y, candidates);
+
+            Element* hit = nullptr;
+            for (size_t k = base; k < candidates.size() && !hit; ++k) {
+                hit = children[candidates[k]]->FindElementAt(cx, cy);
+            }
+            candidates.resize(base);
+            if (hit) return hit;
+        } else {
+            const auto [first, last] = ChildRange(Rect(cx, cy, cx, std::nextafter(cy, std::numeric_limits<float>::infinity())));
+            for (size_t i = last; i-- > first;) {
+                if (Element* hit = children[i]->FindElementAt(cx, cy)) return hit;
+            }
+        }
+
+        return HitTest(px, py) ? this : nullptr;
+    }
+
+    // ========== Rendering ==========
+#ifdef _WIN32
+    void Element::Draw(ID2D1DeviceContext* rt, const Rect& clip) {
+        if (!isVisible || style.opacity <= 0.0f) return;
+        if (!NeedsLayout() && !subtreeBounds.Intersects(clip)) return;
+        SyncChildren();
+
+        const float w = style.width;
+        const float h = style.height;
+        const float radius = std::min(style.borderRadius, std::min(w, h) * 0.5f);
+
+        if (!windowPtr) return;
+        DeviceResources& resources = windowPtr->GetDeviceResources();
+
+        // Animating colors share one mutable brush so they don't churn the brush cache
+        const auto brushFor = [&](const Color& color, const uint8_t bit) {
+            const Color c = WithOpacity(color, style.opacity);
+            return (animatedColors & bit) ? resources.GetAnimatedBrush(rt, c) : resources.GetSolidBrush(rt, c);
+        };
+
+        if (style.shadowEnabled) {
+            resources.DrawShadow(
+                rt,
+                x + style.shadowOffsetX,
+                y + style.shadowOffsetY,
+                w, h, radius,
+                style.shadowBlur,
+                WithOpacity(style.shadowColor, style.opacity),
+                (animatedColors & AnimatedColor::Shadow) != 0
+            );
+        }
+
+        const D2D1_RECT_F rect = D2D1::RectF(x, y, x + w, y + h);
+
+        if (style.backgroundColor.a > 0.0f) {
+            ID2D1SolidColorBrush* brush = brushFor(style.backgroundColor, AnimatedColor::Background);
+
+            if (radius > 0.0f) {
+                rt->FillRoundedRectangle(D2D1::RoundedRect(rect, radius, radius), brush);
+            } else {
+                rt->FillRectangle(rect, brush);
+            }
+        }
+
+        if (style.borderWidth > 0.0f && style.borderColor.a > 0.0f) {
+            ID2D1SolidColorBrush* brush = brushFor(style.borderColor, AnimatedColor::Border);
+
+            // Stroke is centred on the path, so inset by half the width to stay inside the box
+            const float inset = style.borderWidth * 0.5f;
+            const D2D1_RECT_F inner = D2D1::RectF(rect.left + inset, rect.top + inset, rect.right - inset, rect.bottom - inset);
+            if (radius > 0.0f) {
+                rt->DrawRoundedRectangle(D2D1::RoundedRect(inner, radius, radius), brush, style.borderWidth);
+            } else {
+                rt->DrawRectangle(inner, brush, style.borderWidth);
+            }
+        }
+
+        if (clipsChildren) {
+            const Rect viewport = GetClipRect();
+            const Rect contentClip = clip.Intersect(viewport).Offset(scrollX, scrollY);
+            if (contentClip.IsEmpty()) return;
+
+            D2D1::Matrix3x2F transform;
+            rt->GetTransform(&transform);
+            rt->PushAxisAlignedClip(D2D1::RectF(viewport.left, viewport.top, viewport.right, viewport.bottom),
+                                    D2D1_ANTIALIAS_MODE_ALIASED);
+            rt->SetTransform(D2D1::Matrix3x2F::Translation(-scrollX, -scrollY) * transform);
+
+            const auto [first, last] = ChildRange(contentClip);
+            for (size_t i = first; i < last; ++i) {
+                children[i]->Draw(rt, contentClip);
+            }
+
+            rt->SetTransform(transform);
+            rt->PopAxisAlignedClip();
+            return;
+        }
+
+        const auto [first, last] = ChildRange(clip);
+        for (size_t i = first; i < last; ++i) {
+            children[i]->Draw(rt, clip);
+        }
+    }
+#endif
+
+    void Element::Record(DisplayList& list, const Rect& clip) const {
+        if (!isVisible || style.opacity <= 0.0f) return;
+        if (!NeedsLayout() && !subtreeBounds.Intersects(clip)) return;
+
+        list.BeginGroup();
+        FlatTree::RecordBox(list, Rect::FromXYWH(x, y, style.width, style.height), GetBoxPaint());
+
+        if (clipsChildren) {
+            // Scrolling only changes this translation, never the children's layout
+            const Rect viewport = GetClipRect();
+            const Rect contentClip = clip.Intersect(viewport).Offset(scrollX, scrollY);
+            if (contentClip.IsEmpty()) return;
+
+            list.PushClip(viewport);
+            list.PushTranslation(-scrollX, -scrollY);
+
+            RecordChildren(list, contentClip);
+
+            list.PopTranslation();
+            list.PopClip();
+            return;
+        }
+
+        RecordChildren(list, clip);
+    }
+
+    void Element::RecordChildren(DisplayList& list, const Rect& clip) const {
+        if (childrenStale) {
+            // Edited since the last layout; the array can't be trusted but the sibling list can
+            for (const Element* child = firstChild; child; child = child->nextSibling) {
+                child->Record(list, clip);
+            }
+            return;
+        }
+
+        const auto [first, last] = ChildRange(clip);
+        for (size_t i = first; i < last; ++i) {
+            children[i]->Record(list, clip);
+        }
+    }
+
+    void Element::RequestRepaint() {
+        MarkFlatDirty();
+        if (windowPtr) {
+            windowPtr->RequestRepaint();
+        }
+    }
+
+    void Element::RequestRepaint(const Rect& area) {
+        MarkFlatDirty();
+        if (windowPtr) {
+            windowPtr->RequestRepaint(area);
+        }
+    }
+
+    bool Element::Animate(const std::chrono::steady_clock::time_point now) {
+        (void)now;
+        return false;
+    }
+
+    void Element::RequestAnimationFrame() {
+        if (!windowPtr || animationPending) return;
+
+        animationPending = true;
+        windowPtr->RequestAnimationFrame(*this);
+    }
+
+    void Element::MarkFlatDirty() {
+        flatDirty = true;
+        for (Element* p = parent; p && !p->subtreeFlatDirty; p = p->parent) {
+            p->subtreeFlatDirty = true;
+        }
+    }
+
+    BoxPaint Element::GetBoxPaint() const {
+        BoxPaint paint;
+        paint.background = style.backgroundColor;
+        paint.border = style.borderColor;
+        paint.shadow = style.shadowColor;
+        paint.borderWidth = style.borderWidth;
+        paint.borderRadius = style.borderRadius;
+        paint.opacity = style.opacity;
+        paint.shadowOffsetX = style.shadowOffsetX;
+        paint.shadowOffsetY = style.shadowOffsetY;
+        paint.shadowBlur = style.shadowBlur;
+        paint.scrollX = scrollX;
+        paint.scrollY = scrollY;
+        paint.shadowEnabled = style.shadowEnabled;
+        paint.animatedColors = animatedColors;
+        return paint;
+    }
+
+    void Element::SetScrollOffset(const float sx, const float sy) {
+        if (sx == scrollX && sy == scrollY) return;
+
+        scrollX = sx;
+        scrollY = sy;
+        RequestRepaint();
+    }
+
+    void Element::InvalidateLayout() {
+        layoutDirty = true;
+        for (Element* p = parent; p && !p->subtreeLayoutDirty; p = p->parent) {
+            p->subtreeLayoutDirty = true;
+        }
+        RequestRepaint();
+    }
+
+    // ========== Layout ==========
+    void Element::UpdateLayout(const float originX, const float originY) {
+        const float newX = originX + style.left;
+        const float newY = originY + style.top;
+
+        if (!NeedsLayout()) {
+            if (newX != x || newY != y) {
+                Translate(newX - x, newY - y);
+            }
+            return;
+        }
+
+        SyncChildren();
+        ResolveSize();
+        x = newX;
+        y = newY;
+        if (!geometry.IsEmpty()) {
+            geometry.Update(x, y, style.width, style.height);
+        }
+
+        const float contentX = x + style.paddingLeft;
+        float cursorY = y + style.paddingTop;
+
+        subtreeBounds = GetPaintBounds();
+        childReach.resize(children.size());
+        childrenOrdered = true;
+
+        float reach = -std::numeric_limits<float>::infinity();
+        float lastTop = reach;
+        float contentRight = contentX;
+
+        for (size_t i = 0; i < children.size(); ++i) {
+            Element& child = *children[i];
+
+            cursorY += child.style.marginTop;
+            child.UpdateLayout(contentX + child.style.marginLeft, cursorY);
+            cursorY += child.style.height + child.style.marginBottom;
+            contentRight = std::max(contentRight, child.x + child.style.width + child.style.marginRight);
+
+            const Rect& bounds = child.subtreeBounds;
+            if (!bounds.IsEmpty()) {
+                // Clipped children never paint outside this element's own bounds
+                if (!clipsChildren) subtreeBounds = subtreeBounds.Union(bounds);
+                reach = std::max(reach, bounds.bottom);
+                childrenOrdered = childrenOrdered && bounds.top >= lastTop;
+                lastTop = bounds.top;
+            }
+            childReach[i] = reach;
+        }
+        contentWidth = contentRight + style.paddingRight - x;
+        contentHeight = cursorY + style.paddingBottom - y;
+
+        if (!childrenOrdered && children.size() >= ChildIndexThreshold) {
+            const auto local = [&](const size_t i) {
+                const Rect& bounds = children[i]->subtreeBounds;
+                return bounds.IsEmpty() ? Rect{} : bounds.Offset(-x, -y);
+            };
+            if (childIndex && childIndex->Size() == children.size()) {
+                // Same slots: only children whose bounds changed move between cells
+                for (size_t i = 0; i < children.size(); ++i) {
+                    childIndex->Update(static_cast<uint32_t>(i), local(i));
+                }
+            } else {
+                std::vector<Rect> rects(children.size());
+                for (size_t i = 0; i < children.size(); ++i) rects[i] = local(i);
+                if (!childIndex) childIndex = std::make_unique<SpatialIndex>();
+                childIndex->Build(rects);
+            }
+        } else {
+            childIndex.reset();
+        }
+
+        layoutDirty = false;
+        subtreeLayoutDirty = false;
+        MarkFlatDirty();
+    }
+
+    Rect Element::GetPaintBounds() const {
+        const Rect box = Rect::FromXYWH(x, y, style.width, style.height);
+        if (box.IsEmpty()) return {};
+
+        Rect bounds = box;
+        if (style.shadowEnabled) {
+            // Matches the padding DisplayList::Shadow() uses for the blur
+            const float pad = style.shadowBlur * 2.0f + 2.0f;
+            bounds = bounds.Union(box.Offset(style.shadowOffsetX, style.shadowOffsetY).Inflate(pad, pad));
+        }
+        return bounds.Inflate(1.0f, 1.0f);
+    }
+
+    Rect Element::GetWindowPaintBounds() const {
+        Rect bounds = GetPaintBounds();
+        for (const Element* p = parent; p && !bounds.IsEmpty(); p = p->parent) {
+            if (p->clipsChildren) {
+                bounds = bounds.Offset(-p->scrollX, -p->scrollY).Intersect(p->GetClipRect());
+            }
+        }
+        return bounds;
+    }
+
+    Rect Element::GetClipRect() const {
+        const Rect box = Rect::FromXYWH(x, y, style.width, style.height);
+        return style.borderWidth > 0.0f ? box.Inflate(-style.borderWidth, -style.borderWidth) : box;
+    }
+
+    std::pair<size_t, size_t> Element::ChildRange(const Rect& clip) const {
+        if (NeedsLayout() || childReach.size() != children.size()) {
+            return {0, children.size()};
+        }
+
+        // Children before the first whose running bottom passes clip.top can't reach it
+        const size_t first = static_cast<size_t>(
+            std::upper_bound(childReach.begin(), childReach.end(), clip.top) - childReach.begin()
+        );
+        if (!childrenOrdered) {
+            return {first, children.size()};
+        }
+
+        // With ordered tops the remaining children are left once one starts below the clip
+        size_t last = first;
+        while (last < children.size()) {
+            const Rect& bounds = children[last]->subtreeBounds;
+            if (!bounds.IsEmpty() && bounds.top >= clip.bottom) break;
+            ++last;
+        }
+        return {first, last};
+    }
+
+    void Element::Translate(const float dx, const float dy) {
+        x += dx;
+        y += dy;
+        MarkFlatDirty();
+        if (!geometry.IsEmpty()) {
+            geometry.Update(x, y, style.width, style.height);
+        }
+        if (!subtreeBounds.IsEmpty()) {
+            subtreeBounds = subtreeBounds.Offset(dx, dy);
+        }
+        for (float& r : childReach) {
+            r += dy;
+        }
+        for (const auto& child : children) {
+            child->Translate(dx, dy);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/ElementPool.hpp"
+#include <algorithm>
+#include <new>
+
+namespace Lithos {
+    namespace {
+        bool Pooled(const size_t bytes, const size_t alignment) {
+            return bytes <= ElementPool::MaxBlockSize && alignment <= ElementPool::Granularity;
+        }
+
+        size_t ClassOf(const size_t bytes) {
+            return bytes == 0 ? 0 : (bytes - 1) / ElementPool::Granularity;
+        }
+    }
+
+    ElementPool* ElementPool::Create() {
+        return new ElementPool();
+    }
+
+    ElementPool::~ElementPool() {
+        for (void* chunk : chunks) {
+            ::operator delete(chunk, std::align_val_t{Granularity});
+        }
+    }
+
+    void ElementPool::Release() {
+        if (--refs == 0) delete this;
+    }
+
+    void* ElementPool::Allocate(const size_t bytes, const size_t alignment) {
+        void* p;
+        if (!Pooled(bytes, alignment)) {
+            p = ::operator new(bytes, std::align_val_t{std::max(alignment, Granularity)});
+            stats.bytesReserved += bytes;
+            stats.bytesInUse += bytes;
+        } else {
+            const size_t cls = ClassOf(bytes);
+            const size_t size = (cls + 1) * Granularity;
+
+            if (FreeBlock* block = freeLists[cls]) {
+                freeLists[cls] = block->next;
+                p = block;
+            } else {
+                if (static_cast<size_t>(limit - cursor) < size) {
+                    // The tail of the old chunk is abandoned; at most MaxBlockSize per chunk
+                    auto* chunk = static_cast<std::byte*>(::operator new(ChunkSize, std::align_val_t{Granularity}));
+                    chunks.push_back(chunk);
+                    cursor = chunk;
+                    limit = chunk + ChunkSize;
+                    stats.chunks++;
+                    stats.bytesReserved += ChunkSize;
+                }
+                p = cursor;
+                cursor += size;
+            }
+            stats.bytesInUse += size;
+        }
+
+        stats.liveBlocks++;
+        refs++;
+        return p;
+    }
+
+    void ElementPool::Deallocate(void* p, const size_t bytes, const size_t alignment) {
+        if (!p) return;
+
+        if (!Pooled(bytes, alignment)) {
+            ::operator delete(p, std::align_val_t{std::max(alignment, Granularity)});
+            stats.bytesReserved -= bytes;
+            stats.bytesInUse -= bytes;
+        } else {
+            const size_t cls = ClassOf(bytes);
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = freeLists[cls];
+            freeLists[cls] = block;
+            stats.bytesInUse -= (cls + 1) * Granularity;
+        }
+
+        stats.liveBlocks--;
+        Release();
+    }
+}
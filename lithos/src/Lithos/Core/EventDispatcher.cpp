@@ -0,0 +1,109 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/EventDispatcher.hpp"
+
+#include "Lithos/Core/Element.hpp"
+
+namespace Lithos {
+    namespace {
+        /// Deeper than any realistic tree; the buffer still grows if needed
+        constexpr size_t InitialPathCapacity = 64;
+
+        void Enter(Element& element, MouseEvent& evt, const EventPhase phase) {
+            evt.phase = phase;
+            evt.currentTarget = &element;
+        }
+    }
+
+    EventDispatcher::EventDispatcher() {
+        path.reserve(InitialPathCapacity);
+    }
+
+    bool EventDispatcher::Dispatch(Element& target, MouseEvent& evt) {
+        if (evt.type == MouseEventType::MouseEnter || evt.type == MouseEventType::MouseLeave) {
+            return DispatchAtTarget(target, evt);
+        }
+
+        // Own the path so a handler can't free an element we have yet to visit
+        const size_t base = path.size();
+        path.push_back(target.shared_from_this());
+        for (Element* e = target.GetParent(); e; e = e->GetParent()) {
+            path.push_back(e->shared_from_this());
+        }
+        const size_t end = path.size();
+
+        evt.target = &target;
+        evt.propagationStopped = false;
+        evt.immediatePropagationStopped = false;
+
+        // Capture: root down to the parent
+        for (size_t i = end; i-- > base + 1 && !evt.propagationStopped;) {
+            Enter(*path[i], evt, EventPhase::Capturing);
+            path[i]->InvokeListeners(evt, true);
+        }
+
+        // Target: capture listeners, then bubble listeners, then the default handler
+        if (!evt.propagationStopped) {
+            Element& element = *path[base];
+            Enter(element, evt, EventPhase::AtTarget);
+            element.InvokeListeners(evt, true);
+            if (!evt.immediatePropagationStopped) {
+                element.InvokeListeners(evt, false);
+            }
+            if (!evt.immediatePropagationStopped && element.OnMouseEvent(evt)) {
+                evt.propagationStopped = true;
+            }
+        }
+
+        // Bubble: parent back up to the root
+        for (size_t i = base + 1; i < end && !evt.propagationStopped; ++i) {
+            Element& element = *path[i];
+            Enter(element, evt, EventPhase::Bubbling);
+            element.InvokeListeners(evt, false);
+            if (!evt.immediatePropagationStopped && element.OnMouseEvent(evt)) {
+                evt.propagationStopped = true;
+            }
+        }
+
+        evt.phase = EventPhase::None;
+        evt.currentTarget = nullptr;
+        path.resize(base);
+        return evt.propagationStopped;
+    }
+
+    bool EventDispatcher::DispatchAtTarget(Element& target, MouseEvent& evt) {
+        // Keep the element alive across its own handlers
+        const auto keepAlive = target.shared_from_this();
+
+        evt.target = &target;
+        evt.propagationStopped = false;
+        evt.immediatePropagationStopped = false;
+        Enter(target, evt, EventPhase::AtTarget);
+
+        target.InvokeListeners(evt, true);
+        if (!evt.immediatePropagationStopped) {
+            target.InvokeListeners(evt, false);
+        }
+        if (!evt.immediatePropagationStopped && target.OnMouseEvent(evt)) {
+            evt.propagationStopped = true;
+        }
+
+        evt.phase = EventPhase::None;
+        evt.currentTarget = nullptr;
+        return evt.propagationStopped;
+    }
+}
@@ -0,0 +1,292 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/FlatTree.hpp"
+
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace Lithos {
+    namespace {
+        Color WithOpacity(const Color& c, const float opacity) {
+            return {c.r, c.g, c.b, c.a * opacity};
+        }
+    }
+
+    void FlatTree::Sync(Element& rootElement) {
+        if (root != &rootElement || elements.empty() || !Refresh(rootElement) || staleNodes * 4 > elements.size()) {
+            Rebuild(rootElement);
+        }
+    }
+
+    void FlatTree::Rebuild(Element& rootElement) {
+        Clear();
+        root = &rootElement;
+        Append(rootElement, None);
+        stats.rebuilds++;
+    }
+
+    bool FlatTree::IsCurrent(const Element& rootElement) const {
+        return root == &rootElement && !elements.empty()
+            && !rootElement.flatDirty && !rootElement.subtreeFlatDirty && !rootElement.structureDirty;
+    }
+
+    void FlatTree::Clear() {
+        root = nullptr;
+        staleNodes = 0;
+        for (auto* v : {&parents, &subtreeEnds, &childBegin, &childCount, &childList}) v->clear();
+        for (auto* v : {&boxes, &subtreeBounds, &clipRects}) v->clear();
+        elements.clear();
+        childReach.clear();
+        flags.clear();
+        paints.clear();
+        versions.clear();
+        subtreeVersions.clear();
+    }
+
+    size_t FlatTree::GetMemoryBytes() const {
+        size_t bytes = CapacityBytes(elements) + CapacityBytes(childReach) + CapacityBytes(flags) + CapacityBytes(paints)
+                     + CapacityBytes(versions) + CapacityBytes(subtreeVersions);
+        for (const auto* v : {&parents, &subtreeEnds, &childBegin, &childCount, &childList}) bytes += CapacityBytes(*v);
+        for (const auto* v : {&boxes, &subtreeBounds, &clipRects}) bytes += CapacityBytes(*v);
+        return bytes;
+    }
+
+    uint32_t FlatTree::Append(Element& element, const uint32_t parent) {
+        element.SyncChildren();
+        const auto node = static_cast<uint32_t>(elements.size());
+        const auto count = static_cast<uint32_t>(element.children.size());
+        const auto begin = static_cast<uint32_t>(childList.size());
+
+        elements.push_back(&element);
+        parents.push_back(parent);
+        subtreeEnds.push_back(node + 1);
+        childBegin.push_back(begin);
+        childCount.push_back(count);
+        childList.resize(begin + count);
+        childReach.resize(begin + count);
+        flags.push_back(0);
+        boxes.emplace_back();
+        subtreeBounds.emplace_back();
+        clipRects.emplace_back();
+        paints.emplace_back();
+        versions.push_back(0);
+        subtreeVersions.push_back(0);
+
+        element.flatIndex = node;
+        element.structureDirty = false;
+        Store(node, element);
+
+        for (uint32_t k = 0; k < count; ++k) {
+            // Recursion may grow childList; index it afresh
+            childList[begin + k] = Append(*element.children[k], node);
+        }
+        subtreeEnds[node] = static_cast<uint32_t>(elements.size());
+        subtreeVersions[node] = version;
+        element.subtreeFlatDirty = false;
+        return node;
+    }
+
+    void FlatTree::Store(const uint32_t node, Element& element) {
+        uint8_t f = flags[node] & Detached;
+        if (element.isVisible) f |= Visible;
+        if (element.NeedsLayout() || element.childReach.size() != element.children.size()) f |= Unlaid;
+        if (element.childrenOrdered) f |= Ordered;
+        if (element.clipsChildren) f |= ClipsChildren;
+        if (!element.geometry.IsEmpty()) f |= HasGeometry;
+        if (element.customPaint || element.childIndex || (f & Detached)) f |= Delegated;
+        flags[node] = f;
+
+        boxes[node] = Rect::FromXYWH(element.x, element.y, element.style.width, element.style.height);
+        subtreeBounds[node] = element.subtreeBounds;
+        clipRects[node] = element.clipsChildren ? element.GetClipRect() : Rect{};
+        paints[node] = element.GetBoxPaint();
+
+        if (!(f & (Unlaid | Detached))) {
+            std::copy(element.childReach.begin(), element.childReach.end(), childReach.begin() + childBegin[node]);
+        }
+        versions[node] = ++version;
+        subtreeVersions[node] = version;
+        element.flatDirty = false;
+    }
+
+    bool FlatTree::Refresh(Element& element) {
+        if (element.flatIndex >= elements.size() || elements[element.flatIndex] != &element) {
+            return false;
+        }
+        if (element.structureDirty || (flags[element.flatIndex] & Detached)) {
+            Detach(element);
+            return true;
+        }
+
+        const uint64_t before = version;
+        if (element.flatDirty) {
+            Store(element.flatIndex, element);
+            stats.refreshed++;
+        }
+        if (element.subtreeFlatDirty) {
+            for (const auto& child : element.children) {
+                if ((child->flatDirty || child->subtreeFlatDirty || child->structureDirty) && !Refresh(*child)) {
+                    return false;
+                }
+            }
+            element.subtreeFlatDirty = false;
+        }
+        if (version != before) {
+            subtreeVersions[element.flatIndex] = version;
+        }
+        return true;
+    }
+
+    void FlatTree::Detach(Element& element) {
+        // Re-appending the subtree would shift every node after it; the element walks it instead
+        const uint32_t node = element.flatIndex;
+        if (!(flags[node] & Detached)) {
+            flags[node] |= Detached;
+            staleNodes += subtreeEnds[node] - node - 1;
+            stats.detached++;
+        }
+        Store(node, element);
+        element.structureDirty = false;
+
+        // Later changes below must flag the path up to here again
+        const auto clear = [](auto& self, Element& e) -> void {
+            e.subtreeFlatDirty = false;
+            for (Element* child = e.firstChild; child; child = child->nextSibling) {
+                const bool below = child->subtreeFlatDirty;
+                child->flatDirty = false;
+                if (below) self(self, *child);
+            }
+        };
+        if (element.subtreeFlatDirty) clear(clear, element);
+    }
+
+    std::pair<uint32_t, uint32_t> FlatTree::ChildRange(const uint32_t node, const Rect& clip) const {
+        const uint32_t count = childCount[node];
+        if (flags[node] & Unlaid) {
+            return {0, count};
+        }
+
+        // Mirrors Element::ChildRange over the contiguous slice
+        const float* reach = childReach.data() + childBegin[node];
+        const auto first = static_cast<uint32_t>(std::upper_bound(reach, reach + count, clip.top) - reach);
+        if (!(flags[node] & Ordered)) {
+            return {first, count};
+        }
+
+        const uint32_t* list = childList.data() + childBegin[node];
+        uint32_t last = first;
+        while (last < count) {
+            const Rect& bounds = subtreeBounds[list[last]];
+            if (!bounds.IsEmpty() && bounds.top >= clip.bottom) break;
+            ++last;
+        }
+        return {first, last};
+    }
+
+    void FlatTree::Record(DisplayList& list, const Rect& clip) const {
+        if (!elements.empty()) RecordNode(0, list, clip);
+    }
+
+    void FlatTree::RecordNode(const uint32_t node, DisplayList& list, const Rect& clip) const {
+        const uint8_t f = flags[node];
+        if (f & Delegated) {
+            elements[node]->Record(list, clip);
+            return;
+        }
+
+        const BoxPaint& paint = paints[node];
+        if (!(f & Visible) || paint.opacity <= 0.0f) return;
+        if (!(f & Unlaid) && !subtreeBounds[node].Intersects(clip)) return;
+
+        list.BeginGroup();
+        RecordBox(list, boxes[node], paint);
+
+        const uint32_t* children = childList.data() + childBegin[node];
+        if (f & ClipsChildren) {
+            const Rect& viewport = clipRects[node];
+            const Rect contentClip = clip.Intersect(viewport).Offset(paint.scrollX, paint.scrollY);
+            if (contentClip.IsEmpty()) return;
+
+            list.PushClip(viewport);
+            list.PushTranslation(-paint.scrollX, -paint.scrollY);
+            const auto [first, last] = ChildRange(node, contentClip);
+            for (uint32_t k = first; k < last; ++k) {
+                RecordNode(children[k], list, contentClip);
+            }
+            list.PopTranslation();
+            list.PopClip();
+            return;
+        }
+
+        const auto [first, last] = ChildRange(node, clip);
+        for (uint32_t k = first; k < last; ++k) {
+            RecordNode(children[k], list, clip);
+        }
+    }
+
+    Element* FlatTree::FindElementAt(const float x, const float y) const {
+        return elements.empty() ? nullptr : FindNode(0, x, y);
+    }
+
+    Element* FlatTree::FindNode(const uint32_t node, const float x, const float y) const {
+        const uint8_t f = flags[node];
+        if (f & Delegated) {
+            return elements[node]->FindElementAt(x, y);
+        }
+        if (!(f & Visible)) return nullptr;
+        if (!(f & Unlaid) && !subtreeBounds[node].Contains(x, y)) return nullptr;
+
+        const bool clips = (f & ClipsChildren) != 0;
+        if (!clips || clipRects[node].Contains(x, y)) {
+            const float cx = clips ? x + paints[node].scrollX : x;
+            const float cy = clips ? y + paints[node].scrollY : y;
+            const uint32_t* children = childList.data() + childBegin[node];
+            const auto [first, last] = ChildRange(node, Rect(cx, cy, cx, std::nextafter(cy, std::numeric_limits<float>::infinity())));
+            for (uint32_t k = last; k-- > first;) {
+                if (Element* hit = FindNode(children[k], cx, cy)) return hit;
+            }
+        }
+
+        if (f & HasGeometry) {
+            return elements[node]->HitTest(x, y) ? elements[node] : nullptr;
+        }
+        return boxes[node].Contains(x, y) ? elements[node] : nullptr;
+    }
+
+    void FlatTree::RecordBox(DisplayList& list, const Rect& box, const BoxPaint& paint) {
+        const float radius = std::min(paint.borderRadius, std::min(box.Width(), box.Height()) * 0.5f);
+        const auto flagsFor = [&](const uint8_t bit) {
+            return (paint.animatedColors & bit) ? DrawCommandFlags::AnimatedColor : uint8_t{0};
+        };
+
+        if (paint.shadowEnabled) {
+            list.Shadow(box.Offset(paint.shadowOffsetX, paint.shadowOffsetY), radius, paint.shadowBlur,
+                        WithOpacity(paint.shadow, paint.opacity), flagsFor(AnimatedColor::Shadow));
+        }
+
+        list.FillRoundedRect(box, radius, WithOpacity(paint.background, paint.opacity),
+                             flagsFor(AnimatedColor::Background));
+
+        if (paint.borderWidth > 0.0f) {
+            list.StrokeRect(box, radius, paint.borderWidth, WithOpacity(paint.border, paint.opacity),
+                            flagsFor(AnimatedColor::Border));
+        }
+    }
+}
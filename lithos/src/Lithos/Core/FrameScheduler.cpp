@@ -0,0 +1,126 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/FrameScheduler.hpp"
+#include <algorithm>
+
+namespace Lithos {
+    FrameScheduler::FrameScheduler(const Clock::duration interval)
+        : interval(interval) {}
+
+    void FrameScheduler::SetPhase(const FramePhase phase, PhaseHandler handler) {
+        phases[static_cast<size_t>(phase)] = std::move(handler);
+    }
+
+    void FrameScheduler::SetWakeHandler(std::function<void()> handler) {
+        wake = std::move(handler);
+    }
+
+    void FrameScheduler::RequestFrame(const uint8_t work) {
+        if (!work) return;
+        requests.fetch_add(1, std::memory_order_relaxed);
+
+        const uint8_t before = pending.fetch_or(work, std::memory_order_acq_rel);
+        if (before == 0 && !inFrame.load(std::memory_order_acquire)) {
+            wakeups.fetch_add(1, std::memory_order_relaxed);
+            if (wake) wake();
+        }
+    }
+
+    void FrameScheduler::RequestFrameAt(const Clock::time_point at, const uint8_t work) {
+        if (!work) return;
+        if (at < timer) timer = at;
+        timerWork |= work;
+    }
+
+    FrameScheduler::Clock::time_point FrameScheduler::NextFrameTime() const {
+        const Clock::time_point due = started ? anchor + interval : Clock::time_point::min();
+        if (IsIdle()) {
+            // A booking keeps to the cadence too
+            return timer == Clock::time_point::max() ? timer : std::max(timer, due);
+        }
+        return due;
+    }
+
+    bool FrameScheduler::Tick(const Clock::time_point now) {
+        if (now < NextFrameTime()) return false;    // max() while idle with no timer
+        return RunFrame(now);
+    }
+
+    bool FrameScheduler::RunFrame(const Clock::time_point now) {
+        if (inFrame.load(std::memory_order_relaxed)) return false;
+
+        inFrame.store(true, std::memory_order_release);
+        uint8_t work = pending.exchange(0, std::memory_order_acq_rel);
+        if (now >= timer) {
+            // Any frame at or past the booking serves it
+            work |= timerWork;
+            timer = Clock::time_point::max();
+            timerWork = 0;
+        }
+        if (!work) {
+            inFrame.store(false, std::memory_order_release);
+            return false;
+        }
+
+        // Stay on the cadence when on time; after idling or falling a whole interval behind, restart it at `now`
+        const Clock::time_point due = anchor + interval;
+        if (started && now >= due && now - due < interval) {
+            anchor = due;
+        } else {
+            if (started && continuing && now >= due) {
+                stats.missedIntervals += static_cast<uint64_t>((now - due) / interval);
+            }
+            anchor = now;
+        }
+        started = true;
+
+        FrameInfo info;
+        info.frame = ++frameCount;
+        info.time = now;
+        info.deadline = anchor + interval;
+        info.work = work;
+
+        for (size_t i = 0; i < FramePhaseCount; ++i) {
+            if (i == static_cast<size_t>(FramePhase::Paint)) {
+                // Damage from this frame's input, animation and layout is painted now, not a frame later
+                constexpr uint8_t paintWork = FrameWork::Damage | FrameWork::Region;
+                info.work |= pending.fetch_and(static_cast<uint8_t>(~paintWork), std::memory_order_acq_rel) & paintWork;
+            }
+            if (!phases[i]) continue;
+            phases[i](info);
+            stats.phaseRuns[i]++;
+        }
+
+        continuing = !IsIdle();
+        inFrame.store(false, std::memory_order_release);
+        stats.frames++;
+        return true;
+    }
+
+    FrameSchedulerStats FrameScheduler::GetStats() const {
+        FrameSchedulerStats result = stats;
+        result.requests = requests.load(std::memory_order_relaxed);
+        result.wakeups = wakeups.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void FrameScheduler::ResetStats() {
+        stats = {};
+        requests.store(0, std::memory_order_relaxed);
+        wakeups.store(0, std::memory_order_relaxed);
+    }
+}
@@ -14,127 +14,99 @@
     limitations under the License.
  */
 #include "Lithos/Core/Geometry.hpp"
+#include <algorithm>
 #include <numbers>
 
 namespace Lithos {
-    // ========== RectGeometry ==========
-    RectGeometry::RectGeometry(const float x, const float y, const float w, const float h)
-        : x(x), y(y), width(w), height(h) {}
-
-    bool RectGeometry::ContainsPointFast(const float px, const float py) const {
-        return px >= x && px <= x + width && py >= y && py <= y + height;
-    }
-
-    bool RectGeometry::ContainsPoint(const float px, const float py) const {
-        return ContainsPointFast(px, py); // Same for rectangles
+    bool Geometry::ContainsPointFast(const float px, const float py) const {
+        return kind != GeometryKind::None && px >= x && px <= x + width && py >= y && py <= y + height;
     }
 
-    void RectGeometry::GetBounds(float& left, float& top, float& right, float& bottom) const {
-        left = x;
-        top = y;
-        right = x + width;
-        bottom = y + height;
+    bool Geometry::ContainsPoint(const float px, const float py) const {
+        switch (kind) {
+            case GeometryKind::Rect:
+            case GeometryKind::Path:
+                return ContainsPointFast(px, py);
+
+            case GeometryKind::Circle: {
+                const float r = width * 0.5f;
+                const float dx = px - (x + r);
+                const float dy = py - (y + r);
+                return (dx * dx + dy * dy) <= (r * r);
+            }
+
+            case GeometryKind::RoundedRect: {
+                if (!ContainsPointFast(px, py)) return false;
+
+                const float rx = std::min(radiusX, width * 0.5f);
+                const float ry = std::min(radiusY, height * 0.5f);
+                if (rx <= 0.0f || ry <= 0.0f) return true;
+
+                // Distance from the rect the corners are rounded around, normalized by the radii
+                const float dx = (px - std::clamp(px, x + rx, x + width - rx)) / rx;
+                const float dy = (py - std::clamp(py, y + ry, y + height - ry)) / ry;
+                return dx * dx + dy * dy <= 1.0f;
+            }
+
+            default:
+                return false;
+        }
     }
 
-    ID2D1Geometry* RectGeometry::GetD2DGeometry(ID2D1Factory* factory) const {
-        if (cachedGeometry && cachedFactory == factory) {
-            return cachedGeometry.Get();
+    void Geometry::Update(const float newX, const float newY, const float newWidth, const float newHeight) {
+        if (kind == GeometryKind::Circle) {
+            const float side = std::min(newWidth, newHeight);
+            x = newX + (newWidth - side) * 0.5f;
+            y = newY + (newHeight - side) * 0.5f;
+            width = height = side;
+            return;
         }
 
-        cachedFactory = factory;
-        cachedGeometry->Release();
-
-        factory->CreateRectangleGeometry(
-            D2D1::RectF(x, y, x + width, y + height),
-            &cachedGeometry
-        );
-
-        return cachedGeometry.Get();
-    }
-
-    void RectGeometry::Update(const float newX, const float newY, const float newWidth, const float newHeight) {
         x = newX;
         y = newY;
         width = newWidth;
         height = newHeight;
-        cachedGeometry->Release(); // Invalidate cache
-    }
-
-    float RectGeometry::Area() const {
-        return width * height;
-    }
-
-    bool RectGeometry::Intersects(const Geometry& other) const {
-        float ol, ot, or_, ob;
-        other.GetBounds(ol, ot, or_, ob);
-
-        return !(x + width < ol || or_ < x || y + height < ot || ob < y);
     }
 
-    // ========== CircleGeometry ==========
-    CircleGeometry::CircleGeometry(const float cx, const float cy, const float r)
-        : centerX(cx), centerY(cy), radius(r) {}
-
-    bool CircleGeometry::ContainsPointFast(const float px, const float py) const {
-        // Bounding box check
-        return px >= centerX - radius && px <= centerX + radius && py >= centerY - radius && py <= centerY + radius;
-    }
-
-    bool CircleGeometry::ContainsPoint(const float px, const float py) const {
-        const float dx = px - centerX;
-        const float dy = py - centerY;
-        return (dx * dx + dy * dy) <= (radius * radius);
-    }
-
-    void CircleGeometry::GetBounds(float& left, float& top, float& right, float& bottom) const {
-        left = centerX - radius;
-        top = centerY - radius;
-        right = centerX + radius;
-        bottom = centerY + radius;
-    }
-
-    ID2D1Geometry* CircleGeometry::GetD2DGeometry(ID2D1Factory* factory) const {
-        if (cachedGeometry && cachedFactory == factory) {
-            return cachedGeometry.Get();
+    float Geometry::Area() const {
+        switch (kind) {
+            case GeometryKind::None:
+                return 0.0f;
+            case GeometryKind::Circle: {
+                const float r = width * 0.5f;
+                return std::numbers::pi_v<float> * r * r;
+            }
+            case GeometryKind::RoundedRect: {
+                // Each corner loses a (1 - pi/4) fraction of its radius box
+                const float rx = std::min(radiusX, width * 0.5f);
+                const float ry = std::min(radiusY, height * 0.5f);
+                return width * height - (4.0f - std::numbers::pi_v<float>) * rx * ry;
+            }
+            default:
+                return width * height;
         }
-
-        cachedFactory = factory;
-        cachedGeometry->Release();
-
-        factory->CreateEllipseGeometry(
-            D2D1::Ellipse(D2D1::Point2F(centerX, centerY), radius, radius),
-            &cachedGeometry
-        );
-
-        return cachedGeometry.Get();
     }
 
-    void CircleGeometry::Update(const float x, const float y, const float w, const float h) {
-        centerX = x + w / 2.0f;
-        centerY = y + h / 2.0f;
-        radius = std::min(w, h) / 2.0f;
-        cachedGeometry->Release();
-    }
+    bool Geometry::Intersects(const Geometry& other) const {
+        if (kind == GeometryKind::None || other.kind == GeometryKind::None) return false;
 
-    void CircleGeometry::SetRadius(const float r) {
-        radius = r;
-        cachedGeometry->Release();
+        return !(x + width < other.x || other.x + other.width < x || y + height < other.y || other.y + other.height < y);
     }
 
-    float CircleGeometry::Area() const {
-        return std::numbers::pi_v<float> * radius * radius;
-    }
+    void Geometry::SetRadius(const float r) {
+        if (kind != GeometryKind::Circle) return;
 
-    bool CircleGeometry::Intersects(const Geometry& other) const {
-        // Simplified: use bounding boxes
-        float ol, ot, or_, ob;
-        other.GetBounds(ol, ot, or_, ob);
+        const float cx = x + width * 0.5f;
+        const float cy = y + height * 0.5f;
+        x = cx - r;
+        y = cy - r;
+        width = height = r * 2.0f;
+    }
 
-        const float left = centerX - radius;
-        const float top = centerY - radius;
-        const float right = centerX + radius;
-        const float bottom = centerY + radius;
+    void Geometry::SetRadii(const float rx, const float ry) {
+        if (kind != GeometryKind::RoundedRect) return;
 
-        return !(right < ol || or_ < left || bottom < ot || ob < top);
+        radiusX = rx;
+        radiusY = ry;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,234 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/GeometryBatch.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LITHOS_GEOMETRY_SSE2 1
+#endif
+
+namespace Lithos {
+    namespace {
+        constexpr size_t Lanes = 4;
+
+        /// Half extent of padding lanes; no query can reach it
+        constexpr float NeverHit = -1.0e30f;
+    }
+
+    uint32_t GeometryBatch::AddRect(const Rect& rect) {
+        const uint32_t index = Push();
+        SetRoundedRect(index, rect, 0.0f, 0.0f);
+        return index;
+    }
+
+    uint32_t GeometryBatch::AddCircle(const float cx, const float cy, const float radius) {
+        const uint32_t index = Push();
+        Store(index, cx, cy, radius, radius, radius, radius);
+        return index;
+    }
+
+    uint32_t GeometryBatch::AddRoundedRect(const Rect& rect, const float radiusX, const float radiusY) {
+        const uint32_t index = Push();
+        SetRoundedRect(index, rect, radiusX, radiusY);
+        return index;
+    }
+
+    uint32_t GeometryBatch::Add(const Geometry& geometry) {
+        const Rect bounds = geometry.GetBounds();
+        switch (geometry.Kind()) {
+            case GeometryKind::Circle:
+                return AddCircle((bounds.left + bounds.right) * 0.5f, (bounds.top + bounds.bottom) * 0.5f,
+                                 bounds.Width() * 0.5f);
+            case GeometryKind::RoundedRect:
+                return AddRoundedRect(bounds, geometry.GetRadiusX(), geometry.GetRadiusY());
+            default:
+                return AddRect(bounds);
+        }
+    }
+
+    void GeometryBatch::SetRoundedRect(const uint32_t index, const Rect& rect, float radiusX, float radiusY) {
+        const float hw = rect.Width() * 0.5f;
+        const float hh = rect.Height() * 0.5f;
+
+        // A corner with either radius at zero is square
+        radiusX = std::clamp(radiusX, 0.0f, std::max(hw, 0.0f));
+        radiusY = std::clamp(radiusY, 0.0f, std::max(hh, 0.0f));
+        if (radiusX <= 0.0f || radiusY <= 0.0f) {
+            radiusX = radiusY = 0.0f;
+        }
+
+        Store(index, rect.left + hw, rect.top + hh, hw, hh, radiusX, radiusY);
+    }
+
+    void GeometryBatch::Reserve(const size_t n) {
+        const size_t padded = (n + Lanes - 1) / Lanes * Lanes;
+        for (auto* v : {&centerX, &centerY, &halfW, &halfH, &innerW, &innerH, &invRadiusX, &invRadiusY}) {
+            v->reserve(padded);
+        }
+    }
+
+    void GeometryBatch::Clear() {
+        for (auto* v : {&centerX, &centerY, &halfW, &halfH, &innerW, &innerH, &invRadiusX, &invRadiusY}) {
+            v->clear();
+        }
+        count = 0;
+    }
+
+    Rect GeometryBatch::GetBounds(const uint32_t index) const {
+        return {
+            centerX[index] - halfW[index], centerY[index] - halfH[index],
+            centerX[index] + halfW[index], centerY[index] + halfH[index]
+        };
+    }
+
+    template<typename Emit>
+    void GeometryBatch::Run(const Rect& query, const Query kind, Emit&& emit) const {
+        for (size_t base = 0; base < count; base += Lanes) {
+            unsigned bits = Evaluate4(base, query, kind);
+            while (bits) {
+                const unsigned lane = static_cast<unsigned>(std::countr_zero(bits));
+                emit(static_cast<uint32_t>(base + lane));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    void GeometryBatch::ContainsPoint(const float x, const float y, std::vector<uint8_t>& mask) const {
+        mask.assign(count, 0);
+        Run({x, y, x, y}, Query::Overlap, [&](const uint32_t i) { mask[i] = 1; });
+    }
+
+    void GeometryBatch::ContainsPoint(const float x, const float y, std::vector<uint32_t>& indices) const {
+        indices.clear();
+        Run({x, y, x, y}, Query::Overlap, [&](const uint32_t i) { indices.push_back(i); });
+    }
+
+    void GeometryBatch::Intersects(const Rect& rect, std::vector<uint8_t>& mask) const {
+        mask.assign(count, 0);
+        Run(rect, Query::Overlap, [&](const uint32_t i) { mask[i] = 1; });
+    }
+
+    void GeometryBatch::Intersects(const Rect& rect, std::vector<uint32_t>& indices) const {
+        indices.clear();
+        Run(rect, Query::Overlap, [&](const uint32_t i) { indices.push_back(i); });
+    }
+
+    void GeometryBatch::ContainedIn(const Rect& rect, std::vector<uint8_t>& mask) const {
+        mask.assign(count, 0);
+        Run(rect, Query::Enclosed, [&](const uint32_t i) { mask[i] = 1; });
+    }
+
+    void GeometryBatch::ContainedIn(const Rect& rect, std::vector<uint32_t>& indices) const {
+        indices.clear();
+        Run(rect, Query::Enclosed, [&](const uint32_t i) { indices.push_back(i); });
+    }
+
+    uint32_t GeometryBatch::Push() {
+        const auto index = static_cast<uint32_t>(count++);
+        if (centerX.size() < count) {
+            // Grow by a whole group of padding lanes
+            for (auto* v : {&centerX, &centerY, &innerW, &innerH, &invRadiusX, &invRadiusY}) {
+                v->resize(v->size() + Lanes, 0.0f);
+            }
+            halfW.resize(halfW.size() + Lanes, NeverHit);
+            halfH.resize(halfH.size() + Lanes, NeverHit);
+        }
+        return index;
+    }
+
+    void GeometryBatch::Store(const uint32_t index, const float cx, const float cy, const float hw, const float hh,
+                              const float rx, const float ry) {
+        centerX[index] = cx;
+        centerY[index] = cy;
+        halfW[index] = hw;
+        halfH[index] = hh;
+        innerW[index] = hw - rx;
+        innerH[index] = hh - ry;
+        invRadiusX[index] = rx > 0.0f ? 1.0f / rx : 0.0f;
+        invRadiusY[index] = ry > 0.0f ? 1.0f / ry : 0.0f;
+    }
+
+    /*
+     * With the query box centered at (qx, qy) with half extents (qw, qh), and per axis
+     * a = |center - q| (distance between centers):
+     *   Overlap:  bounds overlap (a <= half + q) and the gap between the query box and
+     *             the inner rect, g = max(a - inner - q, 0), lies within the corner
+     *             ellipse: (gx / rx)^2 + (gy / ry)^2 <= 1. Zero radii leave only the
+     *             bounds test, since g is then zero whenever the bounds overlap.
+     *   Enclosed: a + half <= q on both axes.
+     * A point query is a query box of zero size.
+     */
+    unsigned GeometryBatch::Evaluate4(const size_t base, const Rect& query, const Query kind) const {
+        const float qx = (query.left + query.right) * 0.5f;
+        const float qy = (query.top + query.bottom) * 0.5f;
+        const float qw = (query.right - query.left) * 0.5f;
+        const float qh = (query.bottom - query.top) * 0.5f;
+
+#ifdef LITHOS_GEOMETRY_SSE2
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 vqw = _mm_set1_ps(qw);
+        const __m128 vqh = _mm_set1_ps(qh);
+
+        const __m128 ax = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&centerX[base]), _mm_set1_ps(qx)), absMask);
+        const __m128 ay = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&centerY[base]), _mm_set1_ps(qy)), absMask);
+        const __m128 hw = _mm_loadu_ps(&halfW[base]);
+        const __m128 hh = _mm_loadu_ps(&halfH[base]);
+
+        if (kind == Query::Enclosed) {
+            // Padding lanes have negative extents and must not pass
+            const __m128 valid = _mm_cmpge_ps(hw, _mm_setzero_ps());
+            const __m128 inX = _mm_cmple_ps(_mm_add_ps(ax, hw), vqw);
+            const __m128 inY = _mm_cmple_ps(_mm_add_ps(ay, hh), vqh);
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(valid, _mm_and_ps(inX, inY))));
+        }
+
+        const __m128 inBounds = _mm_and_ps(
+            _mm_cmple_ps(ax, _mm_add_ps(hw, vqw)),
+            _mm_cmple_ps(ay, _mm_add_ps(hh, vqh))
+        );
+
+        const __m128 gx = _mm_max_ps(_mm_sub_ps(ax, _mm_add_ps(_mm_loadu_ps(&innerW[base]), vqw)), _mm_setzero_ps());
+        const __m128 gy = _mm_max_ps(_mm_sub_ps(ay, _mm_add_ps(_mm_loadu_ps(&innerH[base]), vqh)), _mm_setzero_ps());
+        const __m128 ex = _mm_mul_ps(gx, _mm_loadu_ps(&invRadiusX[base]));
+        const __m128 ey = _mm_mul_ps(gy, _mm_loadu_ps(&invRadiusY[base]));
+        const __m128 inCorner = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), _mm_set1_ps(1.0f));
+
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(inBounds, inCorner)));
+#else
+        unsigned bits = 0;
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            const size_t i = base + lane;
+            const float ax = std::fabs(centerX[i] - qx);
+            const float ay = std::fabs(centerY[i] - qy);
+
+            bool hit;
+            if (kind == Query::Enclosed) {
+                hit = halfW[i] >= 0.0f && ax + halfW[i] <= qw && ay + halfH[i] <= qh;
+            } else {
+                const float gx = std::max(ax - (innerW[i] + qw), 0.0f) * invRadiusX[i];
+                const float gy = std::max(ay - (innerH[i] + qh), 0.0f) * invRadiusY[i];
+                hit = ax <= halfW[i] + qw && ay <= halfH[i] + qh && gx * gx + gy * gy <= 1.0f;
+            }
+            bits |= static_cast<unsigned>(hit) << lane;
+        }
+        return bits;
+#endif
+    }
+}
@@ -0,0 +1,138 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/HoverTracker.hpp"
+
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Event.hpp"
+#include "Lithos/Core/EventDispatcher.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+
+#include <algorithm>
+
+namespace Lithos {
+    namespace {
+        void Notify(Element& element, const MouseEventType type, const float x, const float y) {
+            MouseEvent evt;
+            evt.type = type;
+            evt.x = static_cast<int>(x);
+            evt.y = static_cast<int>(y);
+            EventDispatcher::DispatchAtTarget(element, evt);
+        }
+    }
+
+    Element* HoverTracker::Update(Element& root, const float x, const float y, const FlatTree* flat) {
+        Element* target = Revalidate(root, x, y);
+        if (target) {
+            stats.cacheHits++;
+        } else {
+            stats.cacheMisses++;
+            target = flat ? flat->FindElementAt(x, y) : root.FindElementAt(x, y);
+        }
+
+        if (target != GetTarget()) {
+            Retarget(target, x, y);
+        }
+        return target;
+    }
+
+    void HoverTracker::Clear(const float x, const float y) {
+        Retarget(nullptr, x, y);
+    }
+
+    Element* HoverTracker::Revalidate(const Element& root, const float px, const float py) const {
+        if (path.empty() || path.front().handle.expired() || path.front().element != &root || root.NeedsLayout()) {
+            return nullptr;
+        }
+
+        // Walk down from the root so each pointer is proven alive before it is read. The
+        // handle goes first: a freed element's block may already hold a new one at the same
+        // slot, which would pass the pointer comparison
+        for (size_t k = 0; k + 1 < path.size(); ++k) {
+            const Element& parent = *path[k].element;
+            if (!parent.isVisible) return nullptr;
+
+            const PathEntry& child = path[k + 1];
+            if (child.handle.expired() || child.index >= parent.children.size()
+                || parent.children[child.index].get() != child.element) {
+                return nullptr;
+            }
+        }
+
+        // Later siblings paint over the path; one covering the point takes the hit.
+        // (x, y) follows each level into its parent's content space when the parent scrolls
+        float x = px, y = py;
+        for (size_t k = 0; k + 1 < path.size(); ++k) {
+            const Element& parent = *path[k].element;
+            const size_t index = path[k + 1].index;
+
+            if (parent.clipsChildren) {
+                if (!parent.GetClipRect().Contains(x, y)) return nullptr;
+                x += parent.scrollX;
+                y += parent.scrollY;
+            }
+
+            if (parent.childIndex) {
+                thread_local std::vector<uint32_t> candidates;
+                candidates.clear();
+                parent.childIndex->Query(x - parent.x, y - parent.y, candidates);
+                for (const uint32_t i : candidates) {
+                    if (i <= index) break;
+                    if (parent.children[i]->FindElementAt(x, y)) return nullptr;
+                }
+                continue;
+            }
+
+            for (size_t i = index + 1; i < parent.children.size(); ++i) {
+                Element& sibling = *parent.children[i];
+                const Rect& bounds = sibling.subtreeBounds;
+                if (bounds.IsEmpty()) continue;
+                if (parent.childrenOrdered && bounds.top > y) break;
+                if (bounds.Contains(x, y) && sibling.FindElementAt(x, y)) return nullptr;
+            }
+        }
+
+        // The deepest element must still be hit; a child of it may now be the target
+        return path.back().element->FindElementAt(x, y);
+    }
+
+    void HoverTracker::Retarget(Element* target, const float x, const float y) {
+        nextPath.clear();
+        for (Element* e = target; e; e = e->GetParent()) {
+            nextPath.push_back({e, e->weak_from_this(), e->indexInParent});
+        }
+        std::reverse(nextPath.begin(), nextPath.end());
+
+        size_t common = 0;
+        while (common < path.size() && common < nextPath.size() && !path[common].handle.expired()
+               && path[common].element == nextPath[common].element) {
+            ++common;
+        }
+
+        for (size_t k = path.size(); k-- > common;) {
+            if (const auto element = path[k].handle.lock()) {
+                Notify(*element, MouseEventType::MouseLeave, x, y);
+                stats.leaves++;
+            }
+        }
+        for (size_t k = common; k < nextPath.size(); ++k) {
+            Notify(*nextPath[k].element, MouseEventType::MouseEnter, x, y);
+            stats.enters++;
+        }
+
+        path.swap(nextPath);
+    }
+}
@@ -0,0 +1,156 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Image/ImageDecoder.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace Lithos {
+    namespace {
+        std::atomic<uint64_t> nextImageId{1};
+
+        struct PpmHeader {
+            int width = 0;
+            int height = 0;
+            int channels = 0;       ///< 3 for P6, 1 for P5
+            size_t dataOffset = 0;
+        };
+
+        bool IsSpace(const uint8_t c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        /**
+         * Reads one decimal header field, skipping whitespace and '#' comments
+         */
+        bool ReadField(const std::span<const uint8_t> data, size_t& pos, int& value) {
+            for (;;) {
+                while (pos < data.size() && IsSpace(data[pos])) ++pos;
+                if (pos < data.size() && data[pos] == '#') {
+                    while (pos < data.size() && data[pos] != '\n') ++pos;
+                    continue;
+                }
+                break;
+            }
+
+            if (pos >= data.size() || data[pos] < '0' || data[pos] > '9') return false;
+            int64_t v = 0;
+            while (pos < data.size() && data[pos] >= '0' && data[pos] <= '9') {
+                v = v * 10 + (data[pos++] - '0');
+                if (v > (1 << 24)) return false;
+            }
+            value = static_cast<int>(v);
+            return true;
+        }
+
+        bool ParseHeader(const std::span<const uint8_t> data, PpmHeader& header) {
+            if (data.size() < 2 || data[0] != 'P' || (data[1] != '6' && data[1] != '5')) return false;
+            header.channels = data[1] == '6' ? 3 : 1;
+
+            size_t pos = 2;
+            int maxValue = 0;
+            if (!ReadField(data, pos, header.width) || !ReadField(data, pos, header.height) ||
+                !ReadField(data, pos, maxValue)) {
+                return false;
+            }
+            // Exactly one whitespace byte separates the header from the samples
+            if (pos >= data.size() || !IsSpace(data[pos])) return false;
+            header.dataOffset = pos + 1;
+
+            if (header.width <= 0 || header.height <= 0 || maxValue != 255) return false;
+            const size_t needed = static_cast<size_t>(header.width) * static_cast<size_t>(header.height) *
+                                  static_cast<size_t>(header.channels);
+            return data.size() - header.dataOffset >= needed;
+        }
+    }
+
+    std::shared_ptr<DecodedImage> DecodedImage::Create(const int width, const int height) {
+        auto image = std::make_shared<DecodedImage>();
+        image->width = std::max(width, 0);
+        image->height = std::max(height, 0);
+        image->sourceWidth = image->width;
+        image->sourceHeight = image->height;
+        image->pixels.assign(static_cast<size_t>(image->width) * static_cast<size_t>(image->height), 0u);
+        image->id = nextImageId.fetch_add(1, std::memory_order_relaxed);
+        return image;
+    }
+
+    bool PpmDecoder::CanDecode(const std::span<const uint8_t> data) const {
+        return data.size() >= 2 && data[0] == 'P' && (data[1] == '6' || data[1] == '5');
+    }
+
+    std::shared_ptr<DecodedImage> PpmDecoder::Decode(const std::span<const uint8_t> data,
+                                                     const SizeFunction& size) const {
+        PpmHeader header;
+        if (!ParseHeader(data, header)) return nullptr;
+
+        const int sw = header.width;
+        const int sh = header.height;
+        int width = 0, height = 0;
+        size(sw, sh, width, height);
+        if (width <= 0 || height <= 0) return nullptr;
+
+        const int channels = header.channels;
+        const uint8_t* samples = data.data() + header.dataOffset;
+
+        auto image = DecodedImage::Create(width, height);
+        image->sourceWidth = sw;
+        image->sourceHeight = sh;
+
+        // Output pixel x averages source columns [columns[x], columns[x + 1]); never empty, so
+        // enlarging repeats pixels
+        std::vector<int> columns(static_cast<size_t>(width) + 1);
+        for (int x = 0; x <= width; ++x) {
+            columns[x] = static_cast<int>(static_cast<int64_t>(x) * sw / width);
+        }
+
+        // 64-bit: one output pixel may average up to 2^24 x 2^24 source pixels
+        std::vector<uint64_t> sums(static_cast<size_t>(width) * 3);
+        for (int y = 0; y < height; ++y) {
+            const int row0 = static_cast<int>(static_cast<int64_t>(y) * sh / height);
+            const int row1 = std::max(row0 + 1, static_cast<int>(static_cast<int64_t>(y + 1) * sh / height));
+
+            std::fill(sums.begin(), sums.end(), uint64_t{0});
+            for (int sy = row0; sy < row1; ++sy) {
+                const uint8_t* row = samples + static_cast<size_t>(sy) * sw * channels;
+                for (int x = 0; x < width; ++x) {
+                    const int c0 = columns[x];
+                    const int c1 = std::max(c0 + 1, columns[x + 1]);
+                    uint64_t* sum = &sums[static_cast<size_t>(x) * 3];
+                    for (int sx = c0; sx < c1; ++sx) {
+                        const uint8_t* p = row + static_cast<size_t>(sx) * channels;
+                        sum[0] += p[0];
+                        sum[1] += p[channels == 3 ? 1 : 0];
+                        sum[2] += p[channels == 3 ? 2 : 0];
+                    }
+                }
+            }
+
+            uint32_t* out = image->pixels.data() + static_cast<size_t>(y) * width;
+            const int rows = row1 - row0;
+            for (int x = 0; x < width; ++x) {
+                const uint64_t n = static_cast<uint64_t>(rows) *
+                                   static_cast<uint64_t>(std::max(columns[x] + 1, columns[x + 1]) - columns[x]);
+                const uint64_t* sum = &sums[static_cast<size_t>(x) * 3];
+                const auto r = static_cast<uint32_t>((sum[0] + n / 2) / n);
+                const auto g = static_cast<uint32_t>((sum[1] + n / 2) / n);
+                const auto b = static_cast<uint32_t>((sum[2] + n / 2) / n);
+                out[x] = 0xFF000000u | r << 16 | g << 8 | b;
+            }
+        }
+        return image;
+    }
+}
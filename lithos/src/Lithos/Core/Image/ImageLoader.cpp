@@ -0,0 +1,194 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Image/ImageLoader.hpp"
+#include "Lithos/Core/Threading/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace Lithos {
+    namespace {
+        bool ReadFile(const std::string& source, std::vector<uint8_t>& bytes) {
+            const std::filesystem::path path(std::u8string(source.begin(), source.end()));
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in) return false;
+
+            const std::streamsize size = in.tellg();
+            if (size <= 0) return false;
+            bytes.resize(static_cast<size_t>(size));
+            in.seekg(0);
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(bytes.data()), size));
+        }
+
+        std::shared_ptr<const DecodedImage> DecodeSource(const std::vector<std::shared_ptr<const ImageDecoder>>& decoders,
+                                                         const ImageLoader::Fetcher& fetch, const ImageKey& key) {
+            std::vector<uint8_t> bytes;
+            if (!fetch(key.source, bytes)) return nullptr;
+
+            const ImageDecoder::SizeFunction size = [&key](const int sw, const int sh, int& w, int& h) {
+                ImageLoader::TargetSize(sw, sh, key, w, h);
+            };
+            for (const auto& decoder : decoders) {
+                if (!decoder->CanDecode(bytes)) continue;
+                if (auto image = decoder->Decode(bytes, size)) return image;
+            }
+            return nullptr;
+        }
+    }
+
+    ImageLoader::ImageLoader(const size_t cacheBudget, JobSystem* jobs)
+        : jobs(jobs ? jobs : &JobSystem::Shared()),
+          fetch(ReadFile),
+          mailbox(std::make_shared<Mailbox>()),
+          cache(cacheBudget) {
+        decoders.push_back(std::make_shared<PpmDecoder>());
+    }
+
+    ImageLoader::~ImageLoader() {
+        // Jobs still running finish into the mailbox, which they keep alive
+        std::lock_guard lock(mailbox->mutex);
+        mailbox->wake = nullptr;
+    }
+
+    void ImageLoader::AddDecoder(std::shared_ptr<const ImageDecoder> decoder) {
+        if (decoder) decoders.push_back(std::move(decoder));
+    }
+
+    void ImageLoader::SetFetcher(Fetcher fetcher) {
+        fetch = fetcher ? std::move(fetcher) : Fetcher(ReadFile);
+    }
+
+    void ImageLoader::SetWakeHandler(std::function<void()> handler) {
+        std::lock_guard lock(mailbox->mutex);
+        mailbox->wake = std::move(handler);
+    }
+
+    std::shared_ptr<const DecodedImage> ImageLoader::Find(const ImageKey& key) {
+        const auto* cached = cache.Find(key);
+        return cached ? *cached : nullptr;
+    }
+
+    std::shared_ptr<const DecodedImage> ImageLoader::Load(const ImageKey& key, Callback done) {
+        stats.requests++;
+        if (auto cached = Find(key)) {
+            stats.cacheHits++;
+            return cached;
+        }
+
+        if (const auto it = inFlight.find(key); it != inFlight.end()) {
+            stats.coalesced++;
+            if (done) it->second.push_back(std::move(done));
+            return nullptr;
+        }
+
+        auto& waiting = inFlight[key];
+        if (done) waiting.push_back(std::move(done));
+        stats.decodes++;
+
+        // The job works on copies, so registering decoders later never races with it
+        jobs->Submit([box = mailbox, decoders = decoders, fetch = fetch, key] {
+            Completion completion{key, DecodeSource(decoders, fetch, key)};
+
+            std::function<void()> wake;
+            {
+                std::lock_guard lock(box->mutex);
+                box->completions.push_back(std::move(completion));
+                wake = box->wake;
+            }
+            box->ready.notify_all();
+            if (wake) wake();
+        });
+        return nullptr;
+    }
+
+    size_t ImageLoader::Poll() {
+        {
+            std::lock_guard lock(mailbox->mutex);
+            if (mailbox->completions.empty()) return 0;
+            delivering.swap(mailbox->completions);
+        }
+
+        size_t delivered = 0;
+        for (Completion& completion : delivering) {
+            const auto it = inFlight.find(completion.key);
+            if (it == inFlight.end()) continue;
+
+            // Taken out first: callbacks may load again, even the same key
+            std::vector<Callback> callbacks = std::move(it->second);
+            inFlight.erase(it);
+
+            if (completion.image) {
+                const size_t bytes = completion.image->GetMemoryBytes();
+                cache.Acquire(completion.key, [&] { return completion.image; }, bytes);
+            } else {
+                stats.failures++;
+            }
+
+            for (const Callback& callback : callbacks) {
+                callback(completion.image);
+                delivered++;
+            }
+        }
+        delivering.clear();
+
+        stats.delivered += delivered;
+        return delivered;
+    }
+
+    bool ImageLoader::WaitForResults(const Clock::duration timeout) {
+        std::unique_lock lock(mailbox->mutex);
+        if (inFlight.empty() && mailbox->completions.empty()) return false;
+        return mailbox->ready.wait_for(lock, timeout, [this] { return !mailbox->completions.empty(); });
+    }
+
+    void ImageLoader::TargetSize(const int sourceWidth, const int sourceHeight, const ImageKey& key,
+                                 int& width, int& height) {
+        if (key.width <= 0 || key.height <= 0) {
+            width = sourceWidth;
+            height = sourceHeight;
+            return;
+        }
+
+        if (key.fit == ImageFit::Fill) {
+            width = std::min(key.width, sourceWidth);
+            height = std::min(key.height, sourceHeight);
+            return;
+        }
+
+        // Pixels beyond the source's own add nothing; the renderer stretches instead
+        const double scale = std::min({
+            static_cast<double>(key.width) / sourceWidth,
+            static_cast<double>(key.height) / sourceHeight,
+            1.0
+        });
+        width = std::max(1, static_cast<int>(std::lround(sourceWidth * scale)));
+        height = std::max(1, static_cast<int>(std::lround(sourceHeight * scale)));
+    }
+
+    Rect ImageLoader::FitRect(const Rect& box, const int imageWidth, const int imageHeight, const ImageFit fit) {
+        if (fit == ImageFit::Fill || imageWidth <= 0 || imageHeight <= 0 || box.IsEmpty()) return box;
+
+        const float scale = std::min(box.Width() / static_cast<float>(imageWidth),
+                                     box.Height() / static_cast<float>(imageHeight));
+        const float w = static_cast<float>(imageWidth) * scale;
+        const float h = static_cast<float>(imageHeight) * scale;
+        const float left = box.left + (box.Width() - w) * 0.5f;
+        const float top = box.top + (box.Height() - h) * 0.5f;
+        return {left, top, left + w, top + h};
+    }
+}
@@ -0,0 +1,104 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Image/WicDecoder.hpp"
+
+namespace Lithos {
+    namespace {
+        /**
+         * COM for the duration of one call; worker threads may or may not have it already
+         */
+        class ComScope {
+        public:
+            ComScope() : initialized(SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED))) {}
+            ~ComScope() {
+                if (initialized) CoUninitialize();
+            }
+
+            ComScope(const ComScope&) = delete;
+            ComScope& operator=(const ComScope&) = delete;
+
+        private:
+            bool initialized;
+        };
+
+        struct WicFrame {
+            ComPtr<IWICImagingFactory> factory;
+            ComPtr<IWICStream> stream;
+            ComPtr<IWICBitmapDecoder> decoder;
+            ComPtr<IWICBitmapFrameDecode> frame;
+        };
+
+        bool OpenFrame(const std::span<const uint8_t> data, WicFrame& out) {
+            if (data.empty()) return false;
+
+            return SUCCEEDED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER,
+                                              IID_PPV_ARGS(&out.factory)))
+                && SUCCEEDED(out.factory->CreateStream(&out.stream))
+                && SUCCEEDED(out.stream->InitializeFromMemory(const_cast<BYTE*>(data.data()),
+                                                              static_cast<DWORD>(data.size())))
+                && SUCCEEDED(out.factory->CreateDecoderFromStream(out.stream.Get(), nullptr,
+                                                                  WICDecodeMetadataCacheOnDemand, &out.decoder))
+                && SUCCEEDED(out.decoder->GetFrame(0, &out.frame));
+        }
+    }
+
+    bool WicDecoder::CanDecode(const std::span<const uint8_t> data) const {
+        return !data.empty();
+    }
+
+    std::shared_ptr<DecodedImage> WicDecoder::Decode(const std::span<const uint8_t> data,
+                                                     const SizeFunction& size) const {
+        ComScope com;
+        WicFrame wic;
+        UINT sw = 0, sh = 0;
+        if (!OpenFrame(data, wic) || FAILED(wic.frame->GetSize(&sw, &sh)) || sw == 0 || sh == 0) return nullptr;
+
+        // The frame is opened once; the output size depends on what it reports
+        int width = 0, height = 0;
+        size(static_cast<int>(sw), static_cast<int>(sh), width, height);
+        if (width <= 0 || height <= 0) return nullptr;
+
+        ComPtr<IWICBitmapSource> source = wic.frame;
+        if (sw != static_cast<UINT>(width) || sh != static_cast<UINT>(height)) {
+            ComPtr<IWICBitmapScaler> scaler;
+            if (FAILED(wic.factory->CreateBitmapScaler(&scaler)) ||
+                FAILED(scaler->Initialize(wic.frame.Get(), static_cast<UINT>(width), static_cast<UINT>(height),
+                                          WICBitmapInterpolationModeFant))) {
+                return nullptr;
+            }
+            source = scaler;
+        }
+
+        ComPtr<IWICFormatConverter> converter;
+        if (FAILED(wic.factory->CreateFormatConverter(&converter)) ||
+            FAILED(converter->Initialize(source.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone,
+                                         nullptr, 0.0, WICBitmapPaletteTypeCustom))) {
+            return nullptr;
+        }
+
+        // 32bppPBGRA is B, G, R, A in memory: 0xAARRGGBB premultiplied on little-endian
+        auto image = DecodedImage::Create(width, height);
+        image->sourceWidth = static_cast<int>(sw);
+        image->sourceHeight = static_cast<int>(sh);
+        const UINT stride = static_cast<UINT>(width) * 4;
+        if (FAILED(converter->CopyPixels(nullptr, stride, stride * static_cast<UINT>(height),
+                                         reinterpret_cast<BYTE*>(image->pixels.data())))) {
+            return nullptr;
+        }
+        return image;
+    }
+}
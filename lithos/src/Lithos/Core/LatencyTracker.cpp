@@ -0,0 +1,130 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/LatencyTracker.hpp"
+#include <algorithm>
+
+namespace Lithos {
+    namespace {
+        template<typename T>
+        void PushRing(std::vector<T>& ring, size_t& next, const size_t capacity, const T& value) {
+            if (ring.size() < capacity) {
+                ring.push_back(value);
+            } else {
+                ring[next] = value;
+            }
+            next = (next + 1) % capacity;
+        }
+    }
+
+    LatencyTracker::LatencyTracker(const size_t capacity)
+        : capacity(std::max<size_t>(capacity, 1)) {
+        frames.reserve(this->capacity);
+        inputLatency.reserve(this->capacity);
+    }
+
+    void LatencyTracker::BeginFrame(const Clock::time_point now) {
+        current = {};
+        current.frame = ++frameCount;
+        current.begin = now;
+        pendingInputs.clear();
+    }
+
+    void LatencyTracker::InputConsumed(const Clock::time_point arrival) {
+        if (current.inputs == 0 || arrival < current.oldestInput) current.oldestInput = arrival;
+        if (current.inputs == 0 || arrival > current.newestInput) current.newestInput = arrival;
+        current.inputs++;
+        pendingInputs.push_back(arrival);
+    }
+
+    void LatencyTracker::MarkDispatched(const Clock::time_point now) {
+        current.dispatched = now;
+    }
+
+    void LatencyTracker::MarkLaidOut(const Clock::time_point now) {
+        current.laidOut = now;
+    }
+
+    void LatencyTracker::MarkPainted(const Clock::time_point now) {
+        current.painted = now;
+    }
+
+    void LatencyTracker::MarkPresented(const Clock::time_point now) {
+        current.presented = now;
+        for (const Clock::time_point arrival : pendingInputs) {
+            PushRing(inputLatency, nextInput, capacity, std::chrono::nanoseconds(now - arrival));
+        }
+        pendingInputs.clear();
+
+        PushRing(frames, nextFrame, capacity, current);
+        lastFrame = current;
+    }
+
+    void LatencyTracker::GetFrames(std::vector<FrameTiming>& out) const {
+        out.clear();
+        out.reserve(frames.size());
+
+        // Before the ring wraps, nextFrame == frames.size() and the first loop is empty
+        for (size_t i = nextFrame; i < frames.size(); ++i) out.push_back(frames[i]);
+        for (size_t i = 0; i < nextFrame && i < frames.size(); ++i) out.push_back(frames[i]);
+    }
+
+    LatencySummary LatencyTracker::GetInputLatency() const {
+        scratch.assign(inputLatency.begin(), inputLatency.end());
+        return Summarize(scratch);
+    }
+
+    LatencySummary LatencyTracker::GetFrameDuration() const {
+        scratch.clear();
+        for (const FrameTiming& f : frames) scratch.push_back(f.Duration());
+        return Summarize(scratch);
+    }
+
+    void LatencyTracker::Reset() {
+        current = {};
+        lastFrame = {};
+        frameCount = 0;
+        pendingInputs.clear();
+        frames.clear();
+        nextFrame = 0;
+        inputLatency.clear();
+        nextInput = 0;
+    }
+
+    LatencySummary LatencyTracker::Summarize(std::vector<std::chrono::nanoseconds>& samples) const {
+        LatencySummary summary;
+        summary.samples = samples.size();
+        if (samples.empty()) return summary;
+
+        std::sort(samples.begin(), samples.end());
+
+        // Nearest-rank percentiles
+        const auto rank = [&](const double p) {
+            const auto k = static_cast<size_t>(p * static_cast<double>(samples.size()) + 0.999999);
+            return samples[std::clamp<size_t>(k, 1, samples.size()) - 1];
+        };
+
+        std::chrono::nanoseconds total{0};
+        for (const auto s : samples) total += s;
+
+        summary.mean = total / static_cast<long long>(samples.size());
+        summary.p50 = rank(0.50);
+        summary.p90 = rank(0.90);
+        summary.p99 = rank(0.99);
+        summary.max = samples.back();
+        return summary;
+    }
+}
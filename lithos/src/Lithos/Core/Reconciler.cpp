@@ -0,0 +1,231 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Reconciler.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace Lithos {
+    namespace {
+        // Fields whose change moves boxes or grows subtree bounds
+        constexpr float Style::* LayoutFields[] = {
+            &Style::left, &Style::top, &Style::right, &Style::bottom,
+            &Style::width, &Style::height,
+            &Style::padding, &Style::paddingTop, &Style::paddingRight, &Style::paddingBottom, &Style::paddingLeft,
+            &Style::margin, &Style::marginTop, &Style::marginRight, &Style::marginBottom, &Style::marginLeft,
+            &Style::shadowOffsetX, &Style::shadowOffsetY, &Style::shadowBlur,
+            &Style::fontSize
+        };
+
+        constexpr float Style::* PaintFields[] = {
+            &Style::opacity, &Style::borderWidth, &Style::borderRadius
+        };
+
+        constexpr Color Style::* PaintColors[] = {
+            &Style::backgroundColor, &Style::borderColor, &Style::shadowColor, &Style::textColor
+        };
+
+        bool SameColor(const Color& a, const Color& b) {
+            return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+        }
+
+        /**
+         * Marks the longest strictly increasing subsequence of seq, ignoring entries of -1
+         */
+        std::vector<bool> LongestIncreasing(const std::vector<ptrdiff_t>& seq) {
+            std::vector<size_t> tails;                  // Position ending the best run of each length
+            std::vector<size_t> previous(seq.size());
+            for (size_t i = 0; i < seq.size(); ++i) {
+                if (seq[i] < 0) continue;
+                const auto it = std::lower_bound(tails.begin(), tails.end(), seq[i],
+                                                 [&](const size_t t, const ptrdiff_t v) { return seq[t] < v; });
+                previous[i] = it == tails.begin() ? SIZE_MAX : *std::prev(it);
+                if (it == tails.end()) {
+                    tails.push_back(i);
+                } else {
+                    *it = i;
+                }
+            }
+
+            std::vector<bool> keep(seq.size(), false);
+            for (size_t i = tails.empty() ? SIZE_MAX : tails.back(); i != SIZE_MAX; i = previous[i]) {
+                keep[i] = true;
+            }
+            return keep;
+        }
+    }
+
+    void Reconciler::Reconcile(Element& parent, const std::vector<NodeRef>& nodes) {
+        // Walk in step while siblings still line up; one changed row never leaves this loop
+        Element* current = parent.firstChild;
+        size_t i = 0;
+        for (; current && i < nodes.size() && Matches(*current, *nodes[i]); ++i) {
+            Element* next = current->nextSibling;
+            Update(*current, nodes[i]);
+            current = next;
+        }
+
+        if (i == nodes.size()) {
+            while (current) {
+                Element* next = current->nextSibling;
+                Remove(parent, *current);
+                current = next;
+            }
+            return;
+        }
+
+        if (!current) {
+            for (; i < nodes.size(); ++i) {
+                parent.InsertChild(Create(parent, nodes[i]), nullptr);
+            }
+            return;
+        }
+
+        ReconcileKeyed(parent, current, nodes, i);
+    }
+
+    void Reconciler::ReconcileKeyed(Element& parent, Element* first, const std::vector<NodeRef>& nodes, const size_t begin) {
+        std::vector<Element*> tail;
+        existing.clear();
+        for (Element* e = first; e; e = e->nextSibling) {
+            const size_t index = begin + tail.size();
+            if (e->description) existing.try_emplace(SlotOf(*e->description, index), Match{e, index});
+            tail.push_back(e);
+        }
+
+        // Claim elements for the new nodes; anything left over is removed
+        const size_t count = nodes.size() - begin;
+        std::vector<Element*> matched(count, nullptr);
+        std::vector<ptrdiff_t> oldIndex(count, -1);
+        std::vector<bool> claimed(tail.size(), false);
+        for (size_t k = 0; k < count; ++k) {
+            const Node& node = *nodes[begin + k];
+            const auto it = existing.find(SlotOf(node, begin + k));
+            if (it == existing.end() || !Matches(*it->second.element, node)) continue;
+
+            matched[k] = it->second.element;
+            oldIndex[k] = static_cast<ptrdiff_t>(it->second.oldIndex);
+            claimed[it->second.oldIndex - begin] = true;
+            existing.erase(it);
+        }
+        // Done with the map before any Update() recurses into it
+        existing.clear();
+
+        for (size_t k = 0; k < tail.size(); ++k) {
+            if (!claimed[k]) Remove(parent, *tail[k]);
+        }
+
+        // Claimed elements already in relative order stay put; the rest move into place.
+        // Placing back to front lets each node anchor on the one after it.
+        const std::vector<bool> stays = LongestIncreasing(oldIndex);
+        Element* anchor = nullptr;
+        for (size_t k = count; k-- > 0;) {
+            const NodeRef& node = nodes[begin + k];
+            Element* element = matched[k];
+            if (!element) {
+                element = &parent.InsertChild(Create(parent, node), anchor);
+            } else {
+                if (!stays[k]) {
+                    parent.MoveChild(*element, anchor);
+                    stats.moved++;
+                }
+                Update(*element, node);
+            }
+            anchor = element;
+        }
+    }
+
+    void Reconciler::Update(Element& element, const NodeRef& node) {
+        stats.visited++;
+        if (element.description == node) {
+            stats.skipped++;
+            return;
+        }
+        if (element.description) stats.reused++;
+
+        ApplyStyle(element, element.description.get(), *node);
+        Reconcile(element, node->children);
+        element.description = node;
+    }
+
+    void Reconciler::ApplyStyle(Element& element, const Node* previous, const Node& node) {
+        // Fields the description didn't change keep whatever was set on the element since
+        const Style* before = previous ? &previous->style : nullptr;
+        const Style& after = node.style;
+        Style& style = element.style;
+
+        bool layout = false, paint = false;
+        for (const auto field : LayoutFields) {
+            if ((!before || before->*field != after.*field) && style.*field != after.*field) {
+                style.*field = after.*field;
+                layout = true;
+            }
+        }
+        if ((!before || before->shadowEnabled != after.shadowEnabled) && style.shadowEnabled != after.shadowEnabled) {
+            style.shadowEnabled = after.shadowEnabled;
+            layout = true;
+        }
+        for (const auto field : PaintFields) {
+            if ((!before || before->*field != after.*field) && style.*field != after.*field) {
+                style.*field = after.*field;
+                paint = true;
+            }
+        }
+        for (const auto field : PaintColors) {
+            if ((!before || !SameColor(before->*field, after.*field)) && !SameColor(style.*field, after.*field)) {
+                style.*field = after.*field;
+                paint = true;
+            }
+        }
+        if ((!previous || previous->visible != node.visible) && element.isVisible != node.visible) {
+            element.isVisible = node.visible;
+            paint = true;
+        }
+        if (!before || before->cursor != after.cursor) {
+            style.cursor = after.cursor;
+        }
+
+        // Fresh elements start out dirty
+        if (!previous && !element.parent) return;
+
+        if (layout) {
+            element.InvalidateLayout();
+            stats.layoutInvalidations++;
+        } else if (paint) {
+            element.RequestRepaint();
+            stats.paintInvalidations++;
+        }
+    }
+
+    std::shared_ptr<Element> Reconciler::Create(Element& parent, const NodeRef& node) {
+        auto element = node->create ? node->create(parent.pool) : Element::Make<Element>(parent.pool);
+        stats.created++;
+        Update(*element, node);
+        if (node->mount) node->mount(*element);
+        return element;
+    }
+
+    void Reconciler::Remove(Element& parent, Element& child) {
+        parent.RemoveChild(child);
+        stats.removed++;
+    }
+
+    bool Reconciler::Matches(const Element& element, const Node& node) {
+        const Node* current = element.description.get();
+        if (current == &node) return true;
+        return current && current->create == node.create && current->key == node.key;
+    }
+}
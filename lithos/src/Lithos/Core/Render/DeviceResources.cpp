@@ -0,0 +1,338 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/DeviceResources.hpp"
+#include <cmath>
+#include <limits>
+
+namespace Lithos {
+    namespace {
+        constexpr size_t DefaultBrushBudget = 1024;
+        constexpr size_t DefaultShadowBitmapBudget = 16 * 1024 * 1024;
+        constexpr size_t DefaultImageBitmapBudget = 64 * 1024 * 1024;
+
+        /// Direct2D doesn't expose what a solid color brush costs; a rough per-object figure
+        constexpr size_t EstimatedBrushBytes = 64;
+
+        /**
+         * Quantizes a color to 8 bits per channel so visually identical colors share a brush.
+         */
+        uint32_t PackColor(const Color& c) {
+            const auto channel = [](const float v) {
+                return static_cast<uint32_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+            };
+            return channel(c.r) << 24 | channel(c.g) << 16 | channel(c.b) << 8 | channel(c.a);
+        }
+    }
+
+    DeviceResources::DeviceResources()
+        : brushes(DefaultBrushBudget),
+          shadowBitmaps(DefaultShadowBitmapBudget),
+          imageBitmaps(DefaultImageBitmapBudget) {}
+
+    void DeviceResources::DrawShadow(ID2D1DeviceContext* rt, const float x, const float y, const float w, const float h,
+                                     const float radius, const float blur, const Color& color, const bool animatedColor) {
+        if (!rt || color.a <= 0.0f || w <= 0.0f || h <= 0.0f) return;
+
+        BindContext(rt);
+
+        const std::shared_ptr<const ShadowMask> mask = shadowCache.Acquire(w, h, radius, blur);
+        ID2D1Bitmap* bitmap = GetShadowBitmap(rt, *mask);
+        if (!bitmap) return;
+
+        ID2D1SolidColorBrush* brush = animatedColor ? GetAnimatedBrush(rt, color) : GetSolidBrush(rt, color);
+        if (!brush) return;
+
+        ShadowSlice slices[9];
+        const int count = mask->Slices(x, y, w, h, slices);
+
+        // FillOpacityMask requires aliased rendering
+        const D2D1_ANTIALIAS_MODE previousMode = rt->GetAntialiasMode();
+        rt->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+        for (int i = 0; i < count; ++i) {
+            const ShadowSlice& s = slices[i];
+            const D2D1_RECT_F dst = D2D1::RectF(s.dstLeft, s.dstTop, s.dstRight, s.dstBottom);
+            const D2D1_RECT_F src = D2D1::RectF(s.srcLeft, s.srcTop, s.srcRight, s.srcBottom);
+            rt->FillOpacityMask(bitmap, brush, D2D1_OPACITY_MASK_CONTENT_GRAPHICS, &dst, &src);
+        }
+
+        rt->SetAntialiasMode(previousMode);
+    }
+
+    void DeviceResources::Replay(ID2D1DeviceContext* rt, const DisplayList& list, const std::vector<uint8_t>& culled) {
+        if (!rt) return;
+
+        // Consecutive commands share a clip, so only push on change
+        Rect activeClip = Unclipped;
+
+        const auto& commands = list.Commands();
+        for (size_t i = 0; i < commands.size(); ++i) {
+            if (i < culled.size() && culled[i]) continue;
+
+            const DrawCommand& cmd = commands[i];
+            if (cmd.clip != activeClip) {
+                if (activeClip != Unclipped) rt->PopAxisAlignedClip();
+                activeClip = cmd.clip;
+                if (activeClip != Unclipped) {
+                    rt->PushAxisAlignedClip(
+                        D2D1::RectF(activeClip.left, activeClip.top, activeClip.right, activeClip.bottom),
+                        D2D1_ANTIALIAS_MODE_ALIASED
+                    );
+                }
+            }
+
+            const bool animated = (cmd.flags & DrawCommandFlags::AnimatedColor) != 0;
+            const Rect& r = cmd.rect;
+
+            if (cmd.type == DrawCommandType::Shadow) {
+                DrawShadow(rt, r.left, r.top, r.Width(), r.Height(), cmd.radius, cmd.param, cmd.color, animated);
+                continue;
+            }
+
+            if (cmd.type == DrawCommandType::Image) {
+                BindContext(rt);
+                if (ID2D1Bitmap* bitmap = GetImageBitmap(rt, list.GetImage(cmd))) {
+                    rt->DrawBitmap(bitmap, D2D1::RectF(r.left, r.top, r.right, r.bottom), cmd.color.a,
+                                   D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+                }
+                continue;
+            }
+
+            ID2D1SolidColorBrush* brush = animated ? GetAnimatedBrush(rt, cmd.color) : GetSolidBrush(rt, cmd.color);
+            if (!brush) continue;
+
+            switch (cmd.type) {
+                case DrawCommandType::FillRect:
+                    rt->FillRectangle(D2D1::RectF(r.left, r.top, r.right, r.bottom), brush);
+                    break;
+                case DrawCommandType::FillRoundedRect:
+                    rt->FillRoundedRectangle(
+                        D2D1::RoundedRect(D2D1::RectF(r.left, r.top, r.right, r.bottom), cmd.radius, cmd.radius),
+                        brush
+                    );
+                    break;
+                case DrawCommandType::StrokeRect: {
+                    // Command strokes lie inside the rect; D2D centers them on the outline
+                    const float half = cmd.param * 0.5f;
+                    const D2D1_RECT_F inner = D2D1::RectF(r.left + half, r.top + half, r.right - half, r.bottom - half);
+                    if (cmd.radius > 0.0f) {
+                        const float innerRadius = std::max(cmd.radius - half, 0.0f);
+                        rt->DrawRoundedRectangle(D2D1::RoundedRect(inner, innerRadius, innerRadius), brush, cmd.param);
+                    } else {
+                        rt->DrawRectangle(inner, brush, cmd.param);
+                    }
+                    break;
+                }
+                case DrawCommandType::Text: {
+                    IDWriteTextFormat* format = GetTextFormat(list.GetFont(cmd), cmd.param);
+                    if (!format) break;
+                    const std::wstring_view text = list.GetText(cmd);
+                    rt->DrawText(text.data(), static_cast<UINT32>(text.size()), format,
+                                 D2D1::RectF(r.left, r.top, r.right, r.bottom), brush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        if (activeClip != Unclipped) rt->PopAxisAlignedClip();
+    }
+
+    size_t DeviceResources::GetMemoryBytes() const {
+        const size_t brushCount = brushes.GetStats().live + (animatedBrush ? 1 : 0);
+        return brushCount * EstimatedBrushBytes
+            + shadowCache.GetStats().cost
+            + shadowBitmaps.GetStats().cost
+            + imageBitmaps.GetStats().cost
+            + CapacityBytes(paths) + CapacityBytes(freePaths)
+            + CapacityBytes(textFormats);
+    }
+
+    ID2D1SolidColorBrush* DeviceResources::GetSolidBrush(ID2D1DeviceContext* rt, const Color& color) {
+        BindContext(rt);
+
+        const ComPtr<ID2D1SolidColorBrush>& brush = brushes.Acquire(PackColor(color), [&] {
+            ComPtr<ID2D1SolidColorBrush> created;
+            rt->CreateSolidColorBrush(static_cast<D2D1_COLOR_F>(color), &created);
+            return created;
+        });
+        return brush.Get();
+    }
+
+    ID2D1SolidColorBrush* DeviceResources::GetAnimatedBrush(ID2D1DeviceContext* rt, const Color& color) {
+        BindContext(rt);
+
+        if (!animatedBrush) {
+            rt->CreateSolidColorBrush(static_cast<D2D1_COLOR_F>(color), &animatedBrush);
+        } else {
+            animatedBrush->SetColor(static_cast<D2D1_COLOR_F>(color));
+        }
+        return animatedBrush.Get();
+    }
+
+    uint32_t DeviceResources::RegisterPath(ComPtr<ID2D1Geometry> path) {
+        if (!freePaths.empty()) {
+            const uint32_t handle = freePaths.back();
+            freePaths.pop_back();
+            paths[handle - 1] = std::move(path);
+            return handle;
+        }
+        paths.push_back(std::move(path));
+        return static_cast<uint32_t>(paths.size());
+    }
+
+    void DeviceResources::ReleasePath(const uint32_t handle) {
+        if (handle == 0 || handle > paths.size() || !paths[handle - 1]) return;
+
+        paths[handle - 1].Reset();
+        freePaths.push_back(handle);
+    }
+
+    ComPtr<ID2D1Geometry> DeviceResources::GetD2DGeometry(ID2D1Factory* factory, const Geometry& geometry) const {
+        const Rect b = geometry.GetBounds();
+        const D2D1_RECT_F rect = D2D1::RectF(b.left, b.top, b.right, b.bottom);
+
+        switch (geometry.Kind()) {
+            case GeometryKind::Path: {
+                const uint32_t handle = geometry.GetPathHandle();
+                return handle > 0 && handle <= paths.size() ? paths[handle - 1] : nullptr;
+            }
+            case GeometryKind::Rect: {
+                ComPtr<ID2D1RectangleGeometry> created;
+                factory->CreateRectangleGeometry(rect, &created);
+                return created;
+            }
+            case GeometryKind::Circle: {
+                ComPtr<ID2D1EllipseGeometry> created;
+                const float r = b.Width() * 0.5f;
+                factory->CreateEllipseGeometry(D2D1::Ellipse(D2D1::Point2F(b.left + r, b.top + r), r, r), &created);
+                return created;
+            }
+            case GeometryKind::RoundedRect: {
+                ComPtr<ID2D1RoundedRectangleGeometry> created;
+                factory->CreateRoundedRectangleGeometry(
+                    D2D1::RoundedRect(rect, geometry.GetRadiusX(), geometry.GetRadiusY()),
+                    &created
+                );
+                return created;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    IDWriteTextFormat* DeviceResources::GetTextFormat(const std::wstring_view family, const float fontSize) {
+        for (const TextFormatEntry& entry : textFormats) {
+            if (entry.fontSize == fontSize && entry.family == family) return entry.format.Get();
+        }
+
+        if (!writeFactory) {
+            DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory),
+                                reinterpret_cast<IUnknown**>(writeFactory.GetAddressOf()));
+            if (!writeFactory) return nullptr;
+        }
+
+        TextFormatEntry entry{std::wstring(family), fontSize, nullptr};
+        if (FAILED(writeFactory->CreateTextFormat(entry.family.c_str(), nullptr, DWRITE_FONT_WEIGHT_NORMAL,
+                                                  DWRITE_FONT_STYLE_NORMAL, DWRITE_FONT_STRETCH_NORMAL,
+                                                  fontSize, L"", &entry.format))) {
+            return nullptr;
+        }
+        entry.format->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP);
+
+        textFormats.push_back(std::move(entry));
+        return textFormats.back().format.Get();
+    }
+
+    float DeviceResources::MeasureText(const std::wstring_view text, const std::wstring_view family, const float fontSize) {
+        if (text.empty()) return 0.0f;
+
+        IDWriteTextFormat* format = GetTextFormat(family, fontSize);
+        if (!format) return 0.0f;
+
+        ComPtr<IDWriteTextLayout> layout;
+        if (FAILED(writeFactory->CreateTextLayout(text.data(), static_cast<UINT32>(text.size()), format,
+                                                  std::numeric_limits<float>::max(), fontSize * 2.0f, &layout))) {
+            return 0.0f;
+        }
+
+        DWRITE_TEXT_METRICS metrics{};
+        layout->GetMetrics(&metrics);
+        return metrics.widthIncludingTrailingWhitespace;
+    }
+
+    void DeviceResources::ReleaseDeviceResources() {
+        brushes.Clear();
+        shadowBitmaps.Clear();
+        imageBitmaps.Clear();
+        animatedBrush.Reset();
+        cachedContext = nullptr;
+    }
+
+    void DeviceResources::BindContext(ID2D1DeviceContext* rt) {
+        if (cachedContext != rt) {
+            ReleaseDeviceResources();
+            cachedContext = rt;
+        }
+    }
+
+    ID2D1Bitmap* DeviceResources::GetShadowBitmap(ID2D1DeviceContext* rt, const ShadowMask& mask) {
+        if (mask.width <= 0 || mask.height <= 0) return nullptr;
+
+        const ComPtr<ID2D1Bitmap>& bitmap = shadowBitmaps.Acquire(mask.id, [&] {
+            ComPtr<ID2D1Bitmap> created;
+            const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(
+                D2D1::PixelFormat(DXGI_FORMAT_A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+            );
+
+            rt->CreateBitmap(
+                D2D1::SizeU(static_cast<UINT32>(mask.width), static_cast<UINT32>(mask.height)),
+                mask.alpha.data(),
+                static_cast<UINT32>(mask.width),
+                props,
+                &created
+            );
+            return created;
+        }, mask.alpha.size());
+
+        return bitmap.Get();
+    }
+
+    ID2D1Bitmap* DeviceResources::GetImageBitmap(ID2D1DeviceContext* rt, const DecodedImage& image) {
+        if (image.width <= 0 || image.height <= 0) return nullptr;
+
+        const ComPtr<ID2D1Bitmap>& bitmap = imageBitmaps.Acquire(image.id, [&] {
+            ComPtr<ID2D1Bitmap> created;
+            // 0xAARRGGBB in little-endian memory is B, G, R, A
+            const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(
+                D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+            );
+
+            rt->CreateBitmap(
+                D2D1::SizeU(static_cast<UINT32>(image.width), static_cast<UINT32>(image.height)),
+                image.pixels.data(),
+                static_cast<UINT32>(image.width) * sizeof(uint32_t),
+                props,
+                &created
+            );
+            return created;
+        }, image.pixels.size() * sizeof(uint32_t));
+
+        return bitmap.Get();
+    }
+}
@@ -0,0 +1,121 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/OcclusionCuller.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Lithos {
+    namespace {
+        // Largest inset from each edge at which a rounded corner can still cut into the rect: r * (1 - 1/sqrt(2))
+        constexpr float CornerInsetFactor = 0.29289322f;
+
+        enum GroupState : uint8_t {
+            NoCommands = 0,
+            AllCulled = 1,
+            SomeVisible = 2
+        };
+    }
+
+    OcclusionCuller::OcclusionCuller(const size_t maxOccluders)
+        : maxOccluders(std::max<size_t>(maxOccluders, 1)) {}
+
+    bool OcclusionCuller::OpaqueRect(const DrawCommand& cmd, Rect& out) {
+        if (cmd.color.a < 1.0f) return false;
+
+        Rect r = cmd.rect;
+        switch (cmd.type) {
+            case DrawCommandType::FillRect:
+                break;
+            case DrawCommandType::FillRoundedRect: {
+                const float inset = cmd.radius * CornerInsetFactor;
+                r = r.Inflate(-inset, -inset);
+                break;
+            }
+            default:
+                return false;
+        }
+        r = r.Intersect(cmd.clip);
+
+        // Only whole pixels are guaranteed to be written with full coverage
+        out = {std::ceil(r.left), std::ceil(r.top), std::floor(r.right), std::floor(r.bottom)};
+        return !out.IsEmpty();
+    }
+
+    Rect OcclusionCuller::PixelBounds(const DrawCommand& cmd) {
+        // A plain rect covers only the pixels it overlaps; with the antialiasing margin of
+        // bounds, a panel could never hide an equal-sized one beneath it
+        const Rect r = cmd.type == DrawCommandType::FillRect ? cmd.rect.Intersect(cmd.bounds) : cmd.bounds;
+        return {std::floor(r.left), std::floor(r.top), std::ceil(r.right), std::ceil(r.bottom)};
+    }
+
+    const std::vector<uint8_t>& OcclusionCuller::Cull(const DisplayList& list) {
+        const auto& commands = list.Commands();
+
+        occluders.clear();
+        culled.assign(commands.size(), 0);
+        groupState.assign(static_cast<size_t>(list.GroupCount()) + 1, NoCommands);
+        stats = {};
+
+        for (size_t i = commands.size(); i-- > 0;) {
+            const DrawCommand& cmd = commands[i];
+            const Rect bounds = PixelBounds(cmd);
+
+            const bool hidden = std::any_of(occluders.begin(), occluders.end(), [&](const Rect& o) {
+                return o.Contains(bounds);
+            });
+
+            uint8_t& group = groupState[cmd.group];
+            if (hidden) {
+                culled[i] = 1;
+                stats.commandsCulled++;
+                if (group == NoCommands) group = AllCulled;
+                continue;
+            }
+
+            group = SomeVisible;
+
+            if (Rect opaque; OpaqueRect(cmd, opaque)) {
+                AddOccluder(opaque);
+            }
+        }
+
+        stats.elementsCulled = static_cast<size_t>(std::count(groupState.begin(), groupState.end(), AllCulled));
+        stats.occluders = occluders.size();
+        return culled;
+    }
+
+    void OcclusionCuller::AddOccluder(const Rect& r) {
+        // Skip rects already covered, drop rects the new one covers
+        for (const Rect& o : occluders) {
+            if (o.Contains(r)) return;
+        }
+        std::erase_if(occluders, [&](const Rect& o) { return r.Contains(o); });
+
+        if (occluders.size() < maxOccluders) {
+            occluders.push_back(r);
+            return;
+        }
+
+        const auto area = [](const Rect& o) { return o.Width() * o.Height(); };
+        const auto smallest = std::min_element(occluders.begin(), occluders.end(), [&](const Rect& a, const Rect& b) {
+            return area(a) < area(b);
+        });
+        if (area(*smallest) < area(r)) {
+            *smallest = r;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/RenderThread.hpp"
+
+namespace Lithos {
+    RenderThread::RenderThread(RenderFunction render)
+        : render(std::move(render)) {}
+
+    RenderThread::~RenderThread() {
+        Stop();
+    }
+
+    void RenderThread::Start() {
+        if (thread.joinable()) return;
+        stopping = false;
+        thread = std::thread([this] { Loop(); });
+    }
+
+    void RenderThread::Stop() {
+        if (!thread.joinable()) return;
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    void RenderThread::Publish(std::shared_ptr<const SceneSnapshot> scene) {
+        exchange.Publish(std::move(scene));
+        published.fetch_add(1, std::memory_order_relaxed);
+
+        // The lock only orders the flag against the thread's wait; it is never held during a frame
+        {
+            std::lock_guard lock(mutex);
+            pending = true;
+        }
+        wake.notify_one();
+    }
+
+    RenderThreadStats RenderThread::GetStats() const {
+        RenderThreadStats stats;
+        stats.published = published.load(std::memory_order_relaxed);
+        stats.consumed = consumed.load(std::memory_order_relaxed);
+        stats.frames = frames.load(std::memory_order_relaxed);
+        stats.lastSequence = lastSequence.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    bool RenderThread::WaitForFrames(const uint64_t count, const Clock::duration timeout) const {
+        std::unique_lock lock(mutex);
+        return rendered.wait_for(lock, timeout, [&] { return frames.load(std::memory_order_relaxed) >= count; });
+    }
+
+    void RenderThread::Loop() {
+        std::unique_lock lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || pending; });
+            if (stopping) break;
+            pending = false;
+            lock.unlock();
+
+            // Nothing new means a later wake already took it; the last frame stays on screen
+            const std::shared_ptr<const SceneSnapshot> scene = exchange.Acquire();
+            if (scene) {
+                consumed.fetch_add(1, std::memory_order_relaxed);
+                render(*scene, {frames.load(std::memory_order_relaxed), Clock::now()});
+                lastSequence.store(scene->sequence, std::memory_order_relaxed);
+            }
+
+            lock.lock();
+            if (scene) {
+                frames.fetch_add(1, std::memory_order_relaxed);
+                rendered.notify_all();
+            }
+        }
+    }
+}
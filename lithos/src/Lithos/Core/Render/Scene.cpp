@@ -0,0 +1,151 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/Scene.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+
+namespace Lithos {
+    size_t SceneSnapshot::CommandCount() const {
+        size_t count = 0;
+        for (const auto& chunk : chunks) count += chunk->list.Size();
+        return count;
+    }
+
+    void SceneSnapshot::Flatten(DisplayList& out) const {
+        for (const auto& chunk : chunks) out.Append(chunk->list);
+    }
+
+    std::shared_ptr<const SceneSnapshot> SceneBuilder::Build(const FlatTree& tree, const Rect& viewport) {
+        auto snapshot = std::make_shared<SceneSnapshot>();
+        snapshot->sequence = ++sequence;
+        snapshot->viewport = viewport;
+        snapshot->built = std::chrono::steady_clock::now();
+
+        stats = {};
+        if (boxes.size() != tree.Size()) {
+            // Indices from before a rebuild may now name other nodes; versions tell them apart
+            boxes.resize(tree.Size());
+            subtrees.resize(tree.Size());
+        }
+
+        building = snapshot.get();
+        state.Clear();
+        frames.clear();
+        if (tree.Size() > 0) Visit(tree, 0, viewport);
+        building = nullptr;
+
+        stats.chunks = snapshot->chunks.size();
+        return snapshot;
+    }
+
+    void SceneBuilder::Clear() {
+        boxes.clear();
+        subtrees.clear();
+    }
+
+    size_t SceneBuilder::GetMemoryBytes() const {
+        size_t bytes = CapacityBytes(boxes) + CapacityBytes(subtrees) + CapacityBytes(frames);
+        for (const auto* cache : {&boxes, &subtrees}) {
+            for (const Cached& slot : *cache) {
+                if (slot.chunk) bytes += sizeof(SceneChunk) + slot.chunk->list.GetMemoryBytes();
+            }
+        }
+        return bytes;
+    }
+
+    /*
+     * Mirrors FlatTree::RecordNode down to the chunk roots, so the concatenated chunks
+     * hold exactly the commands FlatTree::Record would produce.
+     */
+    void SceneBuilder::Visit(const FlatTree& tree, const uint32_t node, const Rect& clip) {
+        const uint8_t f = tree.flags[node];
+        const uint32_t size = tree.subtreeEnds[node] - node;
+
+        if ((f & FlatTree::Delegated) || size <= chunkNodes) {
+            Emit(subtrees[node], tree.subtreeVersions[node], clip, [&](DisplayList& list) {
+                tree.RecordNode(node, list, clip);
+            });
+            return;
+        }
+
+        const BoxPaint& paint = tree.paints[node];
+        if (!(f & FlatTree::Visible) || paint.opacity <= 0.0f) return;
+        if (!(f & FlatTree::Unlaid) && !tree.subtreeBounds[node].Intersects(clip)) return;
+
+        // The box alone doesn't depend on the culling clip
+        Emit(boxes[node], tree.versions[node], Rect{}, [&](DisplayList& list) {
+            list.BeginGroup();
+            FlatTree::RecordBox(list, tree.boxes[node], paint);
+        });
+
+        const uint32_t* children = tree.childList.data() + tree.childBegin[node];
+        if (f & FlatTree::ClipsChildren) {
+            const Rect& viewport = tree.clipRects[node];
+            const Rect contentClip = clip.Intersect(viewport).Offset(paint.scrollX, paint.scrollY);
+            if (contentClip.IsEmpty()) return;
+
+            frames.push_back({viewport, paint.scrollX, paint.scrollY});
+            state.PushClip(viewport);
+            state.PushTranslation(-paint.scrollX, -paint.scrollY);
+
+            const auto [first, last] = tree.ChildRange(node, contentClip);
+            for (uint32_t k = first; k < last; ++k) {
+                Visit(tree, children[k], contentClip);
+            }
+
+            state.PopTranslation();
+            state.PopClip();
+            frames.pop_back();
+            return;
+        }
+
+        const auto [first, last] = tree.ChildRange(node, clip);
+        for (uint32_t k = first; k < last; ++k) {
+            Visit(tree, children[k], clip);
+        }
+    }
+
+    template<typename RecordFn>
+    void SceneBuilder::Emit(Cached& slot, const uint64_t version, const Rect& clip, RecordFn&& record) {
+        const Rect& scissor = state.CurrentClip();
+        const auto offset = state.CurrentTranslation();
+
+        if (slot.chunk && slot.version == version && slot.clip == clip && slot.scissor == scissor && slot.offset == offset) {
+            stats.chunksReused++;
+        } else {
+            auto chunk = std::make_shared<SceneChunk>();
+            for (const Frame& frame : frames) {
+                chunk->list.PushClip(frame.viewport);
+                chunk->list.PushTranslation(-frame.scrollX, -frame.scrollY);
+            }
+            record(chunk->list);
+            for (size_t i = 0; i < frames.size(); ++i) {
+                chunk->list.PopTranslation();
+                chunk->list.PopClip();
+            }
+            for (const DrawCommand& cmd : chunk->list.Commands()) {
+                chunk->bounds = chunk->bounds.Union(cmd.bounds);
+            }
+
+            stats.chunksRecorded++;
+            stats.commandsRecorded += chunk->list.Size();
+            slot = {std::move(chunk), version, clip, scissor, offset};
+        }
+
+        // Chunks that only opened groups still count, so group ids match FlatTree::Record
+        if (slot.chunk->list.GroupCount() > 0) building->chunks.push_back(slot.chunk);
+    }
+}
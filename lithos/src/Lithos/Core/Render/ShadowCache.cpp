@@ -0,0 +1,227 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/ShadowCache.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Lithos {
+    namespace {
+        /**
+         * Box widths whose three-fold convolution approximates a Gaussian of the given sigma
+         * (Kovesi, "Fast Almost-Gaussian Filtering").
+         */
+        void BoxesForGauss(const float sigma, int sizes[3]) {
+            if (sigma <= 0.0f) {
+                sizes[0] = sizes[1] = sizes[2] = 1;
+                return;
+            }
+
+            constexpr int n = 3;
+            const float wIdeal = std::sqrt(12.0f * sigma * sigma / n + 1.0f);
+            int wl = static_cast<int>(std::floor(wIdeal));
+            if (wl % 2 == 0) wl--;
+            const int wu = wl + 2;
+
+            const float mIdeal = (12.0f * sigma * sigma - n * wl * wl - 4.0f * n * wl - 3.0f * n) / (-4.0f * wl - 4.0f);
+            const int m = static_cast<int>(std::lround(mIdeal));
+
+            for (int i = 0; i < n; ++i) {
+                sizes[i] = i < m ? wl : wu;
+            }
+        }
+
+        /**
+         * Running-sum box filter over one line, treating samples outside [0, n) as zero.
+         */
+        void BoxBlurLine(const float* src, float* dst, const int n, const int stride, const int k) {
+            if (k <= 0) {
+                for (int i = 0; i < n; ++i) dst[i * stride] = src[i * stride];
+                return;
+            }
+
+            const float inv = 1.0f / static_cast<float>(2 * k + 1);
+            float acc = 0.0f;
+            for (int i = 0; i < std::min(k, n); ++i) {
+                acc += src[i * stride];
+            }
+
+            for (int i = 0; i < n; ++i) {
+                if (i + k < n) acc += src[(i + k) * stride];
+                if (i - k - 1 >= 0) acc -= src[(i - k - 1) * stride];
+                dst[i * stride] = acc * inv;
+            }
+        }
+
+        /**
+         * Anti-aliased coverage of a rounded rectangle, evaluated at pixel centres.
+         */
+        void RasterizeRoundedRect(float* pixels, const int stride,
+                                  const float left, const float top, const float w, const float h,
+                                  const float r) {
+            const float cx = left + w * 0.5f;
+            const float cy = top + h * 0.5f;
+            const float hx = w * 0.5f - r;
+            const float hy = h * 0.5f - r;
+
+            const int x0 = static_cast<int>(std::floor(left));
+            const int y0 = static_cast<int>(std::floor(top));
+            const int x1 = static_cast<int>(std::ceil(left + w));
+            const int y1 = static_cast<int>(std::ceil(top + h));
+
+            for (int py = y0; py < y1; ++py) {
+                const float qy = std::abs(static_cast<float>(py) + 0.5f - cy) - hy;
+                for (int px = x0; px < x1; ++px) {
+                    const float qx = std::abs(static_cast<float>(px) + 0.5f - cx) - hx;
+                    const float ox = std::max(qx, 0.0f);
+                    const float oy = std::max(qy, 0.0f);
+                    const float dist = std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0f) - r;
+                    pixels[py * stride + px] = std::clamp(0.5f - dist, 0.0f, 1.0f);
+                }
+            }
+        }
+
+        /**
+         * Splits one axis into 1 (exact) or 3 (stretched) source/destination segments.
+         */
+        int AxisSegments(const int maskSize, const int shapeSize, const int extent, const int corner,
+                         const bool stretch, const float origin, const float size,
+                         float src[3][2], float dst[3][2]) {
+            if (!stretch || size <= static_cast<float>(shapeSize)) {
+                src[0][0] = 0.0f;
+                src[0][1] = static_cast<float>(maskSize);
+                dst[0][0] = origin - static_cast<float>(extent);
+                dst[0][1] = origin + size + static_cast<float>(extent);
+                return 1;
+            }
+
+            const auto e = static_cast<float>(extent);
+            const auto c = static_cast<float>(corner);
+            const auto m = static_cast<float>(maskSize);
+
+            src[0][0] = 0.0f;      src[0][1] = e + c;
+            src[1][0] = e + c;     src[1][1] = e + c + 1.0f;
+            src[2][0] = e + c + 1; src[2][1] = m;
+
+            dst[0][0] = origin - e;        dst[0][1] = origin + c;
+            dst[1][0] = origin + c;        dst[1][1] = origin + size - c;
+            dst[2][0] = origin + size - c; dst[2][1] = origin + size + e;
+            return 3;
+        }
+    }
+
+    // ========== ShadowMask ==========
+    int ShadowMask::Slices(const float x, const float y, const float w, const float h, ShadowSlice out[9]) const {
+        float srcX[3][2], dstX[3][2], srcY[3][2], dstY[3][2];
+        const int nx = AxisSegments(width, shapeWidth, extent, corner, stretchX, x, w, srcX, dstX);
+        const int ny = AxisSegments(height, shapeHeight, extent, corner, stretchY, y, h, srcY, dstY);
+
+        int count = 0;
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                out[count++] = {
+                    srcX[i][0], srcY[j][0], srcX[i][1], srcY[j][1],
+                    dstX[i][0], dstY[j][0], dstX[i][1], dstY[j][1]
+                };
+            }
+        }
+        return count;
+    }
+
+    // ========== ShadowCache ==========
+    size_t ShadowCache::KeyHash::operator()(const Key& k) const noexcept {
+        size_t h = static_cast<size_t>(k.width);
+        h = h * 31 + static_cast<size_t>(k.height);
+        h = h * 31 + static_cast<size_t>(k.radius);
+        h = h * 31 + static_cast<size_t>(k.blur);
+        return h;
+    }
+
+    ShadowCache::ShadowCache(const size_t budgetBytes)
+        : masks(budgetBytes) {}
+
+    std::shared_ptr<const ShadowMask> ShadowCache::Acquire(const float width, const float height, const float radius, const float blur) {
+        const int w = std::max(0, static_cast<int>(std::lround(width)));
+        const int h = std::max(0, static_cast<int>(std::lround(height)));
+        const int b = std::max(0, static_cast<int>(std::lround(blur)));
+        const int r = std::clamp(static_cast<int>(std::lround(radius)), 0, std::min(w, h) / 2);
+
+        // Shapes larger than the minimal template share the template's mask
+        int sizes[3];
+        BoxesForGauss(static_cast<float>(b) * 0.5f, sizes);
+        const int support = (sizes[0] - 1) / 2 + (sizes[1] - 1) / 2 + (sizes[2] - 1) / 2;
+        const int templateSize = 2 * (r + support + 1) + 1;
+
+        const Key key{std::min(w, templateSize), std::min(h, templateSize), r, b};
+        const int maskW = key.width + 2 * support;
+        const int maskH = key.height + 2 * support;
+
+        return masks.Acquire(key, [&] {
+            auto mask = std::make_shared<ShadowMask>(BuildMask(key.width, key.height, key.radius, key.blur));
+            mask->id = nextId++;
+            return std::shared_ptr<const ShadowMask>(std::move(mask));
+        }, static_cast<size_t>(maskW) * static_cast<size_t>(maskH));
+    }
+
+    ShadowMask ShadowCache::BuildMask(const int width, const int height, const int radius, const int blur) {
+        int sizes[3];
+        BoxesForGauss(static_cast<float>(blur) * 0.5f, sizes);
+        const int support = (sizes[0] - 1) / 2 + (sizes[1] - 1) / 2 + (sizes[2] - 1) / 2;
+
+        ShadowMask mask;
+        mask.shapeWidth = width;
+        mask.shapeHeight = height;
+        mask.extent = support;
+        mask.corner = radius + support + 1;
+        mask.width = width + 2 * support;
+        mask.height = height + 2 * support;
+        mask.stretchX = width >= 2 * mask.corner + 1;
+        mask.stretchY = height >= 2 * mask.corner + 1;
+
+        const int mw = mask.width;
+        const int mh = mask.height;
+        std::vector<float> a(static_cast<size_t>(mw) * mh, 0.0f);
+        std::vector<float> b(a.size(), 0.0f);
+
+        RasterizeRoundedRect(a.data(), mw,
+                             static_cast<float>(support), static_cast<float>(support),
+                             static_cast<float>(width), static_cast<float>(height),
+                             static_cast<float>(radius));
+
+        // Separable: three horizontal box passes, then three vertical ones
+        for (const int size : sizes) {
+            const int k = (size - 1) / 2;
+            for (int y = 0; y < mh; ++y) {
+                BoxBlurLine(a.data() + static_cast<size_t>(y) * mw, b.data() + static_cast<size_t>(y) * mw, mw, 1, k);
+            }
+            a.swap(b);
+        }
+        for (const int size : sizes) {
+            const int k = (size - 1) / 2;
+            for (int x = 0; x < mw; ++x) {
+                BoxBlurLine(a.data() + x, b.data() + x, mh, mw, k);
+            }
+            a.swap(b);
+        }
+
+        mask.alpha.resize(a.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            mask.alpha[i] = static_cast<uint8_t>(std::lround(std::clamp(a[i], 0.0f, 1.0f) * 255.0f));
+        }
+
+        return mask;
+    }
+}
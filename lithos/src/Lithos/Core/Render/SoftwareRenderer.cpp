@@ -0,0 +1,454 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Render/SoftwareRenderer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace Lithos {
+    namespace {
+        using PixelRect = SoftwareRenderer::PixelRect;
+
+        struct Premul {
+            uint32_t a, r, g, b;
+        };
+
+        Premul ToPremul(const Color& c) {
+            const float a = std::clamp(c.a, 0.0f, 1.0f);
+            const auto q = [](const float v) { return static_cast<uint32_t>(std::lround(v * 255.0f)); };
+            return {
+                q(a),
+                q(std::clamp(c.r, 0.0f, 1.0f) * a),
+                q(std::clamp(c.g, 0.0f, 1.0f) * a),
+                q(std::clamp(c.b, 0.0f, 1.0f) * a)
+            };
+        }
+
+        uint32_t Pack(const Premul& p) {
+            return p.a << 24 | p.r << 16 | p.g << 8 | p.b;
+        }
+
+        /**
+         * Exact rounded a * b / 255 for 8-bit operands
+         */
+        uint32_t Mul255(const uint32_t a, const uint32_t b) {
+            const uint32_t t = a * b + 128;
+            return (t + (t >> 8)) >> 8;
+        }
+
+        /**
+         * Source-over blend of a premultiplied color scaled by 8-bit coverage
+         */
+        void Blend(uint32_t& dst, const Premul& src, const uint32_t coverage) {
+            if (coverage == 0) return;
+
+            Premul s = src;
+            if (coverage != 255) {
+                s = {Mul255(s.a, coverage), Mul255(s.r, coverage), Mul255(s.g, coverage), Mul255(s.b, coverage)};
+            }
+            if (s.a == 255) {
+                dst = Pack(s);
+                return;
+            }
+
+            const uint32_t inv = 255 - s.a;
+            const uint32_t d = dst;
+            dst = (s.a + Mul255(d >> 24, inv)) << 24
+                | (s.r + Mul255(d >> 16 & 0xFF, inv)) << 16
+                | (s.g + Mul255(d >> 8 & 0xFF, inv)) << 8
+                | (s.b + Mul255(d & 0xFF, inv));
+        }
+
+        uint32_t ToCoverage(const float c) {
+            return static_cast<uint32_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+        }
+
+        float AxisCoverage(const int p, const float lo, const float hi) {
+            return std::clamp(std::min(static_cast<float>(p) + 1.0f, hi) - std::max(static_cast<float>(p), lo), 0.0f, 1.0f);
+        }
+
+        /**
+         * Area coverage of an axis-aligned rect over pixel (px, py)
+         */
+        float RectCoverage(const Rect& r, const int px, const int py) {
+            return AxisCoverage(px, r.left, r.right) * AxisCoverage(py, r.top, r.bottom);
+        }
+
+        /**
+         * Coverage of a rounded rect at the pixel centre from its signed distance
+         */
+        float RoundedRectCoverage(const Rect& r, const float radius, const int px, const int py) {
+            if (radius <= 0.0f) return RectCoverage(r, px, py);
+
+            const float cx = (r.left + r.right) * 0.5f;
+            const float cy = (r.top + r.bottom) * 0.5f;
+            const float qx = std::abs(static_cast<float>(px) + 0.5f - cx) - (r.Width() * 0.5f - radius);
+            const float qy = std::abs(static_cast<float>(py) + 0.5f - cy) - (r.Height() * 0.5f - radius);
+
+            // Straight edges: use exact area coverage
+            if (qx <= 0.0f || qy <= 0.0f) return RectCoverage(r, px, py);
+
+            const float dist = std::sqrt(qx * qx + qy * qy) - radius;
+            return std::clamp(0.5f - dist, 0.0f, 1.0f);
+        }
+
+        PixelRect Clip(const Rect& r, const PixelRect& clip) {
+            return {
+                std::max(clip.x0, static_cast<int>(std::floor(r.left))),
+                std::max(clip.y0, static_cast<int>(std::floor(r.top))),
+                std::min(clip.x1, static_cast<int>(std::ceil(r.right))),
+                std::min(clip.y1, static_cast<int>(std::ceil(r.bottom)))
+            };
+        }
+
+        bool Overlaps(const PixelRect& a, const PixelRect& b) {
+            return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+        }
+
+        PixelRect Intersect(const PixelRect& a, const PixelRect& b) {
+            return {std::max(a.x0, b.x0), std::max(a.y0, b.y0), std::min(a.x1, b.x1), std::min(a.y1, b.y1)};
+        }
+
+        void DrawShadow(Framebuffer& fb, const DrawCommand& cmd, const ShadowMask& mask, const Premul& color, const PixelRect& clip) {
+            ShadowSlice slices[9];
+            const int count = mask.Slices(cmd.rect.left, cmd.rect.top, cmd.rect.Width(), cmd.rect.Height(), slices);
+
+            for (int i = 0; i < count; ++i) {
+                const ShadowSlice& s = slices[i];
+                const float dw = s.dstRight - s.dstLeft;
+                const float dh = s.dstBottom - s.dstTop;
+                if (dw <= 0.0f || dh <= 0.0f) continue;
+
+                const float sx = (s.srcRight - s.srcLeft) / dw;
+                const float sy = (s.srcBottom - s.srcTop) / dh;
+                const PixelRect area = Clip({s.dstLeft, s.dstTop, s.dstRight, s.dstBottom}, clip);
+
+                for (int py = area.y0; py < area.y1; ++py) {
+                    // A pixel belongs to the slice its centre falls into
+                    const float cy = static_cast<float>(py) + 0.5f;
+                    if (cy < s.dstTop || cy >= s.dstBottom) continue;
+                    const int v = std::clamp(static_cast<int>(s.srcTop + (cy - s.dstTop) * sy), 0, mask.height - 1);
+                    const uint8_t* src = mask.alpha.data() + static_cast<size_t>(v) * mask.width;
+                    uint32_t* row = fb.Row(py);
+
+                    for (int px = area.x0; px < area.x1; ++px) {
+                        const float cx = static_cast<float>(px) + 0.5f;
+                        if (cx < s.dstLeft || cx >= s.dstRight) continue;
+                        const int u = std::clamp(static_cast<int>(s.srcLeft + (cx - s.dstLeft) * sx), 0, mask.width - 1);
+                        Blend(row[px], color, src[u]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Nearest-neighbour stretch of a premultiplied image to cmd.rect, faded by cmd.color.a
+         */
+        void DrawImage(Framebuffer& fb, const DrawCommand& cmd, const DecodedImage& image, const PixelRect& clip) {
+            const Rect& r = cmd.rect;
+            if (r.IsEmpty() || image.width <= 0 || image.height <= 0) return;
+
+            const PixelRect area = Clip(r, clip);
+            const uint32_t opacity = ToCoverage(cmd.color.a);
+            const float sx = static_cast<float>(image.width) / r.Width();
+            const float sy = static_cast<float>(image.height) / r.Height();
+
+            for (int py = area.y0; py < area.y1; ++py) {
+                const float cy = static_cast<float>(py) + 0.5f;
+                const int v = std::clamp(static_cast<int>((cy - r.top) * sy), 0, image.height - 1);
+                const uint32_t* src = image.pixels.data() + static_cast<size_t>(v) * image.width;
+                uint32_t* row = fb.Row(py);
+
+                for (int px = area.x0; px < area.x1; ++px) {
+                    const float cx = static_cast<float>(px) + 0.5f;
+                    const int u = std::clamp(static_cast<int>((cx - r.left) * sx), 0, image.width - 1);
+                    const uint32_t p = src[u];
+                    const Premul texel{p >> 24, p >> 16 & 0xFF, p >> 8 & 0xFF, p & 0xFF};
+                    Blend(row[px], texel, Mul255(opacity, ToCoverage(RectCoverage(r, px, py))));
+                }
+            }
+        }
+
+        void DrawCommandClipped(Framebuffer& fb, const DisplayList& list, const DrawCommand& cmd, const ShadowMask* mask,
+                                const PixelRect& clip) {
+            const PixelRect area = Clip(cmd.bounds, clip);
+            if (area.x0 >= area.x1 || area.y0 >= area.y1) return;
+
+            const Premul color = ToPremul(cmd.color);
+
+            switch (cmd.type) {
+                case DrawCommandType::FillRect:
+                    for (int py = area.y0; py < area.y1; ++py) {
+                        uint32_t* row = fb.Row(py);
+                        for (int px = area.x0; px < area.x1; ++px) {
+                            Blend(row[px], color, ToCoverage(RectCoverage(cmd.rect, px, py)));
+                        }
+                    }
+                    break;
+
+                case DrawCommandType::FillRoundedRect:
+                    for (int py = area.y0; py < area.y1; ++py) {
+                        uint32_t* row = fb.Row(py);
+                        for (int px = area.x0; px < area.x1; ++px) {
+                            Blend(row[px], color, ToCoverage(RoundedRectCoverage(cmd.rect, cmd.radius, px, py)));
+                        }
+                    }
+                    break;
+
+                case DrawCommandType::StrokeRect: {
+                    const Rect inner = cmd.rect.Inflate(-cmd.param, -cmd.param);
+                    const float innerRadius = std::max(0.0f, cmd.radius - cmd.param);
+                    const bool hollow = !inner.IsEmpty();
+
+                    // Pixels well inside the inner edge get zero coverage; skip that span
+                    const float corner = innerRadius + 1.0f;
+                    const int holeX0 = static_cast<int>(std::ceil(inner.left + corner));
+                    const int holeX1 = static_cast<int>(std::floor(inner.right - corner));
+                    const int holeY0 = static_cast<int>(std::ceil(inner.top + 1.0f));
+                    const int holeY1 = static_cast<int>(std::floor(inner.bottom - 1.0f));
+
+                    for (int py = area.y0; py < area.y1; ++py) {
+                        uint32_t* row = fb.Row(py);
+                        const bool holeRow = hollow && py >= holeY0 && py < holeY1 && holeX0 < holeX1;
+                        for (int px = area.x0; px < area.x1; ++px) {
+                            if (holeRow && px >= holeX0 && px < holeX1) {
+                                px = holeX1 - 1;
+                                continue;
+                            }
+                            const float outer = RoundedRectCoverage(cmd.rect, cmd.radius, px, py);
+                            const float in = hollow ? RoundedRectCoverage(inner, innerRadius, px, py) : 0.0f;
+                            Blend(row[px], color, ToCoverage(outer - in));
+                        }
+                    }
+                    break;
+                }
+
+                case DrawCommandType::Shadow:
+                    if (mask) DrawShadow(fb, cmd, *mask, color, area);
+                    break;
+
+                case DrawCommandType::Text:
+                    // No glyph rasterizer here; text only appears on the Direct2D path
+                    break;
+
+                case DrawCommandType::Image:
+                    DrawImage(fb, cmd, list.GetImage(cmd), area);
+                    break;
+            }
+        }
+
+        /**
+         * Clears and draws one clip rect; returns the number of bin entries skipped
+         * because a later opaque command covers the whole rect
+         */
+        size_t RasterRegion(Framebuffer& fb, const DisplayList& list,
+                            const std::vector<std::shared_ptr<const ShadowMask>>& masks,
+                            const std::vector<uint32_t>& bin, const PixelRect& clip, const uint32_t clear,
+                            const bool skipCovered) {
+            const auto& commands = list.Commands();
+            const Rect clipRect{
+                static_cast<float>(clip.x0), static_cast<float>(clip.y0),
+                static_cast<float>(clip.x1), static_cast<float>(clip.y1)
+            };
+
+            size_t first = 0;
+            bool covered = false;
+            if (skipCovered) {
+                for (size_t i = bin.size(); i-- > 0;) {
+                    if (Rect opaque; OcclusionCuller::OpaqueRect(commands[bin[i]], opaque) && opaque.Contains(clipRect)) {
+                        first = i;
+                        covered = true;
+                        break;
+                    }
+                }
+            }
+
+            // A covering opaque fill overwrites every pixel, so clearing would be wasted
+            if (!covered) {
+                for (int py = clip.y0; py < clip.y1; ++py) {
+                    std::fill(fb.Row(py) + clip.x0, fb.Row(py) + clip.x1, clear);
+                }
+            }
+
+            for (size_t i = first; i < bin.size(); ++i) {
+                const uint32_t index = bin[i];
+                DrawCommandClipped(fb, list, commands[index], masks[index].get(), clip);
+            }
+            return first;
+        }
+    }
+
+    SoftwareRenderer::SoftwareRenderer(const unsigned threadCount, const int tileSize)
+        : tileSize(std::max(8, tileSize)) {
+        SetThreadCount(threadCount);
+    }
+
+    void SoftwareRenderer::SetThreadCount(const unsigned threadCount) {
+        if (threadCount == 0) {
+            ownJobs.reset();
+            jobs = &JobSystem::Shared();
+        } else {
+            ownJobs = std::make_unique<JobSystem>(threadCount - 1);
+            jobs = ownJobs.get();
+        }
+    }
+
+    void SoftwareRenderer::Prepare(const DisplayList& list, const Framebuffer& target, const std::span<const Rect> damage) {
+        const PixelRect frame{0, 0, target.width, target.height};
+
+        // Damage as non-overlapping pixel rects (overlaps merged into their bounds)
+        regions.clear();
+        if (damage.empty()) {
+            regions.push_back(frame);
+        } else {
+            for (const Rect& r : damage) {
+                const PixelRect p = Clip(r, frame);
+                if (p.x0 < p.x1 && p.y0 < p.y1) regions.push_back(p);
+            }
+
+            for (bool merged = true; merged;) {
+                merged = false;
+                for (size_t i = 0; i < regions.size() && !merged; ++i) {
+                    for (size_t j = i + 1; j < regions.size(); ++j) {
+                        if (Overlaps(regions[i], regions[j])) {
+                            regions[i] = {
+                                std::min(regions[i].x0, regions[j].x0), std::min(regions[i].y0, regions[j].y0),
+                                std::max(regions[i].x1, regions[j].x1), std::max(regions[i].y1, regions[j].y1)
+                            };
+                            regions.erase(regions.begin() + static_cast<std::ptrdiff_t>(j));
+                            merged = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Shadow masks come from a non-thread-safe cache, so resolve them up front
+        const auto& commands = list.Commands();
+        masks.assign(commands.size(), nullptr);
+        for (size_t i = 0; i < commands.size(); ++i) {
+            const DrawCommand& cmd = commands[i];
+            if (cmd.type == DrawCommandType::Shadow) {
+                masks[i] = shadowCache.Acquire(cmd.rect.Width(), cmd.rect.Height(), cmd.radius, cmd.param);
+            }
+        }
+
+        stats = {};
+        stats.commands = commands.size();
+
+        if (occlusionCulling) {
+            culled = occlusionCuller.Cull(list);
+            stats.commandsCulled = occlusionCuller.GetStats().commandsCulled;
+            stats.elementsCulled = occlusionCuller.GetStats().elementsCulled;
+        } else {
+            culled.assign(commands.size(), 0);
+        }
+    }
+
+    void SoftwareRenderer::Render(const DisplayList& list, Framebuffer& target,
+                                  const std::span<const Rect> damage, const Color& clearColor) {
+        Prepare(list, target, damage);
+        if (target.width <= 0 || target.height <= 0) return;
+
+        const int tilesX = (target.width + tileSize - 1) / tileSize;
+        const int tilesY = (target.height + tileSize - 1) / tileSize;
+        const size_t tileCount = static_cast<size_t>(tilesX) * static_cast<size_t>(tilesY);
+        stats.tilesTotal = tileCount;
+
+        if (bins.size() < tileCount) bins.resize(tileCount);
+
+        // Mark tiles touched by damage
+        activeTiles.clear();
+        std::vector<uint8_t>& active = tileActive;
+        active.assign(tileCount, 0);
+        for (const PixelRect& r : regions) {
+            for (int ty = r.y0 / tileSize; ty <= (r.y1 - 1) / tileSize; ++ty) {
+                for (int tx = r.x0 / tileSize; tx <= (r.x1 - 1) / tileSize; ++tx) {
+                    active[static_cast<size_t>(ty) * tilesX + tx] = 1;
+                }
+            }
+        }
+        for (size_t t = 0; t < tileCount; ++t) {
+            bins[t].clear();
+            if (active[t]) activeTiles.push_back(static_cast<uint32_t>(t));
+        }
+
+        // Bin commands in painter's order
+        const PixelRect frame{0, 0, target.width, target.height};
+        const auto& commands = list.Commands();
+        for (size_t i = 0; i < commands.size(); ++i) {
+            if (culled[i]) continue;
+            const PixelRect b = Clip(commands[i].bounds, frame);
+            if (b.x0 >= b.x1 || b.y0 >= b.y1) continue;
+
+            for (int ty = b.y0 / tileSize; ty <= (b.y1 - 1) / tileSize; ++ty) {
+                for (int tx = b.x0 / tileSize; tx <= (b.x1 - 1) / tileSize; ++tx) {
+                    const size_t t = static_cast<size_t>(ty) * tilesX + tx;
+                    if (active[t]) {
+                        bins[t].push_back(static_cast<uint32_t>(i));
+                        stats.binEntries++;
+                    }
+                }
+            }
+        }
+
+        stats.tilesRendered = activeTiles.size();
+        stats.tilesSkipped = tileCount - activeTiles.size();
+
+        const uint32_t clear = Pack(ToPremul(clearColor));
+        std::atomic<size_t> skipped{0};
+
+        jobs->ParallelFor(activeTiles.size(), [&](const size_t i) {
+            const uint32_t t = activeTiles[i];
+            const int tx = static_cast<int>(t % static_cast<uint32_t>(tilesX));
+            const int ty = static_cast<int>(t / static_cast<uint32_t>(tilesX));
+            const PixelRect tile{
+                tx * tileSize, ty * tileSize,
+                std::min((tx + 1) * tileSize, target.width), std::min((ty + 1) * tileSize, target.height)
+            };
+
+            size_t tileSkipped = 0;
+            for (const PixelRect& r : regions) {
+                if (!Overlaps(tile, r)) continue;
+                tileSkipped += RasterRegion(target, list, masks, bins[t], Intersect(tile, r), clear, occlusionCulling);
+            }
+            skipped.fetch_add(tileSkipped, std::memory_order_relaxed);
+        }, 1);
+
+        stats.regionSkips = skipped.load();
+    }
+
+    void SoftwareRenderer::RenderSerial(const DisplayList& list, Framebuffer& target,
+                                        const std::span<const Rect> damage, const Color& clearColor) {
+        Prepare(list, target, damage);
+        if (target.width <= 0 || target.height <= 0) return;
+
+        const uint32_t clear = Pack(ToPremul(clearColor));
+        const auto& commands = list.Commands();
+
+        for (const PixelRect& r : regions) {
+            serialBin.clear();
+            for (size_t i = 0; i < commands.size(); ++i) {
+                if (culled[i]) continue;
+                const PixelRect b = Clip(commands[i].bounds, r);
+                if (b.x0 < b.x1 && b.y0 < b.y1) serialBin.push_back(static_cast<uint32_t>(i));
+            }
+            stats.regionSkips += RasterRegion(target, list, masks, serialBin, r, clear, occlusionCulling);
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace Lithos {
+    namespace {
+        constexpr int MaxCellsPerItem = 16;
+        constexpr size_t GridCellsPerItem = 4;     // Cap on grid size relative to item count
+        constexpr size_t MinLinearBeforeRebuild = 32;
+    }
+
+    void SpatialIndex::Build(const std::span<const Rect> items) {
+        rects.assign(items.begin(), items.end());
+        cellStart.clear();
+        cellEnd.clear();
+        cellItems.clear();
+        linear.clear();
+        isLinear.assign(rects.size(), 0);
+        cols = rows = 0;
+
+        extent = {};
+        double sizeSum = 0.0;
+        size_t indexed = 0;
+        for (const Rect& r : rects) {
+            if (r.IsEmpty()) continue;
+            extent = extent.Union(r);
+            sizeSum += std::max(r.Width(), r.Height());
+            indexed++;
+        }
+        if (indexed == 0) return;
+
+        // Cells about the size of an average item, capped so sparse layouts don't explode the grid
+        cellSize = std::max(static_cast<float>(sizeSum / static_cast<double>(indexed)), 1.0f);
+        const double area = static_cast<double>(extent.Width()) * extent.Height();
+        const double maxCells = static_cast<double>(indexed * GridCellsPerItem);
+        if (area / (static_cast<double>(cellSize) * cellSize) > maxCells) {
+            cellSize = static_cast<float>(std::sqrt(area / maxCells));
+        }
+        cols = std::max(1, static_cast<int>(std::ceil(extent.Width() / cellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(extent.Height() / cellSize)));
+
+        // Counting sort into CSR: count, prefix-sum (leaving room for one mover per occupied cell), scatter
+        cellStart.assign(CellCount() + 1, 0);
+        for (uint32_t i = 0; i < rects.size(); ++i) {
+            int c0, r0, c1, r1;
+            if (rects[i].IsEmpty()) continue;
+            if (!Fits(rects[i], c0, r0, c1, r1)) {
+                linear.push_back(i);
+                isLinear[i] = 1;
+                continue;
+            }
+            for (int cy = r0; cy <= r1; ++cy) {
+                for (int cx = c0; cx <= c1; ++cx) {
+                    cellStart[static_cast<size_t>(cy) * cols + cx + 1]++;
+                }
+            }
+        }
+        for (size_t c = 1; c < cellStart.size(); ++c) {
+            cellStart[c] += cellStart[c - 1] + (cellStart[c] > 0 ? 1 : 0);
+        }
+
+        cellItems.resize(cellStart.back());
+        cellEnd.assign(cellStart.begin(), cellStart.end() - 1);
+        for (uint32_t i = 0; i < rects.size(); ++i) {
+            int c0, r0, c1, r1;
+            if (rects[i].IsEmpty() || isLinear[i]) continue;
+            Fits(rects[i], c0, r0, c1, r1);
+            for (int cy = r0; cy <= r1; ++cy) {
+                for (int cx = c0; cx <= c1; ++cx) {
+                    cellItems[cellEnd[static_cast<size_t>(cy) * cols + cx]++] = i;
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::Clear() {
+        rects.clear();
+        cellStart.clear();
+        cellEnd.clear();
+        cellItems.clear();
+        linear.clear();
+        isLinear.clear();
+        cols = rows = 0;
+    }
+
+    void SpatialIndex::Update(const uint32_t item, const Rect& rect) {
+        const Rect old = rects[item];
+        if (old == rect) return;
+        if (cols == 0) {
+            rects[item] = rect;
+            if (!rect.IsEmpty()) Build(std::vector<Rect>(rects));     // Nothing indexed yet: no grid to move within
+            return;
+        }
+
+        // Out of the cells (or the linear list) it was in
+        int c0, r0, c1, r1;
+        if (isLinear[item]) {
+            linear.erase(std::find(linear.begin(), linear.end(), item));
+            isLinear[item] = 0;
+        } else if (!old.IsEmpty()) {
+            CellRange(old, c0, r0, c1, r1);
+            for (int cy = r0; cy <= r1; ++cy) {
+                for (int cx = c0; cx <= c1; ++cx) {
+                    const size_t cell = static_cast<size_t>(cy) * cols + cx;
+                    uint32_t* first = cellItems.data() + cellStart[cell];
+                    uint32_t* last = cellItems.data() + cellEnd[cell];
+                    *std::find(first, last, item) = *(last - 1);
+                    cellEnd[cell]--;
+                }
+            }
+        }
+
+        // Into its new cells if they all have room, else onto the linear list
+        rects[item] = rect;
+        if (rect.IsEmpty()) return;
+        bool room = Fits(rect, c0, r0, c1, r1);
+        for (int cy = r0; room && cy <= r1; ++cy) {
+            for (int cx = c0; cx <= c1; ++cx) {
+                const size_t cell = static_cast<size_t>(cy) * cols + cx;
+                if (cellEnd[cell] == cellStart[cell + 1]) {
+                    room = false;
+                    break;
+                }
+            }
+        }
+        if (room) {
+            for (int cy = r0; cy <= r1; ++cy) {
+                for (int cx = c0; cx <= c1; ++cx) {
+                    const size_t cell = static_cast<size_t>(cy) * cols + cx;
+                    cellItems[cellEnd[cell]++] = item;
+                }
+            }
+            return;
+        }
+
+        linear.push_back(item);
+        isLinear[item] = 1;
+        if (linear.size() > std::max<size_t>(MinLinearBeforeRebuild, rects.size() / 8)) {
+            Build(std::vector<Rect>(rects));
+        }
+    }
+
+    void SpatialIndex::Query(const float x, const float y, std::vector<uint32_t>& out) const {
+        if (cols == 0) return;
+
+        const size_t base = out.size();
+
+        if (extent.Contains(x, y)) {
+            const int cx = std::min(static_cast<int>((x - extent.left) / cellSize), cols - 1);
+            const int cy = std::min(static_cast<int>((y - extent.top) / cellSize), rows - 1);
+            const size_t cell = static_cast<size_t>(cy) * cols + cx;
+
+            for (uint32_t k = cellStart[cell]; k < cellEnd[cell]; ++k) {
+                if (rects[cellItems[k]].Contains(x, y)) out.push_back(cellItems[k]);
+            }
+        }
+        for (const uint32_t i : linear) {
+            if (rects[i].Contains(x, y)) out.push_back(i);
+        }
+
+        // Moves and the linear list leave hits out of order; hand back topmost first
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(base), out.end(), std::greater<>());
+    }
+
+    void SpatialIndex::CellRange(const Rect& r, int& c0, int& r0, int& c1, int& r1) const {
+        const auto cell = [&](const float v, const float origin, const int count) {
+            return std::clamp(static_cast<int>((v - origin) / cellSize), 0, count - 1);
+        };
+        c0 = cell(r.left, extent.left, cols);
+        c1 = cell(r.right, extent.left, cols);
+        r0 = cell(r.top, extent.top, rows);
+        r1 = cell(r.bottom, extent.top, rows);
+    }
+
+    bool SpatialIndex::Fits(const Rect& r, int& c0, int& r0, int& c1, int& r1) const {
+        // Cells clamp to the grid's edges, so a rect reaching outside it can't live in them
+        CellRange(r, c0, r0, c1, r1);
+        return (c1 - c0 + 1) * (r1 - r0 + 1) <= MaxCellsPerItem
+            && r.left >= extent.left && r.top >= extent.top && r.right <= extent.right && r.bottom <= extent.bottom;
+    }
+}
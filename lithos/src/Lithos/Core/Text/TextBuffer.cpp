@@ -0,0 +1,313 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Text/TextBuffer.hpp"
+#include <algorithm>
+#include "Lithos/Core/MemoryReport.hpp"
+
+namespace Lithos {
+    TextBuffer::TextBuffer(const std::wstring_view text) {
+        SetText(text);
+    }
+
+    void TextBuffer::SetText(const std::wstring_view text) {
+        for (Buffer& buffer : buffers) {
+            buffer.text.clear();
+            buffer.breaks.clear();
+        }
+        nodes.resize(1);
+        freeNodes.clear();
+        root = Null;
+
+        if (text.empty()) return;
+        AppendText(buffers[0], text);
+        root = NewNode(0, 0, text.size());
+    }
+
+    void TextBuffer::Insert(size_t offset, const std::wstring_view text) {
+        if (text.empty()) return;
+        offset = std::min(offset, Length());
+
+        uint32_t left, right;
+        Split(root, offset, left, right);
+
+        Buffer& added = buffers[1];
+        const size_t start = added.text.size();
+        const size_t breaksBefore = added.breaks.size();
+        AppendText(added, text);
+        const size_t newBreaks = added.breaks.size() - breaksBefore;
+
+        // Continuing the previous insertion: grow its piece and the totals above it
+        uint32_t last = left;
+        while (last != Null && nodes[last].right != Null) last = nodes[last].right;
+        if (last != Null && nodes[last].buffer == 1 && nodes[last].start + nodes[last].length == start) {
+            nodes[last].length += text.size();
+            nodes[last].breaks += newBreaks;
+            for (uint32_t t = left; t != Null; t = nodes[t].right) {
+                nodes[t].size += text.size();
+                nodes[t].subtreeBreaks += newBreaks;
+            }
+        } else {
+            left = Merge(left, NewNode(1, start, text.size()));
+        }
+
+        root = Merge(left, right);
+    }
+
+    void TextBuffer::Erase(size_t offset, size_t count) {
+        const size_t length = Length();
+        if (offset >= length || count == 0) return;
+        count = std::min(count, length - offset);
+
+        uint32_t left, middle, right;
+        Split(root, offset, left, middle);
+        Split(middle, count, middle, right);
+        FreeSubtree(middle);
+        root = Merge(left, right);
+    }
+
+    void TextBuffer::Compact() {
+        const std::wstring text = ToString();
+        SetText(text);
+        for (Buffer& buffer : buffers) {
+            buffer.text.shrink_to_fit();
+            buffer.breaks.shrink_to_fit();
+        }
+        nodes.shrink_to_fit();
+        freeNodes.shrink_to_fit();
+    }
+
+    size_t TextBuffer::LineStart(const size_t line) const {
+        if (line == 0) return 0;
+        if (line >= LineCount()) return Length();
+
+        // Find the line-th break; the line starts right after it
+        size_t remaining = line;
+        size_t base = 0;
+        uint32_t t = root;
+        while (t != Null) {
+            const Node& n = nodes[t];
+            const size_t leftBreaks = nodes[n.left].subtreeBreaks;
+            if (remaining <= leftBreaks) {
+                t = n.left;
+                continue;
+            }
+            remaining -= leftBreaks;
+            base += nodes[n.left].size;
+
+            if (remaining <= n.breaks) {
+                const auto& breaks = buffers[n.buffer].breaks;
+                const auto first = std::lower_bound(breaks.begin(), breaks.end(), n.start);
+                return base + (*(first + static_cast<ptrdiff_t>(remaining - 1)) - n.start) + 1;
+            }
+            remaining -= n.breaks;
+            base += n.length;
+            t = n.right;
+        }
+        return Length();
+    }
+
+    size_t TextBuffer::LineLength(const size_t line) const {
+        const size_t start = LineStart(line);
+        const size_t end = line + 1 < LineCount() ? LineStart(line + 1) - 1 : Length();
+        return end - start;
+    }
+
+    size_t TextBuffer::LineOf(size_t offset) const {
+        offset = std::min(offset, Length());
+
+        // Count the breaks before offset
+        size_t line = 0;
+        uint32_t t = root;
+        while (t != Null) {
+            const Node& n = nodes[t];
+            const size_t leftSize = nodes[n.left].size;
+            if (offset < leftSize) {
+                t = n.left;
+                continue;
+            }
+            offset -= leftSize;
+            line += nodes[n.left].subtreeBreaks;
+
+            if (offset < n.length) {
+                return line + CountBreaks(n.buffer, n.start, offset);
+            }
+            offset -= n.length;
+            line += n.breaks;
+            t = n.right;
+        }
+        return line;
+    }
+
+    void TextBuffer::CopyText(const size_t offset, size_t count, std::wstring& out) const {
+        const size_t length = Length();
+        if (offset >= length) return;
+        count = std::min(count, length - offset);
+        out.reserve(out.size() + count);
+        Copy(root, offset, count, out);
+    }
+
+    std::wstring TextBuffer::GetText(const size_t offset, const size_t count) const {
+        std::wstring out;
+        CopyText(offset, count, out);
+        return out;
+    }
+
+    std::wstring TextBuffer::GetLine(const size_t line) const {
+        return GetText(LineStart(line), LineLength(line));
+    }
+
+    size_t TextBuffer::GetMemoryBytes() const {
+        size_t bytes = CapacityBytes(nodes) + CapacityBytes(freeNodes);
+        for (const Buffer& buffer : buffers) {
+            bytes += buffer.text.capacity() * sizeof(wchar_t) + CapacityBytes(buffer.breaks);
+        }
+        return bytes;
+    }
+
+    uint32_t TextBuffer::NewNode(const uint8_t buffer, const size_t start, const size_t length) {
+        uint32_t index;
+        if (!freeNodes.empty()) {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        } else {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        // xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        Node& n = nodes[index];
+        n = Node{};
+        n.priority = seed;
+        n.buffer = buffer;
+        n.start = start;
+        n.length = length;
+        n.breaks = CountBreaks(buffer, start, length);
+        Update(index);
+        return index;
+    }
+
+    void TextBuffer::FreeSubtree(const uint32_t node) {
+        if (node == Null) return;
+        FreeSubtree(nodes[node].left);
+        FreeSubtree(nodes[node].right);
+        freeNodes.push_back(node);
+    }
+
+    void TextBuffer::Update(const uint32_t node) {
+        Node& n = nodes[node];
+        n.size = nodes[n.left].size + n.length + nodes[n.right].size;
+        n.subtreeBreaks = nodes[n.left].subtreeBreaks + n.breaks + nodes[n.right].subtreeBreaks;
+    }
+
+    size_t TextBuffer::CountBreaks(const uint8_t buffer, const size_t start, const size_t length) const {
+        const auto& breaks = buffers[buffer].breaks;
+        const auto first = std::lower_bound(breaks.begin(), breaks.end(), start);
+        const auto last = std::lower_bound(first, breaks.end(), start + length);
+        return static_cast<size_t>(last - first);
+    }
+
+    void TextBuffer::AppendText(Buffer& buffer, const std::wstring_view text) {
+        const size_t base = buffer.text.size();
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == L'\n') buffer.breaks.push_back(base + i);
+        }
+        buffer.text.append(text);
+    }
+
+    void TextBuffer::Split(const uint32_t node, const size_t offset, uint32_t& left, uint32_t& right) {
+        if (node == Null) {
+            left = right = Null;
+            return;
+        }
+
+        const size_t leftSize = nodes[nodes[node].left].size;
+        const size_t length = nodes[node].length;
+        uint32_t a, b;
+
+        if (offset <= leftSize) {
+            Split(nodes[node].left, offset, a, b);
+            nodes[node].left = b;
+            Update(node);
+            left = a;
+            right = node;
+        } else if (offset >= leftSize + length) {
+            Split(nodes[node].right, offset - leftSize - length, a, b);
+            nodes[node].right = a;
+            Update(node);
+            left = node;
+            right = b;
+        } else {
+            // Cut inside the piece. The tail keeps the node's priority and takes its
+            // right subtree, so both halves remain valid treaps.
+            const size_t cut = offset - leftSize;
+            const uint32_t tail = NewNode(nodes[node].buffer, nodes[node].start + cut, length - cut);
+            nodes[tail].priority = nodes[node].priority;
+            nodes[tail].right = nodes[node].right;
+            Update(tail);
+
+            nodes[node].right = Null;
+            nodes[node].length = cut;
+            nodes[node].breaks -= nodes[tail].breaks;
+            Update(node);
+
+            left = node;
+            right = tail;
+        }
+    }
+
+    uint32_t TextBuffer::Merge(const uint32_t left, const uint32_t right) {
+        if (left == Null) return right;
+        if (right == Null) return left;
+
+        if (nodes[left].priority >= nodes[right].priority) {
+            nodes[left].right = Merge(nodes[left].right, right);
+            Update(left);
+            return left;
+        }
+        nodes[right].left = Merge(left, nodes[right].left);
+        Update(right);
+        return right;
+    }
+
+    void TextBuffer::Copy(uint32_t node, size_t offset, size_t count, std::wstring& out) const {
+        while (node != Null && count > 0) {
+            const Node& n = nodes[node];
+            const size_t leftSize = nodes[n.left].size;
+            if (offset < leftSize) {
+                const size_t take = std::min(count, leftSize - offset);
+                Copy(n.left, offset, take, out);
+                count -= take;
+                offset = leftSize;
+            }
+            if (count == 0) return;
+
+            offset -= leftSize;
+            if (offset < n.length) {
+                const size_t take = std::min(count, n.length - offset);
+                out.append(buffers[n.buffer].text, n.start + offset, take);
+                count -= take;
+                offset = n.length;
+            }
+            offset -= n.length;
+            node = n.right;
+        }
+    }
+}
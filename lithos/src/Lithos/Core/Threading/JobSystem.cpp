@@ -0,0 +1,305 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Threading/JobSystem.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace Lithos {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        /// Rounds of checking for work before a worker goes to sleep
+        constexpr int SpinRounds = 64;
+
+        // Which system and worker the current thread belongs to, if any
+        thread_local const JobSystem* currentSystem = nullptr;
+        thread_local size_t currentWorker = 0;
+
+        std::mutex sharedMutex;
+        std::unique_ptr<JobSystem> sharedSystem;
+        unsigned sharedWorkers = 0;
+        bool sharedConfigured = false;
+
+        uint64_t Nanoseconds(const Clock::duration d) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        }
+    }
+
+    struct alignas(64) JobSystem::Worker {
+        size_t index = 0;
+        std::mutex mutex;
+        std::deque<Job> jobs;       ///< Owner pushes and pops at the back, thieves take the front
+        std::thread thread;
+
+        std::atomic<uint64_t> jobsRun{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> sleeps{0};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> idleNs{0};
+    };
+
+    void TaskGroup::Run(std::function<void()> fn) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        jobs.Push({std::move(fn), &pending});
+    }
+
+    void TaskGroup::Wait() {
+        while (pending.load(std::memory_order_acquire) > 0) {
+            // Remaining jobs are running elsewhere when nothing is left to take
+            if (!jobs.RunPending()) std::this_thread::yield();
+        }
+    }
+
+    JobSystem::JobSystem(const unsigned workerCount) {
+        workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+            workers.back()->index = i;
+        }
+        for (auto& worker : workers) {
+            worker->thread = std::thread([this, w = worker.get()] { WorkerLoop(*w); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(sleepMutex);
+            stopping.store(true);
+        }
+        sleep.notify_all();
+
+        for (auto& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    unsigned JobSystem::DefaultWorkerCount() {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    JobSystem& JobSystem::Shared() {
+        std::lock_guard lock(sharedMutex);
+        if (!sharedSystem) {
+            // Even on one core: subsystems submit decodes and forget them, and nobody waits to help
+            const unsigned count = sharedConfigured ? sharedWorkers : DefaultWorkerCount();
+            sharedSystem = std::make_unique<JobSystem>(std::max(count, 1u));
+        }
+        return *sharedSystem;
+    }
+
+    bool JobSystem::ConfigureShared(const unsigned workerCount) {
+        std::lock_guard lock(sharedMutex);
+        if (sharedSystem) return false;
+        sharedWorkers = workerCount;
+        sharedConfigured = true;
+        return true;
+    }
+
+    void JobSystem::Submit(std::function<void()> fn) {
+        Push({std::move(fn), nullptr});
+    }
+
+    void JobSystem::Join(const std::function<void()>& a, std::function<void()> b) {
+        TaskGroup group(*this);
+        group.Run(std::move(b));
+        a();
+        group.Wait();
+    }
+
+    void JobSystem::ParallelForRanges(const size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        if (count == 0) return;
+
+        const size_t threads = workers.size() + 1;
+        if (grain == 0) {
+            grain = std::max<size_t>(1, count / (threads * 4));
+        }
+        if (workers.empty() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+
+        TaskGroup group(*this);
+        std::function<void(size_t, size_t)> split = [&](size_t begin, size_t end) {
+            // Hand off the upper half until the rest is one grain
+            while (end - begin > grain) {
+                const size_t mid = begin + (end - begin) / 2;
+                group.Run([&split, mid, end] { split(mid, end); });
+                end = mid;
+            }
+            fn(begin, end);
+        };
+        split(0, count);
+        group.Wait();
+    }
+
+    void JobSystem::ParallelFor(const size_t count, const std::function<void(size_t)>& fn, const size_t grain) {
+        ParallelForRanges(count, grain, [&fn](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i) fn(i);
+        });
+    }
+
+    bool JobSystem::RunPending() {
+        Worker* self = currentSystem == this ? workers[currentWorker].get() : nullptr;
+
+        Job job;
+        if (!Take(self, job)) return false;
+
+        Execute(job);
+        // A worker only gets here from inside a job, whose busy time already covers this one
+        if (self) {
+            self->jobsRun.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            helped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    JobSystemStats JobSystem::GetStats() const {
+        JobSystemStats stats;
+        stats.workers.reserve(workers.size());
+        for (const auto& worker : workers) {
+            JobWorkerStats w;
+            w.jobs = worker->jobsRun.load(std::memory_order_relaxed);
+            w.steals = worker->steals.load(std::memory_order_relaxed);
+            w.sleeps = worker->sleeps.load(std::memory_order_relaxed);
+            w.busy = std::chrono::nanoseconds(worker->busyNs.load(std::memory_order_relaxed));
+            w.idle = std::chrono::nanoseconds(worker->idleNs.load(std::memory_order_relaxed));
+            stats.workers.push_back(w);
+        }
+        stats.submitted = submitted.load(std::memory_order_relaxed);
+        stats.helped = helped.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void JobSystem::ResetStats() {
+        for (const auto& worker : workers) {
+            worker->jobsRun.store(0, std::memory_order_relaxed);
+            worker->steals.store(0, std::memory_order_relaxed);
+            worker->sleeps.store(0, std::memory_order_relaxed);
+            worker->busyNs.store(0, std::memory_order_relaxed);
+            worker->idleNs.store(0, std::memory_order_relaxed);
+        }
+        submitted.store(0, std::memory_order_relaxed);
+        helped.store(0, std::memory_order_relaxed);
+    }
+
+    void JobSystem::Push(Job job) {
+        submitted.fetch_add(1, std::memory_order_relaxed);
+
+        // Counted first so a sleeping worker can't miss it; see WorkerLoop()
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (currentSystem == this) {
+            Worker& self = *workers[currentWorker];
+            std::lock_guard lock(self.mutex);
+            self.jobs.push_back(std::move(job));
+        } else {
+            std::lock_guard lock(injectedMutex);
+            injected.push_back(std::move(job));
+        }
+
+        if (sleepers.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard lock(sleepMutex);
+            sleep.notify_one();
+        }
+    }
+
+    bool JobSystem::Take(Worker* self, Job& job) {
+        if (self) {
+            std::lock_guard lock(self->mutex);
+            if (!self->jobs.empty()) {
+                job = std::move(self->jobs.back());
+                self->jobs.pop_back();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard lock(injectedMutex);
+            if (!injected.empty()) {
+                job = std::move(injected.front());
+                injected.pop_front();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Steal the oldest job of the next worker that has one
+        const size_t n = workers.size();
+        const size_t first = self ? self->index + 1 : 0;
+        for (size_t k = 0; k < n; ++k) {
+            Worker& victim = *workers[(first + k) % n];
+            if (&victim == self) continue;
+
+            std::lock_guard lock(victim.mutex);
+            if (victim.jobs.empty()) continue;
+
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            if (self) self->steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::Execute(Job& job) {
+        job.fn();
+        if (job.pending) job.pending->fetch_sub(1, std::memory_order_release);
+    }
+
+    void JobSystem::WorkerLoop(Worker& self) {
+        currentSystem = this;
+        currentWorker = self.index;
+
+        Clock::time_point idleSince = Clock::now();
+        for (;;) {
+            Job job;
+            if (Take(&self, job)) {
+                const Clock::time_point start = Clock::now();
+                self.idleNs.fetch_add(Nanoseconds(start - idleSince), std::memory_order_relaxed);
+                Execute(job);
+                idleSince = Clock::now();
+                self.busyNs.fetch_add(Nanoseconds(idleSince - start), std::memory_order_relaxed);
+                self.jobsRun.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            bool found = false;
+            for (int i = 0; i < SpinRounds && !found; ++i) {
+                std::this_thread::yield();
+                found = queued.load(std::memory_order_relaxed) > 0;
+            }
+            if (found) continue;
+
+            std::unique_lock lock(sleepMutex);
+            if (stopping.load()) break;
+
+            // Registered before checking, and submitters count before checking for
+            // sleepers: one of the two always sees the other
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            self.sleeps.fetch_add(1, std::memory_order_relaxed);
+            sleep.wait(lock, [this] {
+                return stopping.load() || queued.load(std::memory_order_seq_cst) > 0;
+            });
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        currentSystem = nullptr;
+    }
+}
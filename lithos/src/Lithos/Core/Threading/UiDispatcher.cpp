@@ -0,0 +1,194 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Lithos/Core/Threading/UiDispatcher.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace Lithos {
+    UiDispatcher::UiDispatcher(const size_t capacity)
+        : cells(std::make_unique<Cell[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))),
+          mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          owner(std::this_thread::get_id()) {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    UiDispatcher::~UiDispatcher() = default;
+
+    bool UiDispatcher::TryPost(Task task) {
+        if (!task) return true;
+        if (TryPush(task)) {
+            Signal();
+            return true;
+        }
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool UiDispatcher::Post(Task task, const Clock::duration timeout) {
+        if (!task) return true;
+        if (TryPush(task)) {
+            Signal();
+            return true;
+        }
+
+        if (IsOwnerThread() || timeout <= Clock::duration::zero()) {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        waits.fetch_add(1, std::memory_order_relaxed);
+        const auto deadline = timeout == Clock::duration::max() ? Clock::time_point::max() : Clock::now() + timeout;
+
+        // Either the drain's read of `waiting` comes later and notifies, or it came first and
+        // this increment reads from it, which makes the slots it freed visible to the retry
+        waiting.fetch_add(1, std::memory_order_acq_rel);
+
+        bool pushed;
+        {
+            std::unique_lock lock(roomMutex);
+            while (!(pushed = TryPush(task))) {
+                // A full queue always has a wake outstanding, so a drain is coming
+                if (deadline == Clock::time_point::max()) {
+                    room.wait(lock);
+                } else if (room.wait_until(lock, deadline) == std::cv_status::timeout) {
+                    pushed = TryPush(task);
+                    break;
+                }
+            }
+        }
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+
+        if (!pushed) {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Signal();
+        return true;
+    }
+
+    bool UiDispatcher::TryPush(Task& task) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // The slot still holds the task from one lap ago
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Measured before publishing: afterwards the owner may already have run past pos
+        const size_t depth = pos + 1 - head.load(std::memory_order_relaxed);
+        size_t deepest = maxDepth.load(std::memory_order_relaxed);
+        while (depth > deepest && !maxDepth.compare_exchange_weak(deepest, depth, std::memory_order_relaxed)) {}
+
+        cell->task = std::move(task);
+        cell->posted = Clock::now();
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void UiDispatcher::Signal() {
+        if (!signaled.exchange(true, std::memory_order_acq_rel) && wake) {
+            wake();
+        }
+    }
+
+    size_t UiDispatcher::Drain(const Clock::time_point now) {
+        // Cleared first: a post that lands after the snapshot below signals again
+        signaled.store(false, std::memory_order_seq_cst);
+
+        const size_t end = tail.load(std::memory_order_acquire);
+        size_t pos = head.load(std::memory_order_relaxed);
+        const size_t first = pos;
+        std::chrono::nanoseconds longest{0};
+
+        while (pos != end) {
+            Cell& cell = cells[pos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break;  // Claimed but not yet written; its producer signals again
+            }
+
+            Task task = std::move(cell.task);
+            cell.task = nullptr;
+            longest = std::max(longest, std::chrono::duration_cast<std::chrono::nanoseconds>(now - cell.posted));
+
+            // Free the slot before running, so the task itself may post; head first, so
+            // a producer that sees the slot free also sees the depth it leaves
+            head.store(pos + 1, std::memory_order_relaxed);
+            cell.sequence.store(pos + mask + 1, std::memory_order_release);
+            ++pos;
+            task();
+        }
+
+        const size_t ran = pos - first;
+        if (ran > 0) {
+            drains++;
+            lastMaxDelay = longest;
+            maxDelay = std::max(maxDelay, longest);
+
+            // A read-modify-write, so it is ordered against the waiters' increments
+            if (waiting.fetch_add(0, std::memory_order_acq_rel) > 0) {
+                std::lock_guard lock(roomMutex);
+                room.notify_all();
+            }
+        }
+        return ran;
+    }
+
+    size_t UiDispatcher::GetDepth() const {
+        const size_t h = head.load(std::memory_order_acquire);
+        const size_t t = tail.load(std::memory_order_acquire);
+        return t - std::min(h, t);
+    }
+
+    UiDispatcherStats UiDispatcher::GetStats() const {
+        UiDispatcherStats stats;
+        stats.posted = tail.load(std::memory_order_acquire) - postedBase;
+        stats.executed = head.load(std::memory_order_acquire) - executedBase;
+        stats.rejected = rejected.load(std::memory_order_relaxed);
+        stats.waits = waits.load(std::memory_order_relaxed);
+        stats.drains = drains;
+        stats.depth = GetDepth();
+        stats.maxDepth = maxDepth.load(std::memory_order_relaxed);
+        stats.capacity = GetCapacity();
+        stats.lastMaxDelay = lastMaxDelay;
+        stats.maxDelay = maxDelay;
+        return stats;
+    }
+
+    void UiDispatcher::ResetStats() {
+        postedBase = tail.load(std::memory_order_acquire);
+        executedBase = head.load(std::memory_order_acquire);
+        rejected.store(0, std::memory_order_relaxed);
+        waits.store(0, std::memory_order_relaxed);
+        maxDepth.store(GetDepth(), std::memory_order_relaxed);
+        drains = 0;
+        lastMaxDelay = maxDelay = std::chrono::nanoseconds{0};
+    }
+
+    size_t UiDispatcher::GetMemoryBytes() const {
+        return GetCapacity() * sizeof(Cell);
+    }
+}
@@ -16,11 +16,42 @@
 
 #include "Lithos/Core/Window.hpp"
 
+#include "Lithos/Core/Animation/Transition.hpp"
+#include "Lithos/Core/Animation/UiTask.hpp"
 #include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/ElementPool.hpp"
 #include "Lithos/Core/Event.hpp"
+#include "Lithos/Core/EventDispatcher.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+#include "Lithos/Core/FrameScheduler.hpp"
+#include "Lithos/Core/HoverTracker.hpp"
+#include "Lithos/Core/Image/ImageLoader.hpp"
+#include "Lithos/Core/InputQueue.hpp"
+#include "Lithos/Core/LatencyTracker.hpp"
+#include "Lithos/Core/MemoryReport.hpp"
+#include "Lithos/Core/Render/OcclusionCuller.hpp"
+#include "Lithos/Core/Render/RenderThread.hpp"
+#include "Lithos/Core/Render/Scene.hpp"
+#include "Lithos/Core/Threading/UiDispatcher.hpp"
+
+#ifdef _WIN32
+    #include "Lithos/Core/Image/WicDecoder.hpp"
+    #include "Lithos/Core/Render/DeviceResources.hpp"
+
+    #include <windowsx.h>
+#else
+    #include "Lithos/Core/Render/Framebuffer.hpp"
+    #include "Lithos/Core/Render/SoftwareRenderer.hpp"
+
+    #include <thread>
+#endif
+
+#include <algorithm>
+#include <cmath>
 
 namespace Lithos {
     namespace {
+#ifdef _WIN32
         std::wstring ToWString(const std::string& utf8) {
             if (utf8.empty()) return L"";
 
@@ -45,39 +76,113 @@ namespace Lithos {
 
             return result;
         }
+#endif
+
+        /**
+         * Smallest whole-pixel rect covering r; clips and dirty rects must not cut antialiased edges
+         */
+        Rect PixelBounds(const Rect& r) {
+            if (r.IsEmpty()) return {};
+            return {std::floor(r.left), std::floor(r.top), std::ceil(r.right), std::ceil(r.bottom)};
+        }
     }
 
     struct Window::Impl {
-        HWND hwnd;
+        using Clock = std::chrono::steady_clock;
+
+#ifdef _WIN32
+        HWND hwnd = nullptr;
 
         // Direct2D 1.1
-        ID2D1Factory1* pD2DFactory;
-        ID2D1Device* pD2DDevice;
-        ID2D1DeviceContext* pDeviceContext;
+        ID2D1Factory1* pD2DFactory = nullptr;
+        ID2D1Device* pD2DDevice = nullptr;
+        ID2D1DeviceContext* pDeviceContext = nullptr;
 
         // Direct3D 11
-        ID3D11Device* pD3DDevice;
-        ID3D11DeviceContext* pD3DContext;
-        IDXGISwapChain1* pSwapChain;
-        ID2D1Bitmap1* pTargetBitmap;
-
-        int width, height;
-        std::unique_ptr<Element> rootElement;
+        ID3D11Device* pD3DDevice = nullptr;
+        ID3D11DeviceContext* pD3DContext = nullptr;
+        IDXGISwapChain1* pSwapChain = nullptr;
+        ID2D1Bitmap1* pTargetBitmap = nullptr;
+#endif
+
+        int width = 0, height = 0;
+        ElementPool* elementPool;   ///< Backs every element created through the tree; released last
+        std::shared_ptr<Element> rootElement;
+#ifdef _WIN32
+        DeviceResources deviceResources;
+#endif
+        DisplayList displayList;
+        FlatTree flatTree;
+        bool flatTraversal = true;
+        OcclusionCuller occlusionCuller;
+        HoverTracker hoverTracker;
+        EventDispatcher eventDispatcher;
+        InputQueue inputQueue;
+        LatencyTracker latency;
+        FrameScheduler scheduler;
+        ImageLoader imageLoader;    ///< After the scheduler: its wake handler requests frames
+        UiDispatcher dispatcher;    ///< Likewise
+        CoroutineScheduler coroutines{scheduler};
+        bool trackingMouseLeave = false;
+
+        // Damage since the last painted frame, in window pixels
+        Rect damage;
+        bool fullDamage = true;
+
+        // The flip chain alternates two buffers, so the back buffer still holds the frame
+        // before last: a partial frame also repaints what the previous one changed
+        Rect previousDamage;
+        bool previousFull = true;
+
+#ifdef _WIN32
+        /// What the Paint phase left for Present
+        enum class FrameOutput : uint8_t { None, Full, Partial };
+        FrameOutput output = FrameOutput::None;
+        RECT dirtyRect{};
+#else
+        // Headless: frames are rasterized into memory
+        Framebuffer framebuffer;
+        SoftwareRenderer softwareRenderer;
+        DisplayList sceneList;              ///< Used only on the render thread
+#endif
+
+        // Render thread mode: the UI side builds snapshots, the thread replays them
+        SceneBuilder sceneBuilder;
+#ifdef _WIN32
+        DeviceResources renderResources;    ///< Used only on the render thread
+#endif
+        std::unique_ptr<RenderThread> renderThread;
+
+        // Running totals over the elements attached to this window
+        size_t trackedElements = 0;
+        size_t trackedElementBytes = 0;
+
+        // Elements driven by Animate(); swapped each frame so callbacks can re-register
+        std::vector<std::weak_ptr<Element>> animating;
+        std::vector<std::weak_ptr<Element>> animatingNow;
+
+        // Registered TransitionManagers; slots are nulled, not erased, so managers can come and go mid-update
+        std::vector<TransitionManager*> transitions;
+        Window* owner = nullptr;
 
         Impl()
-            : hwnd(nullptr),
-              pD2DFactory(nullptr),
-              pD2DDevice(nullptr),
-              pDeviceContext(nullptr),
-              pD3DDevice(nullptr),
-              pD3DContext(nullptr),
-              pSwapChain(nullptr),
-              pTargetBitmap(nullptr),
-              width(0),
-              height(0),
-              rootElement(std::make_unique<Element>()) {}
+            : elementPool(ElementPool::Create()),
+              rootElement(Element::Make<Element>(elementPool)) {
+            SetupFramePhases();
+        }
 
         ~Impl() {
+            // Finish the frame in flight before anything it draws with goes away
+            renderThread.reset();
+
+            // Scripts may hold elements in their frames
+            coroutines.CancelAll();
+            rootElement.reset();
+            elementPool->Release();
+
+#ifdef _WIN32
+            deviceResources.ReleaseDeviceResources();
+            renderResources.ReleaseDeviceResources();
             SafeRelease(pTargetBitmap);
             SafeRelease(pSwapChain);
             SafeRelease(pDeviceContext);
@@ -85,8 +190,10 @@ namespace Lithos {
             SafeRelease(pD3DContext);
             SafeRelease(pD3DDevice);
             SafeRelease(pD2DFactory);
+#endif
         }
 
+#ifdef _WIN32
         template <typename T>
         void SafeRelease(T*& ptr) {
             if (ptr) {
@@ -191,20 +298,192 @@ namespace Lithos {
             SafeRelease(dxgiBackBuffer);
         }
 
-        void OnPaint() const {
+        void OnPaint() {
+            // Exposed by the system; runs right away if due, which also covers modal
+            // loops (moving, resizing) that bypass Run()
+            scheduler.RequestFrame(FrameWork::Damage);
+            scheduler.Tick(Clock::now());
+        }
+#endif
+
+        void SetupFramePhases() {
+            scheduler.SetPhase(FramePhase::Input, [this](const FrameInfo&) {
+                latency.BeginFrame(Clock::now());
+                dispatcher.Drain();
+                imageLoader.Poll();
+                DispatchInput();
+            });
+            scheduler.SetPhase(FramePhase::Animate, [this](const FrameInfo& info) {
+                coroutines.Resume(ResumePoint::FrameStart, info);
+                RunAnimations(info.time);
+                owner->RunTransitions(info.time);
+                coroutines.Resume(ResumePoint::AfterAnimate, info);
+                latency.MarkDispatched(Clock::now());
+            });
+            scheduler.SetPhase(FramePhase::Layout, [this](const FrameInfo& info) {
+                UpdateLayout();
+                if (renderThread && !flatTraversal) flatTree.Sync(*rootElement);   // Snapshots are built from the flat tree
+                latency.MarkLaidOut(Clock::now());
+                coroutines.Resume(ResumePoint::AfterLayout, info);
+            });
+            scheduler.SetPhase(FramePhase::Paint, [this](const FrameInfo& info) {
+                // Input and animation handlers may change anything without saying where;
+                // background results and scripts say it with RequestRepaint()
+                if (info.work & ~(FrameWork::Tasks | FrameWork::Region | FrameWork::Resume)) fullDamage = true;
+                Paint();
+                latency.MarkPainted(Clock::now());
+            });
+            scheduler.SetPhase(FramePhase::Present, [this](const FrameInfo&) {
+                // With vsync this returns once the frame is queued for scan-out: the closest
+                // point to photons the app can observe. With the render thread, presentation
+                // happens asynchronously and the UI thread's frame ends at the handoff.
+#ifdef _WIN32
+                if (pSwapChain && !renderThread) Present();
+#endif
+                latency.MarkPresented(Clock::now());
+            });
+        }
+
+        void Paint() {
+#ifdef _WIN32
             if (!pDeviceContext) return;
+#endif
+
+            const Rect viewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+
+            if (renderThread) {
+                renderThread->Publish(sceneBuilder.Build(flatTree, viewport));
+
+                // The render thread repaints whole frames; the buffers are unknown once it stops
+                damage = {};
+                fullDamage = false;
+                previousFull = true;
+                return;
+            }
+
+            const Rect current = fullDamage ? viewport : PixelBounds(damage).Intersect(viewport);
+            const bool full = fullDamage || previousFull;
+            if (!full && current.IsEmpty()) {
+                // Damage fell outside the window; leave the buffers as they are
+                damage = {};
+                return;
+            }
+            const Rect area = full ? viewport : current.Union(previousDamage);
+
+            displayList.Clear();
+            if (flatTraversal) {
+                flatTree.Record(displayList, area);
+            } else {
+                rootElement->Record(displayList, area);
+            }
 
-            //TODO
+#ifdef _WIN32
+            pDeviceContext->BeginDraw();
+            if (!full) {
+                pDeviceContext->PushAxisAlignedClip(D2D1::RectF(area.left, area.top, area.right, area.bottom),
+                                                    D2D1_ANTIALIAS_MODE_ALIASED);
+            }
+            pDeviceContext->Clear(D2D1::ColorF(1.0f, 1.0f, 1.0f, 1.0f));
+            deviceResources.Replay(pDeviceContext, displayList, occlusionCuller.Cull(displayList));
+
+            if (!full) pDeviceContext->PopAxisAlignedClip();
+            pDeviceContext->EndDraw();
+
+            output = full ? FrameOutput::Full : FrameOutput::Partial;
+            dirtyRect = {
+                static_cast<LONG>(current.left), static_cast<LONG>(current.top),
+                static_cast<LONG>(current.right), static_cast<LONG>(current.bottom)
+            };
+#else
+            softwareRenderer.Render(displayList, framebuffer, full ? std::span<const Rect>() : std::span(&area, 1),
+                                    Colors::White);
+#endif
+
+            previousDamage = current;
+            previousFull = fullDamage;
+            damage = {};
+            fullDamage = false;
+        }
+
+#ifdef _WIN32
+        void Present() {
+            if (output == FrameOutput::Full) {
+                pSwapChain->Present(1, 0);
+            } else if (output == FrameOutput::Partial) {
+                // Lets the compositor copy just the changed pixels
+                DXGI_PRESENT_PARAMETERS params = {1, &dirtyRect, nullptr, nullptr};
+                pSwapChain->Present1(1, 0, &params);
+            }
+            output = FrameOutput::None;
+        }
+
+        /**
+         * Render thread side of a frame: draws the snapshot's chunks and presents
+         */
+        void PresentScene(const SceneSnapshot& scene) {
+            pDeviceContext->BeginDraw();
+            pDeviceContext->Clear(D2D1::ColorF(1.0f, 1.0f, 1.0f, 1.0f));
+            for (const auto& chunk : scene.chunks) {
+                renderResources.Replay(pDeviceContext, chunk->list);
+            }
+            pDeviceContext->EndDraw();
+            pSwapChain->Present(1, 0);
+        }
+#else
+        /**
+         * Render thread side of a headless frame: rasterizes the whole snapshot
+         */
+        void PresentScene(const SceneSnapshot& scene) {
+            sceneList.Clear();
+            scene.Flatten(sceneList);
+            softwareRenderer.Render(sceneList, framebuffer, {}, Colors::White);
+        }
+#endif
+
+#ifdef _WIN32
+        /**
+         * Runs change with the render thread stopped: the swap chain, its target bitmap and
+         * the device context must not change under a frame in flight. Resizing and device
+         * re-creation go through here.
+         */
+        template <typename F>
+        void WithRenderThreadStopped(F&& change) {
+            const bool running = renderThread && renderThread->IsRunning();
+            if (running) renderThread->Stop();
+            change();
+            if (running) renderThread->Start();
         }
 
         void OnResize(const int newWidth, const int newHeight) {
-            //TODO
+            // Minimized, or nothing changed
+            if (newWidth <= 0 || newHeight <= 0) return;
+            if (newWidth == width && newHeight == height) return;
+
+            width = newWidth;
+            height = newHeight;
+
+            // WM_SIZE also arrives from CreateWindowEx, before the swap chain exists; it
+            // is then created at the new size
+            if (!pSwapChain) return;
+
+            WithRenderThreadStopped([this] {
+                // Every reference to the back buffers must go before they can be resized
+                pDeviceContext->SetTarget(nullptr);
+                SafeRelease(pTargetBitmap);
+                pSwapChain->ResizeBuffers(0, static_cast<UINT>(width), static_cast<UINT>(height),
+                                          DXGI_FORMAT_UNKNOWN, 0);
+                CreateBitmapFromSwapChain();
+            });
+
+            // New buffers hold nothing worth keeping; repaint all of them
+            scheduler.RequestFrame(FrameWork::Damage);
         }
 
         void OnMouseEvent(UINT msg, WPARAM wParam, LPARAM lParam) {
             MouseEvent evt;
-            evt.x = LOWORD(lParam);
-            evt.y = HIWORD(lParam);
+            evt.timestamp = std::chrono::steady_clock::now();   // Input latency is measured from here
+            evt.x = GET_X_LPARAM(lParam);
+            evt.y = GET_Y_LPARAM(lParam);
 
             switch (msg) {
                 case WM_LBUTTONDOWN:
@@ -233,24 +512,110 @@ namespace Lithos {
                     break;
                 case WM_MOUSEMOVE:
                     evt.type = MouseEventType::MouseMove;
+                    if (!trackingMouseLeave) {
+                        TRACKMOUSEEVENT tme = {sizeof(TRACKMOUSEEVENT), TME_LEAVE, hwnd, 0};
+                        trackingMouseLeave = TrackMouseEvent(&tme) != FALSE;
+                    }
+                    break;
+                case WM_MOUSEWHEEL: {
+                    // Wheel coordinates arrive in screen space
+                    POINT pt = {evt.x, evt.y};
+                    ScreenToClient(hwnd, &pt);
+                    evt.type = MouseEventType::MouseWheel;
+                    evt.x = pt.x;
+                    evt.y = pt.y;
+                    evt.wheelDelta = GET_WHEEL_DELTA_WPARAM(wParam);
                     break;
+                }
                 default:
                     return;
             }
 
-            bool handled = rootElement->OnMouseEvent(evt);
+            // Delivered on the next frame, together with anything else that arrives before it
+            inputQueue.Push(evt);
+            scheduler.RequestFrame(FrameWork::Input);
+        }
+
+        void OnMouseLeave() {
+            trackingMouseLeave = false;
+
+            MouseEvent evt;
+            evt.timestamp = std::chrono::steady_clock::now();
+            evt.type = MouseEventType::MouseLeave;
+            evt.x = evt.y = -1;
+            inputQueue.Push(evt);
+            scheduler.RequestFrame(FrameWork::Input);
+        }
+#endif
+
+        void DispatchInput() {
+            if (inputQueue.Empty()) return;
+
+            // Hit test against fresh bounds
+            UpdateLayout();
+
+            inputQueue.Dispatch([this](const MouseEvent& evt, const std::span<const MouseEvent> history) {
+                for (const MouseEvent& raw : history) {
+                    latency.InputConsumed(raw.timestamp);
+                }
+
+                if (evt.type == MouseEventType::MouseLeave) {
+                    hoverTracker.Clear(static_cast<float>(evt.x), static_cast<float>(evt.y));
+                    return;
+                }
+
+                Element* target = hoverTracker.Update(*rootElement, static_cast<float>(evt.x), static_cast<float>(evt.y),
+                                                      flatTraversal ? &flatTree : nullptr);
+
+                bool handled = false;
+                if (target) {
+                    MouseEvent routed = evt;
+                    handled = eventDispatcher.Dispatch(*target, routed);
+                }
+
+                if (!handled && evt.type == MouseEventType::MouseDown) {
+                    //TODO
+                    // if (focusedNode) {
+                    //     focusedNode->OnLostFocus();
+                    //     focusedNode = nullptr;
+                    // }
+                }
+
+                // Handlers may have changed layout for the next event's hit test
+                UpdateLayout();
+            });
+        }
+
+        void UpdateLayout() {
+            rootElement->UpdateLayout();
+            if (flatTraversal) {
+                flatTree.Sync(*rootElement);
+            }
+        }
+
+        void RunAnimations(const std::chrono::steady_clock::time_point now) {
+            if (animating.empty()) return;
 
-            if (!handled && evt.type == MouseEventType::MouseDown) {
-                //TODO
-                // if (focusedNode) {
-                //     focusedNode->OnLostFocus();
-                //     focusedNode = nullptr;
-                // }
+            animatingNow.swap(animating);
+            for (const auto& handle : animatingNow) {
+                const auto element = handle.lock();
+                if (!element) continue;
+
+                element->animationPending = false;
+                if (element->Animate(now) && !element->animationPending) {
+                    element->animationPending = true;
+                    animating.push_back(handle);
+                }
             }
+            animatingNow.clear();
 
-            InvalidateRect(hwnd, nullptr, FALSE);
+            // Keep frames coming while anything is still moving
+            if (!animating.empty()) {
+                scheduler.RequestFrame(FrameWork::Animation);
+            }
         }
 
+#ifdef _WIN32
         static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             Impl* pImpl = nullptr;
 
@@ -265,8 +630,8 @@ namespace Lithos {
 
             switch (msg) {
                 case WM_PAINT: {
-                    pImpl->OnPaint();
                     ValidateRect(hwnd, nullptr);
+                    pImpl->OnPaint();
                     return 0;
                 }
 
@@ -282,22 +647,33 @@ namespace Lithos {
                 case WM_MBUTTONDOWN:
                 case WM_MBUTTONUP:
                 case WM_MOUSEMOVE:
+                case WM_MOUSEWHEEL:
                     pImpl->OnMouseEvent(msg, wParam, lParam);
                     return 0;
 
+                case WM_MOUSELEAVE:
+                    pImpl->OnMouseLeave();
+                    return 0;
+
                 default:
                     return DefWindowProc(hwnd, msg, wParam, lParam);
             }
         }
+#endif
     };
 
-    Window::Window(const int width, const int height, const std::string& title)
+    Window::Window(const int width, const int height, [[maybe_unused]] const std::string& title)
         : pimpl(std::make_unique<Impl>()) {
+        pimpl->owner = this;
         pimpl->width = width;
         pimpl->height = height;
+        pimpl->rootElement->SetWindow(this);
 
+#ifdef _WIN32
+        // The render thread draws through the device context while the UI thread keeps
+        // creating geometries and measuring text on the same factory; D2D serializes them
         D2D1CreateFactory(
-            D2D1_FACTORY_TYPE_SINGLE_THREADED,
+            D2D1_FACTORY_TYPE_MULTI_THREADED,
             __uuidof(ID2D1Factory1),
             reinterpret_cast<void**>(&pimpl->pD2DFactory)
         );
@@ -329,24 +705,289 @@ namespace Lithos {
         );
 
         pimpl->CreateDeviceResources();
+
+        // Requests from other threads (or while Run() is blocked) need the loop awake
+        pimpl->scheduler.SetWakeHandler([hwnd = pimpl->hwnd] {
+            PostMessage(hwnd, WM_NULL, 0, 0);
+        });
+
+        pimpl->imageLoader.AddDecoder(std::make_shared<WicDecoder>());
+#else
+        // Headless: no platform surface or message loop; frames land in the framebuffer
+        pimpl->framebuffer.Resize(width, height);
+#endif
+
+        // Decodes finish on worker threads; the next frame's Input phase hands them out
+        pimpl->imageLoader.SetWakeHandler([impl = pimpl.get()] {
+            impl->scheduler.RequestFrame(FrameWork::Tasks);
+        });
+        pimpl->dispatcher.SetWakeHandler([impl = pimpl.get()] {
+            impl->scheduler.RequestFrame(FrameWork::Tasks);
+        });
     }
 
-    Window::~Window() = default;
+    Window::~Window() {
+        // Managers outliving the window must not unregister from it
+        for (TransitionManager* manager : pimpl->transitions) {
+            if (manager) manager->window = nullptr;
+        }
+        pimpl->transitions.clear();
+    }
 
     Element& Window::GetRoot() {
         return *pimpl->rootElement;
     }
 
+    const InputQueueStats& Window::GetInputStats() const {
+        return pimpl->inputQueue.GetStats();
+    }
+
+    const HoverStats& Window::GetHoverStats() const {
+        return pimpl->hoverTracker.GetStats();
+    }
+
+    const OcclusionStats& Window::GetOcclusionStats() const {
+#ifndef _WIN32
+        // Headless frames are culled by the software renderer; with the render thread on it
+        // renders there, so it isn't read from here
+        if (!pimpl->renderThread) return pimpl->softwareRenderer.GetOcclusionStats();
+#endif
+        return pimpl->occlusionCuller.GetStats();
+    }
+
+#ifdef _WIN32
+    DeviceResources& Window::GetDeviceResources() {
+        return pimpl->deviceResources;
+    }
+#else
+    const Framebuffer& Window::GetFramebuffer() const {
+        return pimpl->framebuffer;
+    }
+#endif
+
+    void Window::RequestRepaint() const {
+        // Counts for the frame in progress if its Paint phase is still ahead
+        pimpl->fullDamage = true;
+        pimpl->scheduler.RequestFrame(FrameWork::Damage);
+    }
+
+    void Window::RequestRepaint(const Rect& area) const {
+        if (area.IsEmpty()) return;
+        pimpl->damage = pimpl->damage.Union(area);
+        pimpl->scheduler.RequestFrame(FrameWork::Region);
+    }
+
+    ImageLoader& Window::GetImageLoader() {
+        return pimpl->imageLoader;
+    }
+
+    UiDispatcher& Window::GetDispatcher() {
+        return pimpl->dispatcher;
+    }
+
+    CoroutineScheduler& Window::GetCoroutines() {
+        return pimpl->coroutines;
+    }
+
+    void Window::SetFlatTraversal(const bool enabled) {
+        pimpl->flatTraversal = enabled;
+        if (!enabled) {
+            pimpl->flatTree.Clear();
+        }
+        RequestRepaint();
+    }
+
+    void Window::SetRenderThread(const bool enabled) {
+        if (enabled == (pimpl->renderThread != nullptr)) return;
+
+        if (enabled) {
+            Impl* impl = pimpl.get();
+            pimpl->renderThread = std::make_unique<RenderThread>([impl](const SceneSnapshot& scene, const RenderFrameInfo&) {
+                impl->PresentScene(scene);
+            });
+            pimpl->renderThread->Start();
+        } else {
+            pimpl->renderThread.reset();
+            pimpl->sceneBuilder.Clear();
+        }
+        RequestRepaint();
+    }
+
+    RenderThreadStats Window::GetRenderThreadStats() const {
+        return pimpl->renderThread ? pimpl->renderThread->GetStats() : RenderThreadStats{};
+    }
+
+    ElementPool& Window::GetElementPool() {
+        return *pimpl->elementPool;
+    }
+
+    const LatencyTracker& Window::GetLatency() const {
+        return pimpl->latency;
+    }
+
+    MemoryReport Window::GetMemoryReport() const {
+        MemoryReport report;
+        pimpl->rootElement->AccountSubtreeMemory(report);
+
+        report.Add(MemoryCategory::Animation, CapacityBytes(pimpl->animating) + CapacityBytes(pimpl->animatingNow)
+                   + CapacityBytes(pimpl->transitions)
+                   + pimpl->coroutines.GetMemoryBytes() + CoroutineFramePool::Local().GetMemoryBytes());
+        report.Add(MemoryCategory::Images, pimpl->imageLoader.GetMemoryBytes());
+        report.Add(MemoryCategory::FrameData,
+                   pimpl->displayList.GetMemoryBytes() + pimpl->flatTree.GetMemoryBytes()
+                   + pimpl->sceneBuilder.GetMemoryBytes()
+                   + pimpl->occlusionCuller.GetMemoryBytes() + pimpl->inputQueue.GetMemoryBytes()
+                   + pimpl->latency.GetMemoryBytes() + pimpl->dispatcher.GetMemoryBytes());
+#ifdef _WIN32
+        report.Add(MemoryCategory::RenderCaches, pimpl->deviceResources.GetMemoryBytes());
+        if (!pimpl->renderThread) {
+            // Owned by the render thread while it runs
+            report.Add(MemoryCategory::RenderCaches, pimpl->renderResources.GetMemoryBytes());
+        }
+#else
+        report.Add(MemoryCategory::FrameData, CapacityBytes(pimpl->framebuffer.pixels));
+#endif
+
+        const ElementPoolStats& pool = pimpl->elementPool->GetStats();
+        report.Add(MemoryCategory::PoolSlack, pool.bytesReserved - pool.bytesInUse);
+        return report;
+    }
+
+    MemoryTotals Window::GetMemoryTotals() const {
+        MemoryTotals totals;
+        totals.elements = pimpl->trackedElements;
+        totals.elementBytes = pimpl->trackedElementBytes;
+
+        const ElementPoolStats& pool = pimpl->elementPool->GetStats();
+        totals.poolReserved = pool.bytesReserved;
+        totals.poolInUse = pool.bytesInUse;
+
+        totals.images = pimpl->imageLoader.GetMemoryBytes();
+        totals.frameData = pimpl->displayList.GetMemoryBytes() + pimpl->flatTree.GetMemoryBytes()
+                         + pimpl->sceneBuilder.GetMemoryBytes()
+                         + pimpl->occlusionCuller.GetMemoryBytes() + pimpl->inputQueue.GetMemoryBytes()
+                         + pimpl->latency.GetMemoryBytes() + pimpl->dispatcher.GetMemoryBytes();
+#ifdef _WIN32
+        totals.renderCaches = pimpl->deviceResources.GetMemoryBytes();
+        if (!pimpl->renderThread) totals.renderCaches += pimpl->renderResources.GetMemoryBytes();
+#else
+        totals.frameData += CapacityBytes(pimpl->framebuffer.pixels);
+#endif
+        return totals;
+    }
+
+    void Window::TrackElement(const Element& element) {
+        pimpl->trackedElements++;
+        pimpl->trackedElementBytes += element.ObjectSize();
+    }
+
+    void Window::UntrackElement(const Element& element) {
+        pimpl->trackedElements--;
+        pimpl->trackedElementBytes -= element.ObjectSize();
+    }
+
+    void Window::RegisterTransitions(TransitionManager& manager) {
+        if (manager.window == this) return;
+        manager.window = this;
+        pimpl->transitions.push_back(&manager);
+        pimpl->scheduler.RequestFrame(FrameWork::Animation);
+    }
+
+    void Window::UnregisterTransitions(TransitionManager& manager) {
+        if (manager.window != this) return;
+        manager.window = nullptr;
+        std::ranges::replace(pimpl->transitions, &manager, nullptr);
+    }
+
+    void Window::RunTransitions(const std::chrono::steady_clock::time_point now) {
+        std::vector<TransitionManager*>& transitions = pimpl->transitions;
+        if (transitions.empty()) return;
+
+        // Finish callbacks may start, move or destroy managers; that only appends or nulls slots
+        for (size_t i = 0; i < transitions.size(); ++i) {
+            TransitionManager* manager = transitions[i];
+            if (manager && !manager->UpdateTarget(now) && transitions[i] == manager) {
+                manager->window = nullptr;
+                transitions[i] = nullptr;
+            }
+        }
+        std::erase(transitions, nullptr);
+
+        // Keep frames coming while anything is still transitioning
+        if (!transitions.empty()) {
+            pimpl->scheduler.RequestFrame(FrameWork::Animation);
+        }
+    }
+
+    void Window::PostMouseEvent(MouseEvent evt) {
+        // Timestamped on arrival like platform input, unless the caller supplied a time
+        if (evt.timestamp == std::chrono::steady_clock::time_point{}) {
+            evt.timestamp = std::chrono::steady_clock::now();
+        }
+        pimpl->inputQueue.Push(evt);
+        pimpl->scheduler.RequestFrame(FrameWork::Input);
+    }
+
+    void Window::RequestAnimationFrame(Element& element) {
+        pimpl->animating.push_back(element.weak_from_this());
+        RequestRepaint();
+    }
+
+#ifdef _WIN32
     void Window::Show() const {
         ShowWindow(pimpl->hwnd, SW_SHOW);
         UpdateWindow(pimpl->hwnd);
     }
 
     void Window::Run() {
+        using Clock = std::chrono::steady_clock;
+        FrameScheduler& scheduler = pimpl->scheduler;
+
         MSG msg = {};
-        while (GetMessage(&msg, nullptr, 0, 0)) {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+        for (;;) {
+            while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+                if (msg.message == WM_QUIT) return;
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+
+            const auto now = Clock::now();
+            if (scheduler.Tick(now)) continue;
+
+            const auto due = scheduler.NextFrameTime();
+            if (due == Clock::time_point::max()) {
+                // Nothing to do until a message arrives: no timer, no polling
+                WaitMessage();
+            } else {
+                const auto wait = std::chrono::ceil<std::chrono::milliseconds>(due - now);
+                MsgWaitForMultipleObjectsEx(0, nullptr, static_cast<DWORD>(wait.count()), QS_ALLINPUT,
+                                            MWMO_INPUTAVAILABLE);
+            }
+        }
+    }
+#else
+    void Window::Show() const {}
+
+    void Window::Run() {
+        // Headless: nothing can arrive from a message loop, so stop once no frame is scheduled
+        for (;;) {
+            const auto due = pimpl->scheduler.NextFrameTime();
+            if (due == std::chrono::steady_clock::time_point::max()) return;
+            std::this_thread::sleep_until(due);
+            pimpl->scheduler.Tick(std::chrono::steady_clock::now());
         }
     }
+#endif
+
+    bool Window::Tick(const std::chrono::steady_clock::time_point now) {
+        return pimpl->scheduler.Tick(now);
+    }
+
+    FrameSchedulerStats Window::GetFrameStats() const {
+        return pimpl->scheduler.GetStats();
+    }
+
+    void Window::SetFrameInterval(const std::chrono::steady_clock::duration interval) {
+        pimpl->scheduler.SetInterval(interval);
+    }
 }
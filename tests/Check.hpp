@@ -0,0 +1,42 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal assertions for the test executables; a failed check reports and exits non-zero
+// so ctest marks the test failed without pulling in a framework.
+
+#define LITHOS_CHECK(cond)                                                                \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                                 \
+        }                                                                                 \
+    } while (false)
+
+#define LITHOS_CHECK_EQ(a, b)                                                                   \
+    do {                                                                                        \
+        const auto lithosA = (a);                                                               \
+        const auto lithosB = (b);                                                               \
+        if (!(lithosA == lithosB)) {                                                            \
+            std::fprintf(stderr, "%s:%d: check failed: %s == %s (%lld vs %lld)\n", __FILE__,    \
+                         __LINE__, #a, #b, static_cast<long long>(lithosA),                     \
+                         static_cast<long long>(lithosB));                                      \
+            std::exit(1);                                                                       \
+        }                                                                                       \
+    } while (false)
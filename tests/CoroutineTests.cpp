@@ -0,0 +1,260 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Animation/Transition.hpp"
+#include "Lithos/Core/Animation/UiTask.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/FrameScheduler.hpp"
+#include "Lithos/Core/Window.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Box : ElementBase<Box> {};
+
+    std::vector<std::string> journal;
+    uint64_t currentFrame = 0;
+
+    void Log(const std::string& entry) {
+        journal.push_back("f" + std::to_string(currentFrame) + " " + entry);
+    }
+
+    struct Guard {
+        std::string name;
+        ~Guard() { Log(name + " destroyed"); }
+    };
+
+    UiTask Child(std::string name) {
+        Log(name + " child start");
+        co_await NextFrame();
+        Log(name + " child frame");
+        co_await AfterLayout();
+        Log(name + " child layout");
+    }
+
+    UiTask Parent() {
+        Log("A start");
+        co_await NextFrame();
+        Log("A frame");
+        co_await Child("A");
+        Log("A done");
+    }
+
+    UiTask Layouts() {
+        Log("B start");
+        co_await AfterLayout();
+        Log("B layout");
+        co_await AfterLayout();
+        Log("B layout2");
+        co_await NextFrame();
+        Log("B frame");
+    }
+
+    UiTask Sleeper(std::string name, const int ms) {
+        co_await Delay(std::chrono::milliseconds(ms));
+        Log(name + " delay");
+    }
+
+    UiTask Immediate() {
+        Log("sync");
+        co_return;
+    }
+
+    UiTask Forever() {
+        Guard guard{"X"};
+        co_await Delay(10s);
+        Log("X resumed");
+    }
+
+    UiTask AwaitTransition(TransitionManager& manager) {
+        Log("T wait");
+        co_await TransitionFinished(manager, AnimatableProperty::Opacity);
+        Log("T finished");
+        co_await TransitionFinished(manager, AnimatableProperty::Opacity);
+        Log("T idle");
+    }
+
+    // Frames the way the window runs them, on a synthetic clock
+    struct Harness {
+        FrameScheduler frames;
+        CoroutineScheduler coroutines{frames};
+        Clock::time_point now = Clock::time_point{} + 1s;
+        uint64_t framesRun = 0;
+
+        Harness() {
+            coroutines.SetClock([this] { return now; });
+            frames.SetPhase(FramePhase::Animate, [this](const FrameInfo& info) {
+                currentFrame = info.frame;
+                framesRun++;
+                coroutines.Resume(ResumePoint::FrameStart, info);
+                coroutines.Resume(ResumePoint::AfterAnimate, info);
+            });
+            frames.SetPhase(FramePhase::Layout, [this](const FrameInfo& info) {
+                coroutines.Resume(ResumePoint::AfterLayout, info);
+            });
+        }
+
+        /// Jumps the clock from frame to frame until nothing is due before `until`
+        void Run(const Clock::time_point until) {
+            for (;;) {
+                const Clock::time_point due = frames.NextFrameTime();
+                if (due == Clock::time_point::max() || due > until) break;
+                if (due > now) now = due;
+                frames.Tick(now);
+            }
+            if (now < until) now = until;
+        }
+    };
+
+    void ResumeOrder() {
+        journal.clear();
+        currentFrame = 0;
+        Harness h;
+        h.coroutines.Spawn(Sleeper("C30", 30));
+        h.coroutines.Spawn(Sleeper("C10", 10));
+        h.coroutines.Spawn(Sleeper("C10b", 10));
+        h.coroutines.Spawn(Parent());
+        h.coroutines.Spawn(Layouts());
+        h.coroutines.Spawn(Immediate());
+        h.Run(h.now + 100ms);
+
+        // Spawn runs to the first wait. Within a frame FrameStart wakes due delays (in
+        // booking order), then NextFrame waiters; AfterLayout wakes its waiters in the
+        // order they started waiting. A wait made while resuming goes to the next
+        // occurrence of its point. Frames are 16.7 ms apart.
+        const std::vector<std::string> expected = {
+            "f0 A start",
+            "f0 B start",
+            "f0 sync",
+            "f1 A frame",
+            "f1 A child start",
+            "f1 B layout",
+            "f2 C10 delay",
+            "f2 C10b delay",
+            "f2 A child frame",
+            "f2 B layout2",
+            "f2 A child layout",
+            "f2 A done",
+            "f3 C30 delay",
+            "f3 B frame",
+        };
+        if (journal != expected) {
+            for (const std::string& entry : journal) std::fprintf(stderr, "%s\n", entry.c_str());
+        }
+        LITHOS_CHECK(journal == expected);
+        LITHOS_CHECK_EQ(h.coroutines.GetRunningCount(), 0u);
+        LITHOS_CHECK(h.frames.IsIdle());
+    }
+
+    void DelaysBookSingleFrame() {
+        journal.clear();
+        Harness h;
+        h.coroutines.Spawn(Sleeper("long", 10000));
+        LITHOS_CHECK(h.frames.IsIdle());
+        LITHOS_CHECK(h.frames.NextFrameTime() == h.now + 10s);
+        h.Run(h.now + 20s);
+        LITHOS_CHECK_EQ(h.framesRun, 1u);
+        LITHOS_CHECK_EQ(journal.size(), 1u);
+        LITHOS_CHECK(h.frames.NextFrameTime() == Clock::time_point::max());
+    }
+
+    void CancelDestroysFrame() {
+        journal.clear();
+        Harness h;
+        const uint64_t id = h.coroutines.Spawn(Forever());
+        LITHOS_CHECK(h.coroutines.IsRunning(id));
+        LITHOS_CHECK(h.coroutines.Cancel(id));
+        LITHOS_CHECK(!h.coroutines.IsRunning(id));
+        LITHOS_CHECK_EQ(journal.size(), 1u);
+        LITHOS_CHECK(journal[0].ends_with("X destroyed"));
+        h.Run(h.now + 20s);
+        LITHOS_CHECK_EQ(journal.size(), 1u);
+        LITHOS_CHECK_EQ(h.coroutines.GetStats().cancelled, 1u);
+    }
+
+    // Through a real window: its Animate phase updates the manager and wakes the script
+    void TransitionFinishedThroughWindow() {
+        journal.clear();
+        currentFrame = 0;
+        Window window(100, 100, "coroutines");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(10).height(10);
+
+        auto now = Clock::now();
+        window.Tick(now);
+
+        TransitionManager manager;
+        manager.AddTransition(TransitionConfig(AnimatableProperty::Opacity).SetDuration(0.05f));
+        manager.OnPropertyChange(&box, AnimatableProperty::Opacity, 0.5f);
+        window.GetCoroutines().Spawn(AwaitTransition(manager));
+
+        int frames = 0;
+        while (window.Tick(now += 20ms)) {
+            LITHOS_CHECK(++frames < 50);
+        }
+        LITHOS_CHECK_EQ(journal.size(), 3u);
+        LITHOS_CHECK(journal[1].ends_with("T finished"));
+        LITHOS_CHECK(journal[2].ends_with("T idle"));
+        LITHOS_CHECK(frames >= 3);
+        LITHOS_CHECK_EQ(window.GetCoroutines().GetRunningCount(), 0u);
+
+        // The scheduler may go away while a transition wait is pending
+        auto frameScheduler = std::make_unique<FrameScheduler>();
+        auto coroutines = std::make_unique<CoroutineScheduler>(*frameScheduler);
+        manager.OnPropertyChange(&box, AnimatableProperty::Opacity, 1.0f);
+        coroutines->Spawn(AwaitTransition(manager));
+        coroutines.reset();
+        frameScheduler.reset();
+        while (window.Tick(now += 20ms)) {}
+    }
+
+    void FramesAreReused() {
+        Harness h;
+        CoroutineFramePool& pool = CoroutineFramePool::Local();
+        pool.ResetStats();
+        for (int round = 0; round < 200; ++round) {
+            for (int i = 0; i < 20; ++i) h.coroutines.Spawn(Parent());
+            h.Run(h.now + 100ms);
+        }
+        journal.clear();
+
+        const CoroutineFramePoolStats stats = pool.GetStats();
+        LITHOS_CHECK_EQ(stats.live, 0u);
+        LITHOS_CHECK_EQ(stats.allocations, 200u * 20u * 2u);
+        LITHOS_CHECK(stats.reuses + 40 >= stats.allocations);
+        pool.Trim();
+        LITHOS_CHECK_EQ(pool.GetStats().bytesReserved, 0u);
+        LITHOS_CHECK_EQ(h.coroutines.GetStats().completed, 4000u);
+    }
+}
+
+int main() {
+    ResumeOrder();
+    DelaysBookSingleFrame();
+    CancelDestroysFrame();
+    TransitionFinishedThroughWindow();
+    FramesAreReused();
+    return 0;
+}
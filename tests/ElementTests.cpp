@@ -0,0 +1,304 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/SpatialIndex.hpp"
+#include "Lithos/Core/Components/ScrollView.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    struct Box : ElementBase<Box> {};
+
+    // Counts the elements actually laid out (not just translated)
+    struct Counted : ElementBase<Counted> {
+        static inline size_t resolved = 0;
+
+    protected:
+        void ResolveSize() override { resolved++; }
+    };
+
+    // Rows carry their index in the green channel so recorded commands can be traced back
+    Color RowColor(const size_t i) { return {0.0f, static_cast<float>(i) / 8192.0f, 0.0f, 1.0f}; }
+
+    /**
+     * Checks the rows recorded in list: every row in [first, last] and at most one
+     * antialiasing neighbour on either side
+     */
+    void CheckRecordedRows(const DisplayList& list, const size_t first, const size_t last, const size_t rows) {
+        std::vector<size_t> seen;
+        for (const DrawCommand& cmd : list.Commands()) {
+            if (cmd.color.g == 0.0f) continue;      // Not a row
+            seen.push_back(static_cast<size_t>(std::lround(cmd.color.g * 8192.0f)));
+        }
+        std::ranges::sort(seen);
+        LITHOS_CHECK(std::ranges::adjacent_find(seen) == seen.end());
+        LITHOS_CHECK(!seen.empty() && seen.front() + 1 >= first && seen.back() <= last + 1 && seen.back() < rows);
+        for (size_t i = first; i <= last; ++i) LITHOS_CHECK(std::ranges::binary_search(seen, i));
+        LITHOS_CHECK(seen.size() <= last - first + 3);
+    }
+
+    // A removed child is freed at once, not when the parent next lays out
+    void RemovalReleasesChild() {
+        auto root = std::make_shared<Box>();
+        std::vector<std::weak_ptr<Element>> handles;
+        for (int i = 0; i < 8; ++i) handles.push_back(root->AddChild<Box>().shared_from_this());
+        root->UpdateLayout();
+
+        root->RemoveChild(*handles[2].lock());      // From the middle, leaving the array stale
+        LITHOS_CHECK(handles[2].expired());
+        root->RemoveChild(*handles[7].lock());      // The tail
+        LITHOS_CHECK(handles[7].expired());
+        LITHOS_CHECK(root->NeedsLayout());
+
+        // Moving a child to another parent drops the old parent's reference too
+        auto other = std::make_shared<Box>();
+        handles[0].lock()->Reparent(*other);
+        other.reset();
+        LITHOS_CHECK(handles[0].expired());
+        LITHOS_CHECK_EQ(root->GetChildCount(), 5u);
+    }
+
+    // Random inserts, removals and moves against a model; layout stacks the children
+    // in sibling order, and hit tests read the re-sorted array
+    void EditsKeepSiblingOrder() {
+        auto root = std::make_shared<Box>();
+        root->width(100).height(100000);
+        std::vector<Element*> model;
+        std::mt19937 rng(41);
+
+        for (int step = 0; step < 2000; ++step) {
+            const size_t n = model.size();
+            const unsigned op = rng() % 4;
+            if (op == 0 || n < 4) {
+                Element* before = n && rng() % 2 ? model[rng() % n] : nullptr;
+                auto child = Element::Make<Box>(nullptr);
+                child->width(100).height(10);
+                Element& added = root->InsertChild(child, before);
+                model.insert(before ? std::ranges::find(model, before) : model.end(), &added);
+            } else if (op == 1) {
+                const size_t k = rng() % n;
+                LITHOS_CHECK(root->RemoveChild(*model[k]).use_count() == 1);
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(k));
+            } else if (op == 2) {
+                Element* child = model[rng() % n];
+                Element* before = model[rng() % n];
+                if (before == child) continue;
+                root->MoveChild(*child, before);
+                model.erase(std::ranges::find(model, child));
+                model.insert(std::ranges::find(model, before), child);
+            } else {
+                // Remove and re-add the same element: one entry, at the end
+                const size_t k = rng() % n;
+                auto handle = root->RemoveChild(*model[k]);
+                root->AddChild(handle);
+                Element* moved = model[k];
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(k));
+                model.push_back(moved);
+            }
+
+            if (step % 7 != 0) continue;
+            root->UpdateLayout();
+            LITHOS_CHECK_EQ(root->GetChildCount(), model.size());
+            for (size_t i = 0; i < model.size(); ++i) {
+                LITHOS_CHECK_EQ(model[i]->getY(), static_cast<float>(i) * 10.0f);
+                LITHOS_CHECK(root->FindElementAt(50.0f, static_cast<float>(i) * 10.0f + 5.0f) == model[i]);
+            }
+        }
+    }
+
+    // Moving an element under itself or a descendant is refused instead of closing an ownership cycle
+    void NoParentCycles() {
+        std::weak_ptr<Element> handle;
+        {
+            auto a = std::make_shared<Box>();
+            auto& b = a->AddChild<Box>();
+            auto& c = b.AddChild<Box>();
+            handle = a;
+
+            a->Reparent(c);
+            a->Reparent(*a);
+            b.InsertChild(a, nullptr);
+            c.AddChild(b.shared_from_this());
+            LITHOS_CHECK(a->GetParent() == nullptr);
+            LITHOS_CHECK(b.GetParent() == a.get());
+            LITHOS_CHECK(c.GetParent() == &b);
+            LITHOS_CHECK_EQ(a->GetChildCount(), 1u);
+            LITHOS_CHECK_EQ(b.GetChildCount(), 1u);
+            LITHOS_CHECK_EQ(c.GetChildCount(), 0u);
+
+            // Sideways and upward moves still work
+            c.Reparent(*a, &b);
+            LITHOS_CHECK(a->GetFirstChild() == &c);
+            LITHOS_CHECK_EQ(b.GetChildCount(), 0u);
+        }
+        LITHOS_CHECK(handle.expired());
+    }
+
+    // Moving items one at a time answers queries exactly like indexing them afresh,
+    // through full cells, moves off the grid and the rebuilds those trigger
+    void GridFollowsMoves() {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        // Built over [0, 400]; moves land anywhere in [-150, 550]
+        float spread = 400.0f, origin = 0.0f;
+        const auto randomRect = [&] {
+            if (rng() % 20 == 0) return Rect{};
+            const float x = origin + unit(rng) * spread, y = origin + unit(rng) * spread;
+            const float size = rng() % 10 == 0 ? 200.0f : 5.0f + unit(rng) * 30.0f;
+            return Rect::FromXYWH(x, y, size, size * (0.5f + unit(rng)));
+        };
+
+        std::vector<Rect> rects(300);
+        for (Rect& r : rects) r = randomRect();
+        SpatialIndex index;
+        index.Build(rects);
+        spread = 700.0f;
+        origin = -150.0f;
+
+        // Off the grid altogether
+        std::vector<uint32_t> found;
+        rects[0] = Rect::FromXYWH(-500, -500, 10, 10);
+        index.Update(0, rects[0]);
+        index.Query(-495, -495, found);
+        LITHOS_CHECK(found.size() == 1 && found[0] == 0);
+
+        for (int round = 0; round < 2000; ++round) {
+            const auto item = static_cast<uint32_t>(rng() % rects.size());
+            rects[item] = rng() % 3 ? rects[item].Offset(unit(rng) * 20 - 10, unit(rng) * 20 - 10) : randomRect();
+            index.Update(item, rects[item]);
+
+            for (int q = 0; q < 10; ++q) {
+                const float x = unit(rng) * 800 - 200, y = unit(rng) * 800 - 200;
+                found.clear();
+                index.Query(x, y, found);
+                size_t k = 0;
+                for (uint32_t i = static_cast<uint32_t>(rects.size()); i-- > 0;) {
+                    if (!rects[i].Contains(x, y)) continue;
+                    LITHOS_CHECK(k < found.size() && found[k] == i);
+                    ++k;
+                }
+                LITHOS_CHECK_EQ(k, found.size());
+            }
+        }
+    }
+
+    // Recording a long document, or a scrolled view into one, visits only what the clip shows
+    void RecordVisitsOnlyVisible() {
+        constexpr size_t Rows = 5000;
+        auto root = std::make_shared<Box>();
+        root->width(400).backgroundColor(Colors::White);
+        for (size_t i = 0; i < Rows; ++i) root->AddChild<Box>().width(400).height(20).backgroundColor(RowColor(i));
+        root->UpdateLayout();
+
+        // Rows 150..164 span y 3000..3300
+        DisplayList list;
+        root->Record(list, Rect(0, 3000, 400, 3300));
+        CheckRecordedRows(list, 150, 164, Rows);
+        LITHOS_CHECK(list.Size() <= 18u);
+
+        // Partial row at each edge
+        list.Clear();
+        root->Record(list, Rect(0, 3010, 400, 3290));
+        CheckRecordedRows(list, 150, 164, Rows);
+
+        // A clipped, scrolled view: only its visible rows, none of the content outside it
+        auto page = std::make_shared<Box>();
+        page->width(400);
+        auto& scroll = page->AddChild<ScrollView>();
+        scroll.width(300).height(200);
+        for (size_t i = 0; i < 1000; ++i) scroll.AddChild<Box>().width(280).height(20).backgroundColor(RowColor(i));
+        page->AddChild<Box>().width(400).height(50).backgroundColor(Colors::Black);
+        page->UpdateLayout();
+
+        scroll.ScrollTo(0, 8000);
+        list.Clear();
+        page->Record(list, Rect(0, 0, 400, 600));
+        CheckRecordedRows(list, 400, 409, 1000);
+        LITHOS_CHECK(list.Size() <= 14u);
+
+        // Scrolling repaints without layout and records the new rows
+        LITHOS_CHECK(!page->NeedsLayout());
+        scroll.ScrollTo(0, 150);
+        list.Clear();
+        page->Record(list, Rect(0, 0, 400, 600));
+        CheckRecordedRows(list, 7, 17, 1000);
+
+        // A window clip that cuts the view narrows it further: view rows 150..250 = content 300..400
+        list.Clear();
+        page->Record(list, Rect(0, 150, 400, 250));
+        CheckRecordedRows(list, 15, 17, 1000);
+    }
+
+    // Only the dirty path is laid out again; clean siblings after it are shifted, not re-laid out
+    void CleanSubtreesSkipLayout() {
+        auto root = std::make_shared<Counted>();
+        root->width(400);
+        std::vector<Counted*> sections;
+        for (int i = 0; i < 100; ++i) {
+            auto& section = root->AddChild<Counted>();
+            section.width(400).height(100);
+            for (int j = 0; j < 10; ++j) section.AddChild<Counted>().width(400).height(10);
+            sections.push_back(&section);
+        }
+        root->UpdateLayout();
+        LITHOS_CHECK_EQ(Counted::resolved, 1101u);
+
+        // Nothing changed: nothing is laid out
+        Counted::resolved = 0;
+        root->UpdateLayout();
+        LITHOS_CHECK_EQ(Counted::resolved, 0u);
+
+        // A repaint-only change stays out of layout
+        sections[30]->GetFirstChild()->backgroundColor(Colors::Black);
+        LITHOS_CHECK(!root->NeedsLayout());
+
+        // One leaf grows: it, its section and the root
+        auto* leaf = static_cast<Counted*>(sections[50]->GetFirstChild());
+        leaf->height(25);
+        root->UpdateLayout();
+        LITHOS_CHECK_EQ(Counted::resolved, 3u);
+        LITHOS_CHECK_EQ(leaf->GetNextSibling()->getY(), 50 * 100.0f + 25.0f);
+
+        // A section grows: its children keep their origin, every later section moves
+        Counted::resolved = 0;
+        sections[50]->height(115);
+        root->UpdateLayout();
+        LITHOS_CHECK_EQ(Counted::resolved, 2u);
+        LITHOS_CHECK_EQ(sections[51]->getY(), 51 * 100.0f + 15.0f);
+        LITHOS_CHECK_EQ(sections[51]->GetFirstChild()->getY(), 51 * 100.0f + 15.0f);
+        LITHOS_CHECK_EQ(sections[99]->GetSubtreeBounds().bottom, root->GetSubtreeBounds().bottom);
+        LITHOS_CHECK_EQ(sections[49]->getY(), 49 * 100.0f);
+    }
+}
+
+int main() {
+    RemovalReleasesChild();
+    EditsKeepSiblingOrder();
+    NoParentCycles();
+    GridFollowsMoves();
+    RecordVisitsOnlyVisible();
+    CleanSubtreesSkipLayout();
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Event.hpp"
+#include "Lithos/Core/EventDispatcher.hpp"
+#include "Lithos/Core/HoverTracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace Lithos;
+
+// Counts every allocation in the process, the library's included
+namespace {
+    std::atomic<size_t> allocations{0};
+}
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    struct Node : ElementBase<Node> {
+        int defaults = 0;
+
+        bool OnMouseEvent(MouseEvent) override {
+            defaults++;
+            return false;
+        }
+    };
+
+    constexpr int Depth = 30;
+
+    // Once warmed up, dispatch reuses its path buffer: 100k events through 30 levels allocate nothing
+    void DispatchDoesNotAllocate() {
+        auto root = std::make_shared<Node>();
+        std::vector<Node*> chain{root.get()};
+        while (chain.size() < Depth) chain.push_back(&chain.back()->AddChild<Node>());
+        Node& leaf = *chain.back();
+        LITHOS_CHECK(allocations.load() >= Depth);    // The counter sees the library's allocations
+
+        long captured = 0, bubbled = 0;
+        for (Node* node : chain) {
+            node->AddEventListener(MouseEventType::MouseDown, [&](const MouseEvent& evt) {
+                captured++;
+                LITHOS_CHECK(evt.phase == EventPhase::Capturing || evt.phase == EventPhase::AtTarget);
+            }, true);
+            node->AddEventListener(MouseEventType::MouseDown, [&](MouseEvent&) { bubbled++; });
+        }
+
+        EventDispatcher dispatcher;
+        MouseEvent prototype{};
+        prototype.type = MouseEventType::MouseDown;
+        for (int i = 0; i < 100; ++i) {
+            MouseEvent evt = prototype;
+            dispatcher.Dispatch(leaf, evt);
+        }
+
+        captured = bubbled = 0;
+        const size_t before = allocations.load();
+        for (int i = 0; i < 100000; ++i) {
+            MouseEvent evt = prototype;
+            dispatcher.Dispatch(leaf, evt);
+        }
+        LITHOS_CHECK_EQ(allocations.load() - before, 0u);
+        LITHOS_CHECK_EQ(captured, 100000L * Depth);
+        LITHOS_CHECK_EQ(bubbled, 100000L * Depth);
+        LITHOS_CHECK_EQ(leaf.defaults, 100100);
+    }
+
+    void PropagationStops() {
+        auto root = std::make_shared<Node>();
+        std::vector<Node*> chain{root.get()};
+        while (chain.size() < Depth) chain.push_back(&chain.back()->AddChild<Node>());
+        Node& leaf = *chain.back();
+
+        long captured = 0, bubbled = 0;
+        for (Node* node : chain) {
+            node->AddEventListener(MouseEventType::MouseDown, [&](MouseEvent&) { captured++; }, true);
+            node->AddEventListener(MouseEventType::MouseDown, [&](MouseEvent&) { bubbled++; });
+        }
+        EventDispatcher dispatcher;
+
+        // Stopped while bubbling through depth 10: levels 10..29 bubble
+        const uint32_t stop = chain[10]->AddEventListener(MouseEventType::MouseDown,
+                                                          [](MouseEvent& evt) { evt.StopPropagation(); });
+        MouseEvent evt{};
+        evt.type = MouseEventType::MouseDown;
+        LITHOS_CHECK(dispatcher.Dispatch(leaf, evt));
+        LITHOS_CHECK_EQ(captured, Depth);
+        LITHOS_CHECK_EQ(bubbled, Depth - 10);
+        chain[10]->RemoveEventListener(stop);
+
+        // Stopped immediately in the root's capture listener: nothing else runs
+        const uint32_t halt = chain[0]->AddEventListener(MouseEventType::MouseDown,
+                                                         [](MouseEvent& e) { e.StopImmediatePropagation(); }, true);
+        captured = bubbled = 0;
+        evt = MouseEvent{};
+        evt.type = MouseEventType::MouseDown;
+        LITHOS_CHECK(dispatcher.Dispatch(leaf, evt));
+        LITHOS_CHECK_EQ(captured, 1);
+        LITHOS_CHECK_EQ(bubbled, 0);
+        chain[0]->RemoveEventListener(halt);
+    }
+
+    // Listeners added during a dispatch first run for the next event; dispatch may re-enter
+    void ListenersChangedDuringDispatch() {
+        auto root = std::make_shared<Node>();
+        std::vector<Node*> chain{root.get()};
+        while (chain.size() < Depth) chain.push_back(&chain.back()->AddChild<Node>());
+
+        EventDispatcher dispatcher;
+        int added = 0, nested = 0;
+        uint32_t self = 0;
+        chain[20]->AddEventListener(MouseEventType::MouseMove, [&](MouseEvent&) { nested++; });
+        self = chain[5]->AddEventListener(MouseEventType::MouseUp, [&](MouseEvent&) {
+            chain[5]->RemoveEventListener(self);
+            chain[5]->AddEventListener(MouseEventType::MouseUp, [&](MouseEvent&) { added++; });
+            MouseEvent move{};
+            move.type = MouseEventType::MouseMove;
+            dispatcher.Dispatch(*chain[20], move);
+        });
+
+        MouseEvent up{};
+        up.type = MouseEventType::MouseUp;
+        dispatcher.Dispatch(*chain.back(), up);
+        LITHOS_CHECK_EQ(added, 0);
+        LITHOS_CHECK_EQ(nested, 1);
+
+        up = MouseEvent{};
+        up.type = MouseEventType::MouseUp;
+        dispatcher.Dispatch(*chain.back(), up);
+        LITHOS_CHECK_EQ(added, 1);
+        LITHOS_CHECK_EQ(nested, 1);
+    }
+
+    // Hands a freed block straight back to the next allocation, as a pool's free list does
+    struct Recycled : ElementBase<Recycled> {
+        static inline void* spare = nullptr;
+
+        static void* operator new(const std::size_t size) {
+            void* p = spare ? spare : ::operator new(size);
+            spare = nullptr;
+            return p;
+        }
+
+        static void operator delete(void* p) {
+            if (spare) ::operator delete(spare);
+            spare = p;
+        }
+    };
+
+    // The hover cache survives removal and re-insertion, and never takes a new element
+    // at a freed one's address for the element it remembers
+    void HoverAcrossRemoval() {
+        auto root = std::make_shared<Node>();
+        root->width(100).height(100);
+        int enters = 0, leaves = 0;
+        // A control block of its own lets the element's memory go while the tracker's weak
+        // handle lives on, so the next element lands at the same address
+        const auto make = [&] {
+            auto e = std::shared_ptr<Recycled>(new Recycled);
+            e->width(50).height(50);
+            e->AddEventListener(MouseEventType::MouseEnter, [&](MouseEvent&) { enters++; });
+            e->AddEventListener(MouseEventType::MouseLeave, [&](MouseEvent&) { leaves++; });
+            return e;
+        };
+        Recycled* first = &root->AddChild(make());
+        root->UpdateLayout();
+
+        HoverTracker hover;
+        LITHOS_CHECK(hover.Update(*root, 10, 10) == first);
+        LITHOS_CHECK(hover.Update(*root, 12, 12) == first);
+        LITHOS_CHECK_EQ(hover.GetStats().cacheMisses, 1u);
+        LITHOS_CHECK_EQ(hover.GetStats().cacheHits, 1u);
+        LITHOS_CHECK_EQ(hover.GetStats().enters, 2u);   // Root, then the child
+        LITHOS_CHECK_EQ(enters, 1);
+
+        // Removed but alive: it hears MouseLeave; put back: MouseEnter again
+        auto kept = root->RemoveChild(*first);
+        root->UpdateLayout();
+        LITHOS_CHECK(hover.Update(*root, 10, 10) == root.get());
+        LITHOS_CHECK_EQ(leaves, 1);
+        root->AddChild(kept);
+        root->UpdateLayout();
+        LITHOS_CHECK(hover.Update(*root, 10, 10) == first);
+        LITHOS_CHECK_EQ(enters, 2);
+        LITHOS_CHECK_EQ(hover.GetStats().cacheMisses, 2u);     // The index no longer matched
+        LITHOS_CHECK_EQ(hover.GetStats().cacheHits, 2u);       // The root path held; its hit is the child
+
+        // Destroyed, and a new element takes its memory and its slot before the next update
+        root->RemoveChild(*first);
+        kept.reset();
+        Recycled* second = &root->AddChild(make());
+        root->UpdateLayout();
+        LITHOS_CHECK(second == first);
+        LITHOS_CHECK(hover.GetTarget() == nullptr);
+        LITHOS_CHECK(hover.Update(*root, 10, 10) == second);
+        LITHOS_CHECK_EQ(hover.GetStats().cacheMisses, 3u);
+        LITHOS_CHECK_EQ(enters, 3);
+        LITHOS_CHECK_EQ(leaves, 1);                 // Nothing to tell the destroyed one
+        LITHOS_CHECK_EQ(hover.GetStats().enters, 4u);
+        LITHOS_CHECK_EQ(hover.GetStats().leaves, 1u);
+    }
+}
+
+int main() {
+    DispatchDoesNotAllocate();
+    PropagationStops();
+    ListenersChangedDuringDispatch();
+    HoverAcrossRemoval();
+    return 0;
+}
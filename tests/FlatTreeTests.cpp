@@ -0,0 +1,184 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Components/ScrollView.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    struct Box : ElementBase<Box> {
+        Box& at(const float x, const float y) {
+            style.left = x;
+            style.top = y;
+            InvalidateLayout();
+            return *this;
+        }
+    };
+
+    bool SameCommands(const DisplayList& a, const DisplayList& b) {
+        if (a.Size() != b.Size() || a.GroupCount() != b.GroupCount()) return false;
+        for (size_t i = 0; i < a.Size(); ++i) {
+            const auto& x = a.Commands()[i];
+            const auto& y = b.Commands()[i];
+            if (x.type != y.type || !(x.rect == y.rect) || !(x.bounds == y.bounds) || !(x.clip == y.clip)
+                || x.radius != y.radius || x.param != y.param || x.flags != y.flags || x.group != y.group
+                || x.color.r != y.color.r || x.color.g != y.color.g || x.color.b != y.color.b
+                || x.color.a != y.color.a) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool MatchesObjectWalk(Element& root, const FlatTree& tree, const Rect& clip) {
+        DisplayList fromTree, fromElements;
+        tree.Record(fromTree, clip);
+        root.Record(fromElements, clip);
+        return SameCommands(fromTree, fromElements);
+    }
+
+    // Removing a child hands its parent's subtree to the element walk instead of rebuilding
+    void StructuralEditDetachesSubtree() {
+        auto root = std::make_shared<Box>();
+        root->width(400).height(400);
+        std::vector<Box*> rows;
+        for (int i = 0; i < 40; ++i) {
+            auto& row = root->AddChild<Box>();
+            row.width(400).height(10).backgroundColor({0.0f, 0.0f, 0.025f * i, 1.0f});
+            rows.push_back(&row);
+            for (int j = 0; j < 20; ++j) row.AddChild<Box>().width(20).height(10).backgroundColor({0.05f * j, 0, 0, 1});
+        }
+        root->UpdateLayout();
+        FlatTree tree;
+        tree.Sync(*root);
+        const Rect clip(0, 0, 400, 400);
+        LITHOS_CHECK_EQ(tree.GetStats().rebuilds, 1u);
+
+        rows[3]->RemoveChild(*rows[3]->GetFirstChild());
+        root->UpdateLayout();
+        tree.Sync(*root);
+        LITHOS_CHECK_EQ(tree.GetStats().rebuilds, 1u);
+        LITHOS_CHECK_EQ(tree.GetStats().detached, 1u);
+        LITHOS_CHECK(tree.IsCurrent(*root));
+        LITHOS_CHECK(MatchesObjectWalk(*root, tree, clip));
+        LITHOS_CHECK(tree.FindElementAt(5, 35) == root->FindElementAt(5, 35));
+
+        // Changes below a detached node still reach the arrays through its version
+        const uint64_t before = tree.GetSubtreeVersion(0);
+        static_cast<Box*>(rows[3]->GetLastChild())->backgroundColor({0, 1, 0, 1});
+        root->UpdateLayout();
+        tree.Sync(*root);
+        LITHOS_CHECK(tree.GetSubtreeVersion(0) > before);
+        LITHOS_CHECK(MatchesObjectWalk(*root, tree, clip));
+
+        // Once a quarter of the nodes sit under detached subtrees, the next sync rebuilds
+        for (int i = 4; i < 16; ++i) rows[i]->AddChild<Box>().width(5).height(5);
+        root->UpdateLayout();
+        tree.Sync(*root);
+        LITHOS_CHECK_EQ(tree.GetStats().rebuilds, 2u);
+        LITHOS_CHECK(MatchesObjectWalk(*root, tree, clip));
+    }
+
+    void Collect(Element& element, std::vector<Element*>& out) {
+        out.push_back(&element);
+        for (Element* child = element.GetFirstChild(); child; child = child->GetNextSibling()) Collect(*child, out);
+    }
+
+    bool IsAncestorOrSelf(const Element& candidate, const Element* e) {
+        for (; e; e = e->GetParent()) {
+            if (e == &candidate) return true;
+        }
+        return false;
+    }
+
+    // Random edits of every kind, synced incrementally, paint and hit-test like the object tree
+    void RandomEditsMatchObjectWalk() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const auto color = [&] { return Color{unit(rng), unit(rng), unit(rng), 1.0f}; };
+
+        auto root = std::make_shared<Box>();
+        root->width(600).height(800);
+        auto& scroll = root->AddChild<ScrollView>();
+        scroll.width(300).height(150).backgroundColor(Colors::White);
+        for (int i = 0; i < 60; ++i) {
+            auto& row = (i % 3 == 0 ? static_cast<Element&>(scroll) : static_cast<Element&>(*root)).AddChild<Box>();
+            row.width(200 + unit(rng) * 300).height(5 + unit(rng) * 20).backgroundColor(color()).margin(1);
+            for (int j = 0; j < 4; ++j) row.AddChild<Box>().width(10).height(4).backgroundColor(color());
+        }
+
+        FlatTree tree;
+        std::vector<Element*> live;
+        for (int round = 0; round < 400; ++round) {
+            for (int k = 0; k < 4; ++k) {
+                live.clear();
+                Collect(*root, live);
+                Element& e = *live[1 + rng() % (live.size() - 1)];     // Never the root
+                Element& other = *live[rng() % live.size()];
+                Element* parent = e.GetParent();
+                switch (rng() % 10) {
+                    case 0: static_cast<Box&>(other).AddChild<Box>().width(5 + unit(rng) * 50).height(3 + unit(rng) * 10)
+                                .backgroundColor(color()); break;
+                    case 1: if (&e != &scroll && parent) parent->RemoveChild(e); break;
+                    case 2: if (parent) parent->MoveChild(e, rng() % 2 ? parent->GetFirstChild() : nullptr); break;
+                    case 3: if (&e != &scroll && !IsAncestorOrSelf(e, &other)) e.Reparent(other, other.GetFirstChild()); break;
+                    case 4: if (&e != &scroll) static_cast<Box&>(e).backgroundColor(color()); break;
+                    case 5: if (&e != &scroll) static_cast<Box&>(e).height(1 + unit(rng) * 30); break;
+                    case 6: if (&e != &scroll) static_cast<Box&>(e).visible(rng() % 4 != 0); break;
+                    case 7: if (&e != &scroll) static_cast<Box&>(e).at(unit(rng) * 40 - 20, unit(rng) * 60 - 30); break;
+                    case 8: scroll.ScrollTo(0, unit(rng) * 300); break;
+                    default:
+                        // Enough overlapping children for the parent to index them in a grid
+                        if (&other != &scroll && !(rng() % 8)) {
+                            for (int i = 0; i < 40; ++i) {
+                                static_cast<Box&>(other).AddChild<Box>().width(8).height(8).backgroundColor(color())
+                                    .at(unit(rng) * 100, -unit(rng) * 80);
+                            }
+                        }
+                        break;
+                }
+            }
+
+            root->UpdateLayout();
+            tree.Sync(*root);
+            LITHOS_CHECK(tree.IsCurrent(*root));
+            for (int c = 0; c < 3; ++c) {
+                const float top = unit(rng) * 700;
+                LITHOS_CHECK(MatchesObjectWalk(*root, tree, Rect(0, top, 600, top + unit(rng) * 300)));
+            }
+            for (int p = 0; p < 50; ++p) {
+                const float x = unit(rng) * 600, y = unit(rng) * 800;
+                LITHOS_CHECK(tree.FindElementAt(x, y) == root->FindElementAt(x, y));
+            }
+        }
+        LITHOS_CHECK(tree.GetStats().detached > 0);
+        LITHOS_CHECK(tree.GetStats().rebuilds > 1);
+    }
+}
+
+int main() {
+    StructuralEditDetachesSubtree();
+    RandomEditsMatchObjectWalk();
+    return 0;
+}
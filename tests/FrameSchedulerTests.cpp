@@ -0,0 +1,193 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/FrameScheduler.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = FrameScheduler::Clock;
+
+    // Driven by a synthetic clock: the scheduler never reads one itself
+    struct Fixture {
+        FrameScheduler scheduler{10ms};
+        Clock::time_point now = Clock::time_point{} + 100s;
+        std::string log;            ///< Phase initials of every frame run
+        int animationFrames = 0;    ///< Frames the Animate phase still asks for
+        int wakes = 0;
+        uint8_t lastWork = 0;
+
+        Fixture() {
+            scheduler.SetWakeHandler([this] { wakes++; });
+            static constexpr char Names[] = "IALPR";
+            for (size_t i = 0; i < FramePhaseCount; ++i) {
+                scheduler.SetPhase(static_cast<FramePhase>(i), [this, i](const FrameInfo& info) {
+                    log += Names[i];
+                    lastWork = info.work;
+                    if (static_cast<FramePhase>(i) == FramePhase::Animate && animationFrames > 0) {
+                        animationFrames--;
+                        scheduler.RequestFrame(FrameWork::Animation);
+                    }
+                });
+            }
+        }
+
+        /// Advances the clock 1 ms at a time for `duration`; returns frames run
+        int Run(const Clock::duration duration) {
+            int frames = 0;
+            for (const auto end = now + duration; now < end; now += 1ms) {
+                if (scheduler.Tick(now)) frames++;
+            }
+            return frames;
+        }
+    };
+
+    void IdleUntilRequested() {
+        Fixture f;
+        LITHOS_CHECK(f.scheduler.IsIdle());
+        LITHOS_CHECK(f.scheduler.NextFrameTime() == Clock::time_point::max());
+        LITHOS_CHECK(!f.scheduler.Tick(f.now));
+        LITHOS_CHECK_EQ(f.Run(1s), 0);
+
+        // Requests coalesce into one frame that runs every phase in order, right away after idling
+        f.scheduler.RequestFrame(FrameWork::Input);
+        f.scheduler.RequestFrame(FrameWork::Damage);
+        LITHOS_CHECK_EQ(f.wakes, 1);
+        LITHOS_CHECK(f.scheduler.NextFrameTime() <= f.now);
+        LITHOS_CHECK(f.scheduler.Tick(f.now));
+        LITHOS_CHECK(f.log == "IALPR");
+        LITHOS_CHECK_EQ(f.lastWork, FrameWork::Input | FrameWork::Damage);
+        LITHOS_CHECK(f.scheduler.IsIdle());
+        LITHOS_CHECK_EQ(f.Run(1s), 0);
+    }
+
+    void InputCoalescesToCadence() {
+        Fixture f;
+        // Input every 2 ms for 300 ms runs at most one frame per 10 ms interval
+        int frames = 0;
+        for (int ms = 0; ms < 300; ++ms) {
+            if (ms % 2 == 0) f.scheduler.RequestFrame(FrameWork::Input);
+            if (f.scheduler.Tick(f.now)) frames++;
+            f.now += 1ms;
+        }
+        LITHOS_CHECK(frames >= 29 && frames <= 31);
+        // Each frame drains the work; only the first request after it wakes the loop again,
+        // and the last one may still be waiting for its frame
+        const uint64_t wakeups = f.scheduler.GetStats().wakeups;
+        LITHOS_CHECK(wakeups >= static_cast<uint64_t>(frames) && wakeups <= static_cast<uint64_t>(frames) + 1);
+        LITHOS_CHECK_EQ(f.scheduler.GetStats().missedIntervals, 0u);
+    }
+
+    void AnimationsTickUntilDone() {
+        Fixture f;
+        f.animationFrames = 5;
+        f.scheduler.RequestFrame(FrameWork::Animation);
+        LITHOS_CHECK_EQ(f.Run(1s), 6);     // The request plus five re-requests
+        LITHOS_CHECK(f.scheduler.IsIdle());
+
+        // A frame that runs late counts the intervals it missed, then the cadence restarts
+        f.animationFrames = 3;
+        f.scheduler.RequestFrame(FrameWork::Animation);
+        f.Run(1ms);
+        f.now += 35ms;
+        LITHOS_CHECK(f.scheduler.Tick(f.now));
+        LITHOS_CHECK_EQ(f.scheduler.GetStats().missedIntervals, 2u);
+        f.Run(1s);
+        LITHOS_CHECK(f.scheduler.IsIdle());
+    }
+
+    void TimerBookingsWaitWithoutFrames() {
+        Fixture f;
+        f.scheduler.RequestFrameAt(f.now + 250ms, FrameWork::Resume);
+        LITHOS_CHECK(f.scheduler.NextFrameTime() == f.now + 250ms);
+        LITHOS_CHECK_EQ(f.Run(249ms), 0);
+        LITHOS_CHECK_EQ(f.Run(2ms), 1);
+        LITHOS_CHECK_EQ(f.lastWork, FrameWork::Resume);
+        LITHOS_CHECK(f.scheduler.NextFrameTime() == Clock::time_point::max());
+
+        // The earliest booking wins; work booked for later rides along
+        f.scheduler.RequestFrameAt(f.now + 50ms, FrameWork::Damage);
+        f.scheduler.RequestFrameAt(f.now + 20ms, FrameWork::Resume);
+        LITHOS_CHECK_EQ(f.Run(100ms), 1);
+        LITHOS_CHECK_EQ(f.lastWork, FrameWork::Damage | FrameWork::Resume);
+    }
+
+    void CrossThreadRequestsWake() {
+        Fixture f;
+        std::thread producer([&] { f.scheduler.RequestFrame(FrameWork::Tasks); });
+        producer.join();
+        LITHOS_CHECK_EQ(f.wakes, 1);
+        LITHOS_CHECK(f.scheduler.Tick(f.now));
+
+        // Requests made by a phase go to the next frame and wake nothing
+        f.animationFrames = 1;
+        f.scheduler.RequestFrame(FrameWork::Animation);
+        const int wakesBefore = f.wakes;
+        f.Run(100ms);
+        LITHOS_CHECK_EQ(f.wakes, wakesBefore);
+    }
+
+    // Damage requested on the way to Paint is painted by the same frame; only what comes
+    // after Paint, or animations asking for their next tick, costs another frame
+    void PaintAbsorbsEarlierDamage() {
+        Fixture f;
+        uint8_t painted = 0;
+        bool damageBeforePaint = false, damageAfterPaint = false;
+        f.scheduler.SetPhase(FramePhase::Input, [&](const FrameInfo&) {
+            if (damageBeforePaint) f.scheduler.RequestFrame(FrameWork::Damage);
+        });
+        f.scheduler.SetPhase(FramePhase::Layout, [&](const FrameInfo&) {
+            if (damageBeforePaint) f.scheduler.RequestFrame(FrameWork::Region);
+        });
+        f.scheduler.SetPhase(FramePhase::Paint, [&](const FrameInfo& info) { painted = info.work; });
+        f.scheduler.SetPhase(FramePhase::Present, [&](const FrameInfo&) {
+            if (damageAfterPaint) f.scheduler.RequestFrame(FrameWork::Damage);
+            damageAfterPaint = false;
+        });
+
+        damageBeforePaint = true;
+        f.scheduler.RequestFrame(FrameWork::Input);
+        LITHOS_CHECK_EQ(f.Run(1s), 1);
+        LITHOS_CHECK_EQ(painted, FrameWork::Input | FrameWork::Damage | FrameWork::Region);
+        LITHOS_CHECK(f.scheduler.IsIdle());
+        damageBeforePaint = false;
+
+        damageAfterPaint = true;
+        f.scheduler.RequestFrame(FrameWork::Input);
+        LITHOS_CHECK_EQ(f.Run(1s), 2);
+        LITHOS_CHECK_EQ(painted, FrameWork::Damage);
+
+        f.animationFrames = 2;
+        f.scheduler.RequestFrame(FrameWork::Animation);
+        LITHOS_CHECK_EQ(f.Run(1s), 3);
+    }
+}
+
+int main() {
+    IdleUntilRequested();
+    InputCoalescesToCadence();
+    AnimationsTickUntilDone();
+    TimerBookingsWaitWithoutFrames();
+    CrossThreadRequestsWake();
+    PaintAbsorbsEarlierDamage();
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Image/ImageDecoder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    std::vector<uint8_t> Pgm(const int width, const int height, const uint8_t value) {
+        const std::string header = "P5\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+        std::vector<uint8_t> data(header.begin(), header.end());
+        data.resize(data.size() + static_cast<size_t>(width) * static_cast<size_t>(height), value);
+        return data;
+    }
+
+    ImageDecoder::SizeFunction Fixed(const int width, const int height) {
+        return [=](int, int, int& w, int& h) {
+            w = width;
+            h = height;
+        };
+    }
+
+    // Averaging 4200x4200 white pixels into one sums past 2^32 per channel
+    void LargeDownscaleDoesNotOverflow() {
+        const PpmDecoder decoder;
+        const auto data = Pgm(4200, 4200, 255);
+        const auto image = decoder.Decode(data, Fixed(1, 1));
+        LITHOS_CHECK(image != nullptr);
+        LITHOS_CHECK_EQ(image->sourceWidth, 4200);
+        LITHOS_CHECK_EQ(image->pixels[0], 0xFFFFFFFFu);
+    }
+
+    // A 4x2 image halved in each direction averages 2x1 blocks
+    void DownscaleAverages() {
+        const PpmDecoder decoder;
+        auto data = Pgm(4, 2, 0);
+        const size_t samples = data.size() - 8;
+        const uint8_t values[] = {10, 20, 200, 100, 30, 40, 0, 0};
+        for (size_t i = 0; i < 8; ++i) data[samples + i] = values[i];
+
+        const auto image = decoder.Decode(data, Fixed(2, 1));
+        LITHOS_CHECK(image != nullptr);
+        LITHOS_CHECK_EQ(image->pixels[0], 0xFF191919u);    // (10 + 20 + 30 + 40) / 4 = 25
+        LITHOS_CHECK_EQ(image->pixels[1], 0xFF4B4B4Bu);    // (200 + 100 + 0 + 0) / 4 = 75
+    }
+
+    // The size callback sees the header's size and can decline with an empty size
+    void SizeChosenFromHeader() {
+        const PpmDecoder decoder;
+        const auto data = Pgm(6, 4, 128);
+        int seenWidth = 0, seenHeight = 0;
+        const auto image = decoder.Decode(data, [&](const int sw, const int sh, int& w, int& h) {
+            seenWidth = sw;
+            seenHeight = sh;
+            w = sw / 2;
+            h = sh / 2;
+        });
+        LITHOS_CHECK_EQ(seenWidth, 6);
+        LITHOS_CHECK_EQ(seenHeight, 4);
+        LITHOS_CHECK(image != nullptr);
+        LITHOS_CHECK_EQ(image->width, 3);
+        LITHOS_CHECK_EQ(image->height, 2);
+
+        LITHOS_CHECK(decoder.Decode(data, Fixed(0, 0)) == nullptr);
+    }
+}
+
+int main() {
+    DownscaleAverages();
+    SizeChosenFromHeader();
+    LargeDownscaleDoesNotOverflow();
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Threading/JobSystem.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    /// Fork/join recursion: every level above the cutoff forks both halves
+    long Fibonacci(JobSystem& jobs, const int n) {
+        if (n < 16) {
+            long a = 0, b = 1;
+            for (int i = 0; i < n; ++i) {
+                const long next = a + b;
+                a = b;
+                b = next;
+            }
+            return a;
+        }
+        long x = 0, y = 0;
+        jobs.Join([&] { x = Fibonacci(jobs, n - 1); }, [&] { y = Fibonacci(jobs, n - 2); });
+        return x + y;
+    }
+
+    // Nested fork/join, outside threads waiting on their own loops and fire-and-forget jobs, all at once
+    void StressForkJoin() {
+        JobSystem jobs(3);
+        for (int round = 0; round < 10; ++round) {
+            std::atomic<int> loops{0}, fired{0};
+            std::vector<std::thread> outside;
+            for (int t = 0; t < 3; ++t) {
+                outside.emplace_back([&] {
+                    for (int k = 0; k < 30; ++k) {
+                        std::atomic<long> sum{0};
+                        jobs.ParallelFor(1000, [&](const size_t i) { sum += static_cast<long>(i); });
+                        LITHOS_CHECK_EQ(sum.load(), 499500L);
+                        loops++;
+                    }
+                });
+            }
+            for (int k = 0; k < 1000; ++k) jobs.Submit([&] { fired++; });
+
+            LITHOS_CHECK_EQ(Fibonacci(jobs, 25), 75025L);
+            for (std::thread& thread : outside) thread.join();
+            LITHOS_CHECK_EQ(loops.load(), 90);
+
+            // Nobody waits for fire-and-forget jobs; the workers still drain them
+            for (int spin = 0; spin < 1000 && fired.load() < 1000; ++spin) std::this_thread::sleep_for(1ms);
+            LITHOS_CHECK_EQ(fired.load(), 1000);
+        }
+
+        const JobSystemStats stats = jobs.GetStats();
+        uint64_t run = stats.helped;
+        for (const JobWorkerStats& worker : stats.workers) run += worker.jobs;
+        LITHOS_CHECK_EQ(run, stats.submitted);
+    }
+
+    // Jobs forked inside a worker land in its own deque; idle workers get them only by stealing
+    void IdleWorkersSteal() {
+        JobSystem jobs(3);
+        std::atomic<int> taken{0};
+        std::atomic<bool> done{false};
+        jobs.Submit([&] {
+            const std::thread::id owner = std::this_thread::get_id();
+            TaskGroup group(jobs);
+            for (int i = 0; i < 8; ++i) {
+                group.Run([&, owner] {
+                    if (std::this_thread::get_id() != owner) taken++;
+                });
+            }
+            // Hold back instead of helping, so the others have to come and take them
+            for (int spin = 0; spin < 2000 && taken.load() < 4; ++spin) std::this_thread::sleep_for(1ms);
+            group.Wait();
+            done = true;
+        });
+        for (int spin = 0; spin < 5000 && !done; ++spin) std::this_thread::sleep_for(1ms);
+        LITHOS_CHECK(done);
+        LITHOS_CHECK(taken.load() >= 4);
+
+        uint64_t steals = 0;
+        for (const JobWorkerStats& worker : jobs.GetStats().workers) steals += worker.steals;
+        LITHOS_CHECK(steals >= static_cast<uint64_t>(taken.load()));
+    }
+
+    // Without workers nothing runs on the submitter's stack; waiting callers run the jobs
+    void NoWorkersQueuesUntilWaited() {
+        JobSystem jobs(0);
+        const std::thread::id caller = std::this_thread::get_id();
+
+        std::atomic<int> ran{0};
+        jobs.Submit([&] { ran++; });
+        LITHOS_CHECK_EQ(ran.load(), 0);
+        LITHOS_CHECK(jobs.RunPending());
+        LITHOS_CHECK_EQ(ran.load(), 1);
+        LITHOS_CHECK(!jobs.RunPending());
+
+        // Fork/join still completes: the waiting thread runs every job itself
+        int order = 0, a = 0, b = 0;
+        jobs.Join([&] { a = ++order; }, [&] { b = ++order; });
+        LITHOS_CHECK(a == 1 && b == 2);     // b was queued, a ran first, Wait() ran b
+
+        {
+            TaskGroup group(jobs);
+            for (int i = 0; i < 100; ++i) {
+                group.Run([&] {
+                    LITHOS_CHECK(std::this_thread::get_id() == caller);
+                    ran++;
+                });
+            }
+            LITHOS_CHECK_EQ(ran.load(), 1);
+        }
+        LITHOS_CHECK_EQ(ran.load(), 101);
+        LITHOS_CHECK_EQ(jobs.GetStats().helped, 102u);
+    }
+
+    // The shared system runs fire-and-forget jobs on its own, even configured for none
+    void SharedAlwaysHasWorker() {
+        LITHOS_CHECK(JobSystem::ConfigureShared(0));
+        JobSystem& shared = JobSystem::Shared();
+        LITHOS_CHECK(shared.GetWorkerCount() >= 1);
+        LITHOS_CHECK(!JobSystem::ConfigureShared(4));
+
+        std::atomic<bool> ran{false};
+        shared.Submit([&] { ran = true; });
+        for (int spin = 0; spin < 500 && !ran; ++spin) std::this_thread::sleep_for(10ms);
+        LITHOS_CHECK(ran);
+    }
+}
+
+int main() {
+    StressForkJoin();
+    IdleWorkersSteal();
+    NoWorkersQueuesUntilWaited();
+    SharedAlwaysHasWorker();
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/LatencyTracker.hpp"
+
+#include <chrono>
+#include <vector>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = LatencyTracker::Clock;
+
+    // Each mark lands in the frame's timing; latency runs from the oldest input to present
+    void MarksFillFrameTiming() {
+        LatencyTracker tracker;
+        const auto t0 = Clock::time_point{} + 1h;
+        LITHOS_CHECK_EQ(tracker.GetLastFrame().frame, 0u);
+
+        tracker.BeginFrame(t0);
+        tracker.InputConsumed(t0 - 7ms);
+        tracker.InputConsumed(t0 - 12ms);
+        tracker.InputConsumed(t0 - 3ms);
+        tracker.MarkDispatched(t0 + 1ms);
+        tracker.MarkLaidOut(t0 + 3ms);
+        tracker.MarkPainted(t0 + 6ms);
+        tracker.MarkPresented(t0 + 8ms);
+
+        const FrameTiming& frame = tracker.GetLastFrame();
+        LITHOS_CHECK_EQ(frame.frame, 1u);
+        LITHOS_CHECK(frame.begin == t0);
+        LITHOS_CHECK(frame.dispatched == t0 + 1ms);
+        LITHOS_CHECK(frame.laidOut == t0 + 3ms);
+        LITHOS_CHECK(frame.painted == t0 + 6ms);
+        LITHOS_CHECK(frame.presented == t0 + 8ms);
+        LITHOS_CHECK_EQ(frame.inputs, 3u);
+        LITHOS_CHECK(frame.oldestInput == t0 - 12ms);
+        LITHOS_CHECK(frame.newestInput == t0 - 3ms);
+        LITHOS_CHECK(frame.InputLatency() == 20ms);
+        LITHOS_CHECK(frame.Duration() == 8ms);
+
+        // Every raw event is a sample: 20, 15 and 11 ms
+        const LatencySummary input = tracker.GetInputLatency();
+        LITHOS_CHECK_EQ(input.samples, 3u);
+        LITHOS_CHECK(input.p50 == 15ms);
+        LITHOS_CHECK(input.max == 20ms);
+        LITHOS_CHECK(input.mean == std::chrono::nanoseconds(46ms) / 3);
+
+        // A frame without input adds a duration but no latency sample
+        tracker.BeginFrame(t0 + 16ms);
+        tracker.MarkDispatched(t0 + 16ms);
+        tracker.MarkLaidOut(t0 + 17ms);
+        tracker.MarkPainted(t0 + 18ms);
+        tracker.MarkPresented(t0 + 20ms);
+        LITHOS_CHECK_EQ(tracker.GetLastFrame().frame, 2u);
+        LITHOS_CHECK_EQ(tracker.GetLastFrame().inputs, 0u);
+        LITHOS_CHECK(tracker.GetLastFrame().InputLatency() == 0ns);
+        LITHOS_CHECK_EQ(tracker.GetInputLatency().samples, 3u);
+        LITHOS_CHECK_EQ(tracker.GetFrameDuration().samples, 2u);
+        LITHOS_CHECK(tracker.GetFrameDuration().max == 8ms);
+    }
+
+    // Nearest-rank percentiles over 1..100 ms, fed in scrambled order
+    void PercentilesOfKnownSamples() {
+        LatencyTracker tracker;
+        auto now = Clock::time_point{} + 1h;
+        for (int i = 0; i < 100; ++i) {
+            const auto ms = std::chrono::milliseconds((i * 37) % 100 + 1);
+            now += 1s;
+            tracker.BeginFrame(now);
+            tracker.InputConsumed(now - ms);
+            tracker.MarkDispatched(now);
+            tracker.MarkLaidOut(now);
+            tracker.MarkPainted(now);
+            tracker.MarkPresented(now + std::chrono::microseconds(ms) / 10);
+        }
+
+        // Arrival to present is the wait plus the frame's own tenth
+        const LatencySummary frames = tracker.GetFrameDuration();
+        LITHOS_CHECK_EQ(frames.samples, 100u);
+        LITHOS_CHECK(frames.p50 == 5ms);
+        LITHOS_CHECK(frames.p90 == 9ms);
+        LITHOS_CHECK(frames.max == 10ms);
+
+        const LatencySummary input = tracker.GetInputLatency();
+        LITHOS_CHECK_EQ(input.samples, 100u);
+        LITHOS_CHECK(input.p50 == 55ms);
+        LITHOS_CHECK(input.p90 == 99ms);
+        LITHOS_CHECK(input.p99 == 108900us);
+        LITHOS_CHECK(input.max == 110ms);
+        LITHOS_CHECK(input.mean == 55550us);
+
+        // An empty window summarizes to zeros
+        tracker.Reset();
+        LITHOS_CHECK_EQ(tracker.GetInputLatency().samples, 0u);
+        LITHOS_CHECK(tracker.GetInputLatency().p99 == 0ns);
+        LITHOS_CHECK_EQ(tracker.GetLastFrame().frame, 0u);
+    }
+
+    // The rings keep the newest `capacity` frames and samples, oldest first
+    void RingKeepsNewest() {
+        LatencyTracker tracker(8);
+        auto now = Clock::time_point{} + 1h;
+        for (int i = 1; i <= 20; ++i) {
+            now += 16ms;
+            tracker.BeginFrame(now);
+            tracker.InputConsumed(now - std::chrono::milliseconds(i));
+            tracker.MarkDispatched(now);
+            tracker.MarkLaidOut(now);
+            tracker.MarkPainted(now);
+            tracker.MarkPresented(now);
+        }
+
+        std::vector<FrameTiming> frames;
+        tracker.GetFrames(frames);
+        LITHOS_CHECK_EQ(frames.size(), 8u);
+        for (size_t i = 0; i < frames.size(); ++i) LITHOS_CHECK_EQ(frames[i].frame, 13 + i);
+
+        const LatencySummary input = tracker.GetInputLatency();
+        LITHOS_CHECK_EQ(input.samples, 8u);
+        LITHOS_CHECK(input.max == 20ms);
+        LITHOS_CHECK(input.p50 == 16ms);
+    }
+}
+
+int main() {
+    MarksFillFrameTiming();
+    PercentilesOfKnownSamples();
+    RingKeepsNewest();
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Window.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+#include "Lithos/Core/Render/Framebuffer.hpp"
+#include "Lithos/Core/Render/OcclusionCuller.hpp"
+#include "Lithos/Core/Render/SoftwareRenderer.hpp"
+
+#include <chrono>
+#include <memory>
+#include <random>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    struct Box : ElementBase<Box> {
+        Box& at(const float x, const float y) {
+            style.left = x;
+            style.top = y;
+            InvalidateLayout();
+            return *this;
+        }
+    };
+
+    // Culled and unculled frames are bit-identical, on both raster paths and under partial damage
+    void CullingKeepsPixels() {
+        std::mt19937 rng(29);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        auto root = std::make_shared<Box>();
+        root->width(320).height(240).backgroundColor(Colors::White);
+        float flow = 0;     // Where the column layout would put the next panel
+        for (int i = 0; i < 40; ++i) {
+            auto& panel = root->AddChild<Box>();
+            const float h = 30 + unit(rng) * 90;
+            panel.at(unit(rng) * 200, unit(rng) * 150 - flow).width(40 + unit(rng) * 120).height(h)
+                .backgroundColor({unit(rng), unit(rng), unit(rng), rng() % 4 ? 1.0f : 0.5f});
+            if (rng() % 3 == 0) panel.borderRadius(unit(rng) * 12);
+            if (rng() % 3 == 0) panel.borderWidth(1 + unit(rng) * 3).borderColor({0, 0, 0, 1});
+            if (rng() % 4 == 0) panel.boxShadow(2, 3, 4 + unit(rng) * 6, {0, 0, 0, 0.4f});
+            if (rng() % 2 == 0) panel.AddChild<Box>().width(20).height(10).backgroundColor({1, 0, 0, 1});
+            flow += h;
+        }
+        root->UpdateLayout();
+
+        DisplayList list;
+        root->Record(list, Rect(0, 0, 320, 240));
+
+        SoftwareRenderer renderer(2, 32);
+        const Rect damage[] = {Rect(13.5f, 7.25f, 190, 101), Rect(150, 120, 300, 230)};
+        for (const bool partial : {false, true}) {
+            Framebuffer culled(320, 240), plain(320, 240), serial(320, 240);
+            const std::span<const Rect> region = partial ? std::span<const Rect>(damage) : std::span<const Rect>();
+
+            renderer.SetOcclusionCulling(true);
+            renderer.Render(list, culled, region, Colors::White);
+            LITHOS_CHECK(renderer.GetOcclusionStats().commandsCulled > 0);
+            LITHOS_CHECK_EQ(renderer.GetLastFrameStats().commandsCulled, renderer.GetOcclusionStats().commandsCulled);
+            renderer.RenderSerial(list, serial, region, Colors::White);
+
+            renderer.SetOcclusionCulling(false);
+            renderer.Render(list, plain, region, Colors::White);
+            LITHOS_CHECK_EQ(renderer.GetLastFrameStats().commandsCulled, 0u);
+
+            LITHOS_CHECK(culled.pixels == plain.pixels);
+            LITHOS_CHECK(serial.pixels == plain.pixels);
+        }
+    }
+
+    // Each opaque panel hides the ones stacked beneath it; translucent panels hide nothing
+    void StackedPanelsCulled() {
+        Window window(200, 200, "occlusion");
+        Box* panels[4];
+        Element* parent = &window.GetRoot();
+        for (auto& panel : panels) {
+            panel = &parent->AddChild<Box>();
+            panel->width(200).height(200).backgroundColor({0.2f, 0.4f, 0.6f, 1.0f});
+            parent = panel;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        while (window.Tick(now += 20ms)) {}
+        LITHOS_CHECK_EQ(window.GetOcclusionStats().commandsCulled, 3u);
+        LITHOS_CHECK_EQ(window.GetOcclusionStats().elementsCulled, 3u);
+
+        // The top panel turns translucent: the one below shows through and hides the rest
+        panels[3]->backgroundColor({1.0f, 0.0f, 0.0f, 0.5f});
+        while (window.Tick(now += 20ms)) {}
+        LITHOS_CHECK_EQ(window.GetOcclusionStats().commandsCulled, 2u);
+
+        // A panel that no longer covers the one below stops hiding it
+        panels[2]->width(150);
+        while (window.Tick(now += 20ms)) {}
+        LITHOS_CHECK_EQ(window.GetOcclusionStats().commandsCulled, 1u);
+    }
+}
+
+int main() {
+    CullingKeepsPixels();
+    StackedPanelsCulled();
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+#include "Lithos/Core/Window.hpp"
+#include "Lithos/Core/Components/ScrollView.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+#include "Lithos/Core/Render/Framebuffer.hpp"
+#include "Lithos/Core/Render/RenderThread.hpp"
+#include "Lithos/Core/Render/Scene.hpp"
+#include "Lithos/Core/Render/SoftwareRenderer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    struct Box : ElementBase<Box> {
+        Box& at(const float x, const float y) {
+            style.left = x;
+            style.top = y;
+            InvalidateLayout();
+            return *this;
+        }
+    };
+
+    bool SameCommands(const DisplayList& a, const DisplayList& b) {
+        if (a.Size() != b.Size() || a.GroupCount() != b.GroupCount()) return false;
+        for (size_t i = 0; i < a.Size(); ++i) {
+            const auto& x = a.Commands()[i];
+            const auto& y = b.Commands()[i];
+            if (x.type != y.type || !(x.rect == y.rect) || !(x.bounds == y.bounds) || !(x.clip == y.clip)
+                || x.radius != y.radius || x.param != y.param || x.flags != y.flags || x.group != y.group
+                || x.color.r != y.color.r || x.color.g != y.color.g || x.color.b != y.color.b
+                || x.color.a != y.color.a) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Snapshots built incrementally must flatten to exactly what a full record produces
+    void SceneMatchesFullRecord() {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        auto root = std::make_shared<Box>();
+        root->width(1200).height(20000);
+        std::vector<Box*> all;
+        for (int i = 0; i < 200; ++i) {
+            auto& row = root->AddChild<Box>();
+            row.width(1100).height(90).backgroundColor({unit(rng), 0.5f, 0.5f, 1.0f}).margin(2);
+            all.push_back(&row);
+            for (int j = 0; j < 20; ++j) {
+                auto& cell = row.AddChild<Box>();
+                cell.width(10).height(4).backgroundColor({0.2f, unit(rng), 0.3f, 1.0f});
+                all.push_back(&cell);
+            }
+        }
+        auto& scroll = root->AddChild<ScrollView>();
+        scroll.width(300).height(200).backgroundColor(Colors::White);
+        for (int i = 0; i < 100; ++i) {
+            scroll.AddChild<Box>().width(280).height(20).backgroundColor({0.01f * i, 0.2f, 0.3f, 1.0f}).margin(1);
+        }
+
+        const Rect viewport(0, 0, 1200, 20000);
+        FlatTree tree;
+        SceneBuilder builder;
+        DisplayList fromScene, fromTree;
+        std::shared_ptr<const SceneSnapshot> previous;
+        size_t reused = 0;
+
+        for (int round = 0; round < 100; ++round) {
+            for (int k = 0; k < 3; ++k) {
+                Box* e = all[rng() % all.size()];
+                switch (rng() % 3) {
+                    case 0: e->backgroundColor({unit(rng), unit(rng), 0.0f, 1.0f}); break;
+                    case 1: e->height(1.0f + unit(rng) * 3.0f); break;
+                    default: e->visible(rng() % 2 == 0); break;
+                }
+            }
+            if (round % 5 == 0) scroll.ScrollTo(0, unit(rng) * 800.0f);
+            if (round % 25 == 24) all[rng() % 200]->AddChild<Box>().width(5).height(5).backgroundColor({1, 0, 0, 1});
+
+            root->UpdateLayout();
+            tree.Sync(*root);
+            auto scene = builder.Build(tree, viewport);
+            if (previous) LITHOS_CHECK(scene->sequence > previous->sequence);
+            reused += builder.GetStats().chunksReused;
+
+            fromScene.Clear();
+            scene->Flatten(fromScene);
+            fromTree.Clear();
+            tree.Record(fromTree, viewport);
+            LITHOS_CHECK(SameCommands(fromScene, fromTree));
+            previous = scene;
+        }
+        LITHOS_CHECK(reused > 0);
+    }
+
+    // The render thread picks up the newest snapshot and keeps its pixels while the UI stalls
+    void RenderThreadPresentsLatest() {
+        Framebuffer framebuffer(400, 300);
+        SoftwareRenderer renderer(2);
+        DisplayList scratch;
+        RenderThread renderThread([&](const SceneSnapshot& scene, const RenderFrameInfo&) {
+            scratch.Clear();
+            scene.Flatten(scratch);
+            renderer.Render(scratch, framebuffer, {}, Colors::White);
+        });
+        renderThread.Start();
+
+        auto root = std::make_shared<Box>();
+        root->width(400).height(300);
+        auto& box = root->AddChild<Box>();
+        box.width(100).height(100).backgroundColor({1, 0, 0, 1});
+
+        FlatTree tree;
+        SceneBuilder builder;
+        const Rect viewport(0, 0, 400, 300);
+        uint64_t lastSequence = 0;
+        for (int i = 0; i <= 200; ++i) {
+            box.at(static_cast<float>(i % 50), 0);
+            root->UpdateLayout();
+            tree.Sync(*root);
+            auto scene = builder.Build(tree, viewport);
+            lastSequence = scene->sequence;
+            renderThread.Publish(std::move(scene));
+        }
+        LITHOS_CHECK(renderThread.WaitForFrames(1, std::chrono::seconds(5)));
+
+        // Publishing is never blocked by rendering; superseded snapshots are skipped
+        for (int spin = 0; spin < 500 && renderThread.GetStats().lastSequence != lastSequence; ++spin) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // Nothing published, nothing rendered: a stalled UI thread costs the render thread nothing
+        const uint64_t idleFrames = renderThread.GetStats().frames;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        LITHOS_CHECK_EQ(renderThread.GetStats().frames, idleFrames);
+
+        renderThread.Stop();
+        const RenderThreadStats stats = renderThread.GetStats();
+        LITHOS_CHECK_EQ(stats.published, 201u);
+        LITHOS_CHECK(stats.consumed <= stats.published);
+        LITHOS_CHECK_EQ(stats.lastSequence, lastSequence);
+
+        // Last published layout: box at left = 200 % 50 = 0
+        LITHOS_CHECK_EQ(framebuffer.Row(50)[50], 0xFFFF0000u);
+        LITHOS_CHECK_EQ(framebuffer.Row(50)[150], 0xFFFFFFFFu);
+    }
+
+    // A headless window paints the same pixels with and without the render thread
+    void HeadlessWindowMatchesRenderThread() {
+        Window window(320, 240, "headless");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(64).height(32).backgroundColor({0, 0, 1, 1});
+
+        auto now = std::chrono::steady_clock::now();
+        LITHOS_CHECK(window.Tick(now));
+        const std::vector<uint32_t> direct = window.GetFramebuffer().pixels;
+        LITHOS_CHECK_EQ(window.GetFramebuffer().Row(10)[10], 0xFF0000FFu);
+
+        window.SetRenderThread(true);
+        now += std::chrono::seconds(1);
+        LITHOS_CHECK(window.Tick(now));
+        for (int spin = 0; spin < 500 && window.GetRenderThreadStats().frames == 0; ++spin) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        window.SetRenderThread(false);
+        LITHOS_CHECK(window.GetFramebuffer().pixels == direct);
+    }
+}
+
+int main() {
+    SceneMatchesFullRecord();
+    RenderThreadPresentsLatest();
+    HeadlessWindowMatchesRenderThread();
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+#include "Lithos/Core/Render/Framebuffer.hpp"
+#include "Lithos/Core/Render/ResourceCache.hpp"
+#include "Lithos/Core/Render/ShadowCache.hpp"
+#include "Lithos/Core/Render/SoftwareRenderer.hpp"
+
+#include <memory>
+
+using namespace Lithos;
+
+namespace {
+    struct Box : ElementBase<Box> {};
+
+    // Lookups of a held key hit; only misses run the factory
+    void CountsHitsAndMisses() {
+        ResourceCache<int, int> cache(100);
+        int created = 0;
+        const auto make = [&] { return ++created; };
+
+        LITHOS_CHECK_EQ(cache.Acquire(7, make), 1);
+        LITHOS_CHECK_EQ(cache.Acquire(8, make, 5), 2);
+        LITHOS_CHECK_EQ(cache.Acquire(7, make), 1);
+        LITHOS_CHECK_EQ(cache.Acquire(7, make), 1);
+        LITHOS_CHECK_EQ(created, 2);
+
+        ResourceCacheStats stats = cache.GetStats();
+        LITHOS_CHECK_EQ(stats.hits, 2u);
+        LITHOS_CHECK_EQ(stats.misses, 2u);
+        LITHOS_CHECK_EQ(stats.live, 2u);
+        LITHOS_CHECK_EQ(stats.cost, 6u);
+        LITHOS_CHECK_EQ(stats.evictions, 0u);
+
+        // Find never creates and isn't counted
+        LITHOS_CHECK(cache.Find(9) == nullptr);
+        LITHOS_CHECK(cache.Find(8) && *cache.Find(8) == 2);
+        LITHOS_CHECK_EQ(cache.GetStats().hits + cache.GetStats().misses, 4u);
+
+        // Erasing drops the entry and its cost; the next lookup creates it again
+        cache.Erase(8);
+        LITHOS_CHECK_EQ(cache.GetStats().live, 1u);
+        LITHOS_CHECK_EQ(cache.GetStats().cost, 1u);
+        LITHOS_CHECK_EQ(cache.Acquire(8, make), 3);
+
+        cache.ResetCounters();
+        stats = cache.GetStats();
+        LITHOS_CHECK_EQ(stats.hits + stats.misses + stats.evictions, 0u);
+        LITHOS_CHECK_EQ(stats.live, 2u);
+
+        cache.Clear();
+        LITHOS_CHECK_EQ(cache.GetStats().live, 0u);
+        LITHOS_CHECK_EQ(cache.GetStats().cost, 0u);
+    }
+
+    // Over budget, the least recently used entries go first; the entry just acquired stays
+    void EvictsLeastRecentlyUsed() {
+        ResourceCache<int, int> cache(3);
+        const auto value = [](const int key) { return [key] { return key * 10; }; };
+
+        for (int key = 1; key <= 3; ++key) cache.Acquire(key, value(key));
+        cache.Acquire(1, value(1));         // 2 is now the oldest
+        cache.Acquire(4, value(4));
+        LITHOS_CHECK(cache.Find(2) == nullptr);
+        LITHOS_CHECK_EQ(cache.GetStats().evictions, 1u);
+        LITHOS_CHECK_EQ(cache.GetStats().live, 3u);
+
+        LITHOS_CHECK(cache.Find(1) != nullptr);    // Find refreshes too: 3 is the oldest
+        cache.Acquire(5, value(5));
+        LITHOS_CHECK(cache.Find(3) == nullptr);
+        LITHOS_CHECK(cache.Find(1) && cache.Find(4) && cache.Find(5));
+        LITHOS_CHECK_EQ(cache.GetStats().evictions, 2u);
+
+        // One entry over the whole budget is still returned and kept, alone
+        LITHOS_CHECK_EQ(cache.Acquire(6, value(6), 10), 60);
+        LITHOS_CHECK_EQ(cache.GetStats().live, 1u);
+        LITHOS_CHECK_EQ(cache.GetStats().cost, 10u);
+        LITHOS_CHECK_EQ(cache.GetStats().evictions, 5u);
+
+        // Shrinking the budget trims at once
+        cache.SetBudget(100);
+        for (int key = 10; key < 20; ++key) cache.Acquire(key, value(key), 5);
+        cache.SetBudget(20);
+        LITHOS_CHECK_EQ(cache.GetStats().live, 4u);
+        LITHOS_CHECK(cache.Find(19) && cache.Find(16) && !cache.Find(15) && !cache.Find(6));
+    }
+
+    // Elements drawing the same shape share one resource whatever their color; a frame
+    // creates one per distinct shape and later frames only hit
+    void ElementsShareResources() {
+        auto root = std::make_shared<Box>();
+        root->width(400);
+        for (int i = 0; i < 60; ++i) {
+            auto& card = root->AddChild<Box>();
+            card.width(i % 2 ? 120.0f : 90.0f).height(40).margin(4).borderRadius(6)
+                .backgroundColor(Colors::White).boxShadow(0, 2, 8, {0, 0, 0, 0.1f + 0.01f * static_cast<float>(i)});
+        }
+        root->UpdateLayout();
+
+        DisplayList list;
+        root->Record(list, Rect(0, 0, 400, 100000));
+        Framebuffer target(400, 3000);
+        SoftwareRenderer renderer(1);
+        const ShadowCache& shadows = renderer.GetShadowCache();
+
+        renderer.Render(list, target);
+        LITHOS_CHECK_EQ(shadows.GetStats().misses, 1u);     // Both widths exceed the template
+        LITHOS_CHECK_EQ(shadows.GetStats().hits, 59u);
+        LITHOS_CHECK_EQ(shadows.GetStats().live, 1u);
+
+        renderer.Render(list, target);
+        LITHOS_CHECK_EQ(shadows.GetStats().misses, 1u);
+        LITHOS_CHECK_EQ(shadows.GetStats().hits, 119u);
+
+        // A different corner radius is a different shape
+        static_cast<Box*>(root->GetFirstChild())->borderRadius(12);
+        root->UpdateLayout();
+        list.Clear();
+        root->Record(list, Rect(0, 0, 400, 100000));
+        renderer.Render(list, target);
+        LITHOS_CHECK_EQ(shadows.GetStats().misses, 2u);
+        LITHOS_CHECK_EQ(shadows.GetStats().live, 2u);
+    }
+
+    // Masks come back shared while cached and survive eviction for their holders
+    void ShadowMasksShared() {
+        ShadowCache cache(1);       // Budget below any mask: only the latest is kept
+        const auto a = cache.Acquire(20, 20, 4, 6);
+        LITHOS_CHECK(cache.Acquire(20.2f, 19.8f, 4, 6) == a);   // Quantized to the same key
+        LITHOS_CHECK_EQ(cache.GetStats().hits, 1u);
+
+        const auto b = cache.Acquire(30, 30, 4, 6);
+        LITHOS_CHECK(b != a);
+        LITHOS_CHECK_EQ(cache.GetStats().evictions, 1u);
+        LITHOS_CHECK_EQ(a->shapeWidth, 20);                     // Still usable by its holder
+        LITHOS_CHECK(cache.Acquire(20, 20, 4, 6) != a);         // Rebuilt after eviction
+        LITHOS_CHECK_EQ(cache.GetStats().misses, 3u);
+    }
+}
+
+int main() {
+    CountsHitsAndMisses();
+    EvictsLeastRecentlyUsed();
+    ElementsShareResources();
+    ShadowMasksShared();
+    return 0;
+}
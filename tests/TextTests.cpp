@@ -0,0 +1,172 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Components/TextElement.hpp"
+#include "Lithos/Core/Text/TextBuffer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Lithos;
+
+namespace {
+    // Compares every line query against a plain string
+    void CheckAgainst(const TextBuffer& buffer, const std::wstring& model) {
+        LITHOS_CHECK(buffer.ToString() == model);
+
+        std::vector<size_t> starts{0};
+        for (size_t i = 0; i < model.size(); ++i) {
+            if (model[i] == L'\n') starts.push_back(i + 1);
+        }
+        LITHOS_CHECK_EQ(buffer.LineCount(), starts.size());
+        LITHOS_CHECK_EQ(buffer.LineStart(starts.size()), model.size());
+
+        for (size_t line = 0; line < starts.size(); ++line) {
+            const size_t end = line + 1 < starts.size() ? starts[line + 1] - 1 : model.size();
+            LITHOS_CHECK_EQ(buffer.LineStart(line), starts[line]);
+            LITHOS_CHECK_EQ(buffer.LineLength(line), end - starts[line]);
+            LITHOS_CHECK(buffer.GetLine(line) == model.substr(starts[line], end - starts[line]));
+        }
+        for (size_t offset = 0; offset <= model.size(); ++offset) {
+            const auto line = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin()) - 1;
+            LITHOS_CHECK_EQ(buffer.LineOf(offset), line);
+        }
+    }
+
+    // 200k random inserts and erases, mixed with compaction, against std::wstring
+    void BufferMatchesModel() {
+        TextBuffer buffer;
+        std::wstring model;
+        std::mt19937 rng(44);
+        const std::wstring alphabet = L"ab\ncd\r\nxyz";
+
+        for (int step = 0; step < 200000; ++step) {
+            const size_t op = rng() % 100;
+            if (op < 55 || model.size() < 16) {
+                const size_t offset = rng() % (model.size() + 1);
+                std::wstring text(rng() % 8 + 1, L' ');
+                for (auto& c : text) c = alphabet[rng() % alphabet.size()];
+                buffer.Insert(offset, text);
+                model.insert(offset, text);
+            } else if (op < 99) {
+                const size_t offset = rng() % model.size();
+                const size_t count = rng() % (model.size() > 1500 ? 64 : 10) + 1;
+                buffer.Erase(offset, count);
+                model.erase(offset, std::min(count, model.size() - offset));
+            } else {
+                buffer.Compact();
+                LITHOS_CHECK_EQ(buffer.PieceCount(), model.empty() ? 0u : 1u);
+            }
+
+            LITHOS_CHECK_EQ(buffer.Length(), model.size());
+            if (step % 500 == 0) CheckAgainst(buffer, model);
+        }
+        CheckAgainst(buffer, model);
+
+        // Past-the-end inserts are clamped, over-long erases stop at the end
+        buffer.Insert(model.size() + 10, L"\nend");
+        model += L"\nend";
+        buffer.Erase(model.size() - 2, 100);
+        model.resize(model.size() - 2);
+        CheckAgainst(buffer, model);
+    }
+
+    std::shared_ptr<TextElement> Lines(const size_t count) {
+        std::wstring text;
+        for (size_t i = 0; i < count; ++i) text += i + 1 < count ? L"abc\n" : L"abc";
+        auto element = std::make_shared<TextElement>(text);
+        element->UpdateLayout();
+        element->ResetStats();
+        return element;
+    }
+
+    // Widths after a run of edits equal a fresh measurement of the same text
+    void CheckWidths(const TextElement& element) {
+        const TextElement fresh(element.GetText());
+        LITHOS_CHECK_EQ(element.GetLineCount(), fresh.GetLineCount());
+        for (size_t line = 0; line < fresh.GetLineCount(); ++line) {
+            LITHOS_CHECK(element.GetLineWidth(line) == fresh.GetLineWidth(line));
+        }
+        LITHOS_CHECK(element.GetTextWidth() == fresh.GetTextWidth());
+    }
+
+    // An edit measures the lines it produced, not the whole text
+    void EditsMeasureTouchedLines() {
+        const auto text = Lines(1000);
+        const TextBuffer& buffer = text->GetBuffer();
+
+        // Inside one line
+        text->InsertText(buffer.LineStart(500) + 1, L"xy");
+        LITHOS_CHECK_EQ(text->GetStats().linesMeasured, 1u);
+
+        // Splitting a line in three measures the three
+        text->InsertText(buffer.LineStart(200) + 2, L"1\n2\n3");
+        LITHOS_CHECK_EQ(text->GetStats().linesMeasured, 4u);
+        LITHOS_CHECK_EQ(text->GetLineCount(), 1002u);
+
+        // Joining four lines measures the one left
+        text->EraseText(buffer.LineStart(700) + 1, buffer.LineStart(703) - buffer.LineStart(700));
+        LITHOS_CHECK_EQ(text->GetStats().linesMeasured, 5u);
+        LITHOS_CHECK_EQ(text->GetLineCount(), 999u);
+
+        // Appending at the end touches only the last line
+        text->AppendText(L"!");
+        LITHOS_CHECK_EQ(text->GetStats().linesMeasured, 6u);
+        CheckWidths(*text);
+    }
+
+    // Edits that keep the element's size repaint without invalidating layout
+    void SizePreservingEditRepaints() {
+        const auto text = Lines(100);
+        const TextBuffer& buffer = text->GetBuffer();
+        LITHOS_CHECK(!text->NeedsLayout());
+
+        // Replacing a character: the line narrows, then widens back; other lines stay widest
+        const size_t at = buffer.LineStart(40) + 1;
+        text->EraseText(at, 1);
+        text->InsertText(at, L"q");
+        LITHOS_CHECK_EQ(text->GetStats().repaints, 2u);
+        LITHOS_CHECK_EQ(text->GetStats().sizeChanges, 0u);
+        LITHOS_CHECK_EQ(text->GetStats().linesMeasured, 2u);
+        LITHOS_CHECK(!text->NeedsLayout());
+        LITHOS_CHECK(text->GetBuffer().GetLine(40) == L"aqc");
+
+        // A fixed width absorbs a longer line too
+        text->width(300.0f);
+        text->UpdateLayout();
+        text->ResetStats();
+        text->InsertText(buffer.LineStart(10), L"wider");
+        LITHOS_CHECK_EQ(text->GetStats().repaints, 1u);
+        LITHOS_CHECK(!text->NeedsLayout());
+
+        // A new line changes the height
+        text->InsertText(buffer.LineStart(10), L"\n");
+        LITHOS_CHECK_EQ(text->GetStats().sizeChanges, 1u);
+        LITHOS_CHECK(text->NeedsLayout());
+        CheckWidths(*text);
+    }
+}
+
+int main() {
+    BufferMatchesModel();
+    EditsMeasureTouchedLines();
+    SizePreservingEditRepaints();
+    return 0;
+}
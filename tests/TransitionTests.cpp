@@ -0,0 +1,93 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Animation/Transition.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/FlatTree.hpp"
+#include "Lithos/Core/Render/DisplayList.hpp"
+
+#include <chrono>
+#include <memory>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Box : ElementBase<Box> {};
+
+    /// Whether the element's background is recorded as an animated color, walking the tree and the flat copy
+    bool BackgroundAnimated(Element& root, FlatTree& tree) {
+        root.UpdateLayout();
+        tree.Sync(root);
+        DisplayList direct, flat;
+        root.Record(direct, {0, 0, 1000, 1000});
+        tree.Record(flat, {0, 0, 1000, 1000});
+        bool directAnimated = false, flatAnimated = false;
+        for (const DrawCommand& cmd : direct.Commands()) {
+            directAnimated |= (cmd.flags & DrawCommandFlags::AnimatedColor) != 0;
+        }
+        for (const DrawCommand& cmd : flat.Commands()) {
+            flatAnimated |= (cmd.flags & DrawCommandFlags::AnimatedColor) != 0;
+        }
+        LITHOS_CHECK(directAnimated == flatAnimated);
+        return directAnimated;
+    }
+
+    // A color transition stopped mid-way goes back to cached brushes
+    void RemovingTransitionsClearsAnimatedColors() {
+        auto root = std::make_shared<Box>();
+        root->width(200).height(200);
+        auto& box = root->AddChild<Box>();
+        box.width(50).height(50).backgroundColor(Colors::Black);
+        FlatTree tree;
+        LITHOS_CHECK(!BackgroundAnimated(*root, tree));
+
+        TransitionManager manager;
+        const auto start = Clock::now();
+        manager.AddTransition(TransitionConfig(AnimatableProperty::BackgroundColor).SetDuration(10.0f));
+        manager.OnPropertyChange(&box, AnimatableProperty::BackgroundColor, Colors::White);
+        LITHOS_CHECK(manager.Update(&box, start + 1s));
+        LITHOS_CHECK(BackgroundAnimated(*root, tree));
+
+        manager.RemoveTransition(AnimatableProperty::BackgroundColor);
+        LITHOS_CHECK(!manager.HasActiveTransitions());
+        LITHOS_CHECK(!BackgroundAnimated(*root, tree));
+
+        manager.AddTransition(TransitionConfig(AnimatableProperty::BackgroundColor).SetDuration(10.0f));
+        manager.OnPropertyChange(&box, AnimatableProperty::BackgroundColor, Colors::Black);
+        LITHOS_CHECK(manager.Update(&box, Clock::now() + 1s));
+        LITHOS_CHECK(BackgroundAnimated(*root, tree));
+
+        manager.ClearTransitions();
+        LITHOS_CHECK(!BackgroundAnimated(*root, tree));
+
+        // Completing clears it as before
+        manager.AddTransition(TransitionConfig(AnimatableProperty::BackgroundColor).SetDuration(0.1f));
+        manager.OnPropertyChange(&box, AnimatableProperty::BackgroundColor, Colors::White);
+        LITHOS_CHECK(manager.Update(&box, Clock::now() + 50ms));
+        LITHOS_CHECK(BackgroundAnimated(*root, tree));
+        LITHOS_CHECK(!manager.Update(&box, Clock::now() + 1s));
+        LITHOS_CHECK(!BackgroundAnimated(*root, tree));
+    }
+}
+
+int main() {
+    RemovingTransitionsClearsAnimatedColors();
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Threading/UiDispatcher.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    void PostAndDrain() {
+        UiDispatcher dispatcher(4);
+        int ran = 0, wakes = 0;
+        dispatcher.SetWakeHandler([&] { wakes++; });
+        LITHOS_CHECK_EQ(dispatcher.GetCapacity(), 4u);
+
+        for (int i = 0; i < 4; ++i) {
+            LITHOS_CHECK(dispatcher.TryPost([&, i] {
+                LITHOS_CHECK_EQ(ran, i);
+                ran++;
+            }));
+        }
+        // Full: the owning thread never waits for room, it is the one that makes it
+        LITHOS_CHECK(!dispatcher.TryPost([] {}));
+        LITHOS_CHECK(!dispatcher.Post([] {}));
+        LITHOS_CHECK_EQ(wakes, 1);
+        LITHOS_CHECK_EQ(dispatcher.GetDepth(), 4u);
+        LITHOS_CHECK_EQ(dispatcher.Drain(), 4u);
+        LITHOS_CHECK_EQ(ran, 4);
+
+        // Posted while draining: runs in the next drain, after a fresh wake
+        dispatcher.TryPost([&] {
+            dispatcher.TryPost([&] { ran += 10; });
+            ran++;
+        });
+        LITHOS_CHECK_EQ(wakes, 2);
+        LITHOS_CHECK_EQ(dispatcher.Drain(), 1u);
+        LITHOS_CHECK_EQ(ran, 5);
+        LITHOS_CHECK_EQ(wakes, 3);
+        LITHOS_CHECK_EQ(dispatcher.Drain(), 1u);
+        LITHOS_CHECK_EQ(ran, 15);
+
+        const UiDispatcherStats stats = dispatcher.GetStats();
+        LITHOS_CHECK_EQ(stats.posted, 6u);
+        LITHOS_CHECK_EQ(stats.executed, 6u);
+        LITHOS_CHECK_EQ(stats.rejected, 2u);
+        LITHOS_CHECK_EQ(stats.maxDepth, 4u);
+    }
+
+    // Many producers against a UI thread draining once per (short) frame: nothing is lost,
+    // each producer's tasks run in order, the queue never overflows and waits stay bounded
+    void ManyProducers(const size_t capacity) {
+        constexpr int Producers = 8;
+        constexpr int PerProducer = 20000;
+
+        UiDispatcher dispatcher(capacity);
+        std::atomic<int> wakes{0};
+        dispatcher.SetWakeHandler([&] { wakes++; });
+
+        std::vector<int> last(Producers, -1);
+        long long sum = 0;
+        size_t count = 0;
+        bool ordered = true;
+        std::atomic<int> finished{0};
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < Producers; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < PerProducer; ++i) {
+                    const bool accepted = dispatcher.Post([&, p, i] {
+                        if (last[p] != i - 1) ordered = false;
+                        last[p] = i;
+                        sum += i;
+                        count++;
+                    });
+                    LITHOS_CHECK(accepted);     // No timeout: full queues push back, never drop
+                }
+                finished++;
+            });
+        }
+
+        size_t drains = 0;
+        while (finished.load() < Producers || dispatcher.GetDepth() > 0) {
+            dispatcher.Drain();
+            drains++;
+            std::this_thread::sleep_for(500us);
+        }
+        dispatcher.Drain();
+        for (std::thread& producer : producers) producer.join();
+
+        const UiDispatcherStats stats = dispatcher.GetStats();
+        LITHOS_CHECK_EQ(count, static_cast<size_t>(Producers) * PerProducer);
+        LITHOS_CHECK(ordered);
+        LITHOS_CHECK_EQ(sum, static_cast<long long>(Producers) * PerProducer * (PerProducer - 1) / 2);
+        LITHOS_CHECK_EQ(stats.posted, count);
+        LITHOS_CHECK_EQ(stats.executed, count);
+        LITHOS_CHECK_EQ(stats.rejected, 0u);
+        LITHOS_CHECK(stats.maxDepth <= capacity);
+
+        // At most one wake per drain: bursts coalesce into the frame already requested
+        LITHOS_CHECK(static_cast<size_t>(wakes.load()) <= drains + 1);
+
+        // A task waits for at most a few drains; generous for loaded machines, far below
+        // what an unbounded backlog would reach
+        LITHOS_CHECK(stats.maxDelay < 250ms);
+    }
+
+    void PostTimesOut() {
+        UiDispatcher dispatcher(2);
+        dispatcher.TryPost([] {});
+        dispatcher.TryPost([] {});
+
+        bool accepted = true;
+        std::thread rejected([&] { accepted = dispatcher.Post([] {}, 20ms); });
+        rejected.join();
+        LITHOS_CHECK(!accepted);
+        LITHOS_CHECK_EQ(dispatcher.GetStats().rejected, 1u);
+        LITHOS_CHECK_EQ(dispatcher.GetStats().waits, 1u);
+
+        // A drain makes room for a waiting producer
+        std::thread waiting([&] { accepted = dispatcher.Post([] {}, 5s); });
+        std::this_thread::sleep_for(10ms);
+        dispatcher.Drain();
+        waiting.join();
+        LITHOS_CHECK(accepted);
+        LITHOS_CHECK_EQ(dispatcher.GetDepth(), 1u);
+    }
+}
+
+int main() {
+    PostAndDrain();
+    ManyProducers(64);
+    ManyProducers(4096);
+    PostTimesOut();
+    return 0;
+}
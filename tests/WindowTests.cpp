@@ -0,0 +1,368 @@
+/*
+    Copyright 2026 RiriFa
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include "Check.hpp"
+#include "Lithos/Core/Animation/Transition.hpp"
+#include "Lithos/Core/Element.hpp"
+#include "Lithos/Core/Event.hpp"
+#include "Lithos/Core/FrameScheduler.hpp"
+#include "Lithos/Core/InputQueue.hpp"
+#include "Lithos/Core/MemoryReport.hpp"
+#include "Lithos/Core/Style.hpp"
+#include "Lithos/Core/Components/TextElement.hpp"
+#include "Lithos/Core/Render/Framebuffer.hpp"
+#include "Lithos/Core/Threading/UiDispatcher.hpp"
+#include "Lithos/Core/Window.hpp"
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace Lithos;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Box : ElementBase<Box> {
+        const Color& Background() const { return style.backgroundColor; }
+    };
+
+    // Synthetic input wakes an Input frame and keeps (or gets) its arrival time
+    void PostedInputRunsInputFrame() {
+        Window window(200, 100, "input");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(100).height(100);
+        int downs = 0;
+        box.AddEventListener(MouseEventType::MouseDown, [&](MouseEvent&) { downs++; });
+
+        auto now = Clock::now();
+        window.Tick(now);
+        LITHOS_CHECK(!window.Tick(now + 1s));    // Idle until something is posted
+
+        // Replayed input keeps its recorded time; the wait counts towards latency
+        MouseEvent replayed{};
+        replayed.type = MouseEventType::MouseDown;
+        replayed.x = replayed.y = 10;
+        replayed.timestamp = Clock::now() - 500ms;
+        window.PostMouseEvent(replayed);
+        now += 2s;
+        LITHOS_CHECK(window.Tick(now));
+        LITHOS_CHECK_EQ(downs, 1);
+        LITHOS_CHECK(window.GetInputStats().lastMaxDelay >= 500ms);
+
+        // Unset timestamps are stamped on arrival
+        MouseEvent fresh{};
+        fresh.type = MouseEventType::MouseDown;
+        fresh.x = fresh.y = 10;
+        window.PostMouseEvent(fresh);
+        now += 2s;
+        LITHOS_CHECK(window.Tick(now));
+        LITHOS_CHECK_EQ(downs, 2);
+        LITHOS_CHECK(window.GetInputStats().lastMaxDelay < 500ms);
+        LITHOS_CHECK_EQ(window.GetInputStats().received, 2u);
+    }
+
+    // Moves and wheel steps posted between frames coalesce into one event per run; a press
+    // or release ends the run, so the element sees them in the order they were posted
+    void PostedInputCoalesces() {
+        Window window(200, 100, "coalesce");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(200).height(100);
+        std::vector<std::pair<MouseEventType, int>> seen;
+        for (const auto type : {MouseEventType::MouseMove, MouseEventType::MouseDown,
+                                MouseEventType::MouseUp, MouseEventType::MouseWheel}) {
+            box.AddEventListener(type, [&seen](const MouseEvent& evt) {
+                seen.emplace_back(evt.type, evt.type == MouseEventType::MouseWheel ? evt.wheelDelta : evt.x);
+            });
+        }
+
+        auto now = Clock::now();
+        window.Tick(now);
+
+        const auto post = [&](const MouseEventType type, const int x, const int wheel = 0) {
+            MouseEvent evt{};
+            evt.type = type;
+            evt.x = x;
+            evt.y = 10;
+            evt.wheelDelta = wheel;
+            window.PostMouseEvent(evt);
+        };
+        post(MouseEventType::MouseMove, 1);
+        post(MouseEventType::MouseMove, 2);
+        post(MouseEventType::MouseMove, 3);
+        post(MouseEventType::MouseDown, 3);
+        post(MouseEventType::MouseMove, 4);
+        post(MouseEventType::MouseMove, 5);
+        post(MouseEventType::MouseUp, 5);
+        post(MouseEventType::MouseMove, 6);
+        post(MouseEventType::MouseWheel, 6, 120);
+        post(MouseEventType::MouseWheel, 6, 120);
+        post(MouseEventType::MouseWheel, 6, -40);
+        LITHOS_CHECK(window.Tick(now += 20ms));
+
+        const std::vector<std::pair<MouseEventType, int>> expected{
+            {MouseEventType::MouseMove, 3}, {MouseEventType::MouseDown, 3},
+            {MouseEventType::MouseMove, 5}, {MouseEventType::MouseUp, 5},
+            {MouseEventType::MouseMove, 6}, {MouseEventType::MouseWheel, 200}
+        };
+        LITHOS_CHECK(seen == expected);
+
+        const InputQueueStats& stats = window.GetInputStats();
+        LITHOS_CHECK_EQ(stats.received, 11u);
+        LITHOS_CHECK_EQ(stats.dispatched, 6u);
+        LITHOS_CHECK_EQ(stats.frames, 1u);
+    }
+
+    // The queueing delay is the oldest event's wait, measured at the frame that delivers it
+    void QueueReportsDelay() {
+        InputQueue queue;
+        const auto t0 = InputQueue::Clock::now();
+        for (const auto at : {0ms, 4ms, 9ms}) {
+            MouseEvent evt{};
+            evt.type = MouseEventType::MouseMove;
+            evt.x = static_cast<int>(at.count());
+            evt.timestamp = t0 + at;
+            queue.Push(evt);
+        }
+
+        size_t history = 0;
+        int x = -1;
+        LITHOS_CHECK_EQ(queue.Dispatch([&](const MouseEvent& evt, const std::span<const MouseEvent> raw) {
+            x = evt.x;
+            history = raw.size();
+        }, t0 + 16ms), 1u);
+        LITHOS_CHECK_EQ(x, 9);
+        LITHOS_CHECK_EQ(history, 3u);
+        LITHOS_CHECK(queue.GetStats().lastMaxDelay == 16ms);
+        LITHOS_CHECK(queue.GetStats().maxDelay == 16ms);
+
+        // A shorter wait replaces the last delay but not the worst one
+        MouseEvent late{};
+        late.type = MouseEventType::MouseDown;
+        late.timestamp = t0 + 30ms;
+        queue.Push(late);
+        queue.Dispatch([](const MouseEvent&, std::span<const MouseEvent>) {}, t0 + 35ms);
+        LITHOS_CHECK(queue.GetStats().lastMaxDelay == 5ms);
+        LITHOS_CHECK(queue.GetStats().maxDelay == 16ms);
+
+        // Nothing queued: no frame counted, stats untouched
+        LITHOS_CHECK_EQ(queue.Dispatch([](const MouseEvent&, std::span<const MouseEvent>) {}, t0 + 100ms), 0u);
+        LITHOS_CHECK_EQ(queue.GetStats().frames, 2u);
+        LITHOS_CHECK(queue.GetStats().lastMaxDelay == 5ms);
+    }
+
+    // A setter run by a posted task shows up in the frame that ran the task, not the next one
+    void PostedChangePaintsSameFrame() {
+        Window window(200, 100, "posted");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(50).height(50).backgroundColor(Colors::White);
+
+        auto now = Clock::now();
+        window.Tick(now);
+        // A region-only frame leaves the buffers partial, so nothing else forces a full repaint
+        window.RequestRepaint(Rect(150.0f, 50.0f, 160.0f, 60.0f));
+        window.Tick(now += 20ms);
+        LITHOS_CHECK_EQ(window.GetFramebuffer().Row(10)[10], 0xFFFFFFFFu);
+
+        LITHOS_CHECK(window.GetDispatcher().TryPost([&] { box.backgroundColor({1, 0, 0, 1}); }));
+        LITHOS_CHECK(window.Tick(now += 20ms));
+        LITHOS_CHECK_EQ(window.GetFramebuffer().Row(10)[10], 0xFFFF0000u);
+    }
+
+    // A click whose handler restyles an element costs one frame, which shows the change
+    void ClickRepaintsInOneFrame() {
+        Window window(200, 100, "click");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(50).height(50).backgroundColor(Colors::White);
+        box.AddEventListener(MouseEventType::MouseDown, [&](MouseEvent&) { box.backgroundColor({0, 0, 1, 1}); });
+
+        auto now = Clock::now();
+        while (window.Tick(now += 20ms)) {}
+        const uint64_t before = window.GetFrameStats().frames;
+
+        MouseEvent down{};
+        down.type = MouseEventType::MouseDown;
+        down.x = down.y = 10;
+        window.PostMouseEvent(down);
+        int frames = 0;
+        while (window.Tick(now += 20ms)) {
+            if (frames++ == 0) LITHOS_CHECK_EQ(window.GetFramebuffer().Row(10)[10], 0xFF0000FFu);
+            LITHOS_CHECK(frames < 10);
+        }
+        LITHOS_CHECK_EQ(frames, 1);
+        LITHOS_CHECK_EQ(window.GetFrameStats().frames - before, 1u);
+    }
+
+    // The report splits bytes into the right categories, and the running totals agree with it
+    // as elements come and go
+    void MemoryTotalsMatchReport() {
+        Window window(200, 100, "memory");
+        auto now = Clock::now();
+        window.Tick(now);
+
+        size_t perElement = 0;      // Control block bytes the report adds to each object
+        const auto check = [&] {
+            const MemoryReport report = window.GetMemoryReport();
+            const MemoryTotals totals = window.GetMemoryTotals();
+            LITHOS_CHECK_EQ(totals.elements, report.elements);
+            LITHOS_CHECK_EQ(report.Get(MemoryCategory::Styles), report.elements * sizeof(Style));
+
+            const size_t objects = report.Get(MemoryCategory::Elements) + report.Get(MemoryCategory::Styles)
+                                 + report.Get(MemoryCategory::Geometry);
+            if (perElement == 0) perElement = (objects - totals.elementBytes) / report.elements;
+            LITHOS_CHECK_EQ(objects - totals.elementBytes, report.elements * perElement);
+
+            LITHOS_CHECK_EQ(totals.images, report.Get(MemoryCategory::Images));
+            LITHOS_CHECK_EQ(totals.renderCaches, report.Get(MemoryCategory::RenderCaches));
+            LITHOS_CHECK_EQ(totals.frameData, report.Get(MemoryCategory::FrameData));
+            LITHOS_CHECK_EQ(totals.poolReserved - totals.poolInUse, report.Get(MemoryCategory::PoolSlack));
+            return report;
+        };
+
+        MemoryReport report = check();
+        LITHOS_CHECK_EQ(report.elements, 1u);       // The root
+        LITHOS_CHECK(report.Get(MemoryCategory::FrameData) > 0);
+        LITHOS_CHECK_EQ(report.Get(MemoryCategory::Listeners), 0u);
+        LITHOS_CHECK_EQ(report.Get(MemoryCategory::Text), 0u);
+        LITHOS_CHECK(perElement > 0 && perElement <= 64);
+
+        // Children, listeners and text each land in their own category
+        auto& list = window.GetRoot().AddChild<Box>();
+        for (int i = 0; i < 100; ++i) list.AddChild<Box>().width(10).height(10);
+        list.AddEventListener(MouseEventType::MouseDown, [](MouseEvent&) {});
+        auto& text = window.GetRoot().AddChild<TextElement>(L"one\ntwo");
+        window.Tick(now += 20ms);
+        report = check();
+        LITHOS_CHECK_EQ(report.elements, 103u);
+        LITHOS_CHECK(report.Get(MemoryCategory::Children) >= 102 * sizeof(std::shared_ptr<Element>));
+        LITHOS_CHECK(report.Get(MemoryCategory::Listeners) > 0);
+        LITHOS_CHECK(report.Get(MemoryCategory::Layout) >= 102 * sizeof(float));
+        LITHOS_CHECK(report.Get(MemoryCategory::Text) > 0);
+
+        // A subtree built off-window is counted once attached, and only while attached
+        auto detached = Element::Make<Box>(&window.GetElementPool());
+        for (int i = 0; i < 20; ++i) detached->AddChild<Box>();
+        LITHOS_CHECK_EQ(window.GetMemoryTotals().elements, 103u);
+        window.GetRoot().AddChild(detached);
+        LITHOS_CHECK_EQ(check().elements, 124u);
+
+        // Removing subtrees gives their bytes back
+        window.GetRoot().RemoveChild(list);
+        window.GetRoot().RemoveChild(text);
+        window.Tick(now += 20ms);
+        report = check();
+        LITHOS_CHECK_EQ(report.elements, 22u);
+        LITHOS_CHECK_EQ(report.Get(MemoryCategory::Listeners), 0u);
+        LITHOS_CHECK_EQ(report.Get(MemoryCategory::Text), 0u);
+
+        // Moving within the window leaves the counts alone
+        detached->GetFirstChild()->Reparent(window.GetRoot());
+        LITHOS_CHECK_EQ(check().elements, 22u);
+        detached.reset();
+        window.GetRoot().RemoveChild(*window.GetRoot().GetFirstChild());
+        LITHOS_CHECK_EQ(check().elements, 2u);
+    }
+
+    // Transitions on a window's elements advance in its Animate phase without being driven by hand
+    void WindowRunsTransitions() {
+        Window window(200, 100, "transitions");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(50).height(50).backgroundColor(Colors::Black);
+
+        auto now = Clock::now();
+        window.Tick(now);
+
+        TransitionManager manager;
+        manager.AddTransition(TransitionConfig(AnimatableProperty::BackgroundColor)
+                                  .SetDuration(0.1f)
+                                  .SetEasing(Easing::Linear));
+        manager.OnPropertyChange(&box, AnimatableProperty::BackgroundColor, Colors::White);
+        bool finished = false;
+        manager.WhenFinished(AnimatableProperty::BackgroundColor, [&] { finished = true; });
+
+        // Registering booked an animation frame; each frame asks for the next one
+        int frames = 0;
+        while (window.Tick(now += 20ms)) {
+            frames++;
+            if (!finished) {
+                LITHOS_CHECK(box.Background().r > 0.0f);
+                LITHOS_CHECK(manager.HasActiveTransitions() || box.Background().r == 1.0f);
+            }
+            LITHOS_CHECK(frames < 50);
+        }
+        LITHOS_CHECK(finished);
+        LITHOS_CHECK(frames >= 4);
+        LITHOS_CHECK(box.Background().r == 1.0f);
+        LITHOS_CHECK(!manager.HasActiveTransitions());
+        LITHOS_CHECK(!window.Tick(now + 1s));
+    }
+
+    // A manager that goes away mid-transition, or whose element is removed, leaves the window idle
+    void TransitionsOutlivedSafely() {
+        Window window(200, 100, "transitions");
+        auto& box = window.GetRoot().AddChild<Box>();
+        box.width(50).height(50).backgroundColor(Colors::Black);
+        auto now = Clock::now();
+        window.Tick(now);
+
+        {
+            auto manager = std::make_unique<TransitionManager>();
+            manager->AddTransition(TransitionConfig(AnimatableProperty::Opacity).SetDuration(10.0f));
+            manager->OnPropertyChange(&box, AnimatableProperty::Opacity, 0.0f);
+            LITHOS_CHECK(window.Tick(now += 20ms));
+
+            // Moving keeps the registration pointing at the live manager
+            TransitionManager moved(std::move(*manager));
+            manager.reset();
+            LITHOS_CHECK(window.Tick(now += 20ms));
+            LITHOS_CHECK(moved.HasActiveTransitions());
+        }
+        window.Tick(now += 20ms);
+        LITHOS_CHECK(!window.Tick(now += 1s));
+
+        TransitionManager manager;
+        manager.AddTransition(TransitionConfig(AnimatableProperty::Opacity).SetDuration(10.0f));
+        manager.OnPropertyChange(&box, AnimatableProperty::Opacity, 1.0f);
+        bool finished = false;
+        manager.WhenFinished(AnimatableProperty::Opacity, [&] { finished = true; });
+        window.GetRoot().ClearChildren();
+        window.Tick(now += 20ms);
+        LITHOS_CHECK(finished);
+        LITHOS_CHECK(!manager.HasActiveTransitions());
+        LITHOS_CHECK(!window.Tick(now += 1s));
+
+        // Outliving the window is fine too
+        auto other = std::make_unique<Window>(100, 100, "short-lived");
+        auto& child = other->GetRoot().AddChild<Box>();
+        manager.OnPropertyChange(&child, AnimatableProperty::Opacity, 0.5f);
+        other.reset();
+    }
+}
+
+int main() {
+    PostedInputRunsInputFrame();
+    PostedInputCoalesces();
+    QueueReportsDelay();
+    PostedChangePaintsSameFrame();
+    ClickRepaintsInOneFrame();
+    MemoryTotalsMatchReport();
+    WindowRunsTransitions();
+    TransitionsOutlivedSafely();
+    return 0;
+}